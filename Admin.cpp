@@ -5,19 +5,20 @@
 
 #include "Admin.h"
 #include "InputValidation.h"
-#include <iostream>
+#include "TimetableImporter.h"
+#include "OutputBuffer.h"
+#include <ostream>
 #include <algorithm>
-#include <iomanip>
 #include <cctype> 
 
 /**
  * @brief Konstruktor klasy Admin - inicjalizuje administratora
  * @param login Login administratora
- * @param password Hasło administratora  
+ * @param password Skrót hasła administratora  
  * @param id Unikalny identyfikator administratora
  */
 Admin::Admin(std::string login, std::string password, int id)
-	: User(login, password, id) {
+	: User(std::move(login), std::move(password), id) {
 }
 
 /**
@@ -28,14 +29,17 @@ std::string Admin::getType() const { return "ADMIN"; }
 
 /**
  * @brief Wyświetla menu administracyjne z dostępnymi opcjami
+ * @param out Strumień wyjścia sesji
  */
-void Admin::showMenu() {
-	std::cout << "\n=== PANEL ADMINA: " << get_Flogin() << " ===" << std::endl;
-	std::cout << "1. Dodaj nowy pociag" << std::endl;
-	std::cout << "2. Usun pociag" << std::endl;
-	std::cout << "3. Generuj raport systemowy" << std::endl;
-	std::cout << "4. Wroc do menu glownego (Wyloguj)" << std::endl;
-	std::cout << "-----------------------------------" << std::endl;
+void Admin::showMenu(std::ostream& out) {
+	out << "\n=== PANEL ADMINA: " << get_Flogin() << " ===\n";
+	out << "1. Dodaj nowy pociag\n";
+	out << "2. Usun pociag\n";
+	out << "3. Generuj raport systemowy\n";
+	out << "4. Importuj rozklad jazdy (CSV)\n";
+	out << "5. Archiwizuj odjechane pociagi\n";
+	out << "6. Wroc do menu glownego (Wyloguj)\n";
+	out << "-----------------------------------\n";
 }
 
 /**
@@ -57,42 +61,95 @@ std::string formatCity(std::string str) {
  * 
  * Funkcja przeprowadza użytkownika przez proces tworzenia nowego pociągu:
  * - Sprawdza unikalność ID pociągu
- * - Pobiera dane: stację początkową, końcową, datę i liczbę miejsc
+ * - Pobiera dane: stację początkową, końcową, datę oraz układ wagonów
+ *   (lub samą liczbę miejsc dla jednego wagonu drugiej klasy)
  * - Automatycznie formatuje nazwy stacji
- * - Ogranicza liczbę miejsc do maksymalnie 100
+ * - Ogranicza liczbę miejsc do SeatLayout::MAX_CAPACITY
  * 
- * @param trains Wektor pociągów, do którego zostanie dodany nowy pociąg
+ * ID sprawdzane jest ponownie przed dodaniem - w czasie wypełniania kreatora
+ * inny administrator mógł dodać pociąg o tym samym ID.
+ * 
+ * @param io Kanał sesji
+ * @param trains Katalog pociągów, do którego zostanie dodany nowy pociąg
  */
-void Admin::addTrain(std::vector<Train>& trains) {
-	std::cout << "\n--- KREATOR POCIAGU ---\n";
-	int id, capacity;
-	std::string origin, destination, date;
+Task<void> Admin::addTrain(SessionIO& io, TrainCatalog& trains) {
+	std::ostream& out = io.out();
+	out << "\n--- KREATOR POCIAGU ---\n";
+	int id;
 
 	// Zapewnienie unikalności ID pociągu
 	while (true) {
-		readInt("Podaj unikalne ID pociagu: ", id);
-		auto it = std::find_if(trains.begin(), trains.end(),
-			[id](const Train& t) { return t.getID() == id; });
-		if (it == trains.end()) break;
-		std::cout << "Blad: Pociag o ID " << id << " juz istnieje!\n";
+		id = co_await readInt(io, "Podaj unikalne ID pociagu: ");
+		if (trains.find(id) == nullptr) break;
+		out << "Blad: Pociag o ID " << id << " juz istnieje!\n";
 	}
 
 	// Wczytanie i formatowanie nazw stacji
-	readLine("Stacja poczatkowa: ", origin);
-	origin = formatCity(origin); 
+	std::string origin = formatCity(co_await readLine(io, "Stacja poczatkowa: "));
+	std::string destination = formatCity(co_await readLine(io, "Stacja koncowa: "));
+	std::string date = co_await readLine(io, "Data (RRRR-MM-DD): ");
 
-	readLine("Stacja koncowa: ", destination);
-	destination = formatCity(destination); 
-	readLine("Data (RRRR-MM-DD): ", date);
+	// Godziny odjazdu i przyjazdu (przyjazd wcześniejszy niż odjazd - następnego dnia)
+	std::string departureText = co_await readValidatedLine(io, "Godzina odjazdu (GG:MM): ", validateTime);
+	std::string arrivalText = co_await readValidatedLine(io, "Godzina przyjazdu (GG:MM): ", validateTime);
 
-	// Wczytanie i walidacja liczby miejsc
-	readInt("Liczba miejsc (max 100): ", capacity);
-	if (capacity > 100) capacity = 100;
-	if (capacity < 1) capacity = 1;
+	// Wczytanie układu wagonów (klasa:wagonyxrzędyxmiejsca, segmenty po przecinku)
+	SeatLayout layout;
+	while (true) {
+		// nextLine zamiast readLine - readLine pomija pustą linię, a ENTER oznacza układ jednolity
+		out << "Uklad wagonow, np. 2:1x10x3,1:4x20x4 (ENTER = jeden wagon II klasy): ";
+		std::string layoutText = co_await io.nextLine();
+		if (layoutText.empty()) break;
+		if (SeatLayout::parse(layoutText, layout)) break;
+		out << "Blad: Niepoprawny uklad (klasa 1 lub 2, max " << SeatLayout::MAX_SEGMENTS
+			<< " segmenty, max " << SeatLayout::MAX_CAPACITY << " miejsc).\n";
+	}
+
+	// Bez układu - wczytanie i walidacja liczby miejsc
+	if (layout.capacity() == 0) {
+		int capacity = co_await readInt(io, "Liczba miejsc (max " + std::to_string(SeatLayout::MAX_CAPACITY) + "): ");
+		if (capacity > SeatLayout::MAX_CAPACITY) capacity = SeatLayout::MAX_CAPACITY;
+		if (capacity < 1) capacity = 1;
+		layout = SeatLayout::uniform(capacity);
+	}
 
 	// Utworzenie nowego pociągu
-	trains.emplace_back(id, origin, destination, date, capacity);
-	std::cout << "SUKCES: Pociag relacji " << origin << " -> " << destination << " zostal dodany.\n";
+	if (trains.find(id) != nullptr) {
+		out << "Blad: Pociag o ID " << id << " juz istnieje!\n";
+		co_return;
+	}
+	Train* train = trains.add(id, origin, destination, date, layout);
+	uint16_t departure, arrival;
+	if (train != nullptr && Train::parseTime(departureText, departure) && Train::parseTime(arrivalText, arrival)) {
+		trains.setTimes(*train, departure, arrival);
+	}
+	out << "SUKCES: Pociag relacji " << origin << " -> " << destination << " zostal dodany.\n";
+}
+
+/**
+ * @brief Importuje rozkład jazdy z pliku CSV
+ *
+ * Format pliku opisuje TimetableImporter. Odrzucone wiersze i błąd otwarcia
+ * pliku trafiają do sesji administratora. Po imporcie wyświetlane jest
+ * podsumowanie: liczba wierszy, odrzuconych wierszy i utworzonych pociągów.
+ *
+ * @param io Kanał sesji
+ * @param trains Katalog pociągów, do którego trafią zaimportowane kursy
+ */
+Task<void> Admin::importTimetable(SessionIO& io, TrainCatalog& trains) {
+	std::ostream& out = io.out();
+	out << "\n--- IMPORT ROZKLADU JAZDY ---\n";
+	std::string path = co_await readLine(io, "Sciezka do pliku CSV: ");
+
+	TimetableImporter importer(trains, out);
+	ImportReport report;
+	if (!importer.importFile(path, report)) {
+		out << "BLAD: Import nie powiodl sie - nie dodano zadnych pociagow.\n";
+		co_return;
+	}
+
+	out << "SUKCES: Wiersze: " << report.Frows << ", odrzucone: " << report.FrejectedRows
+		<< ", dodane pociagi: " << report.Ftrains << ".\n";
 }
 
 /**
@@ -104,46 +161,54 @@ void Admin::addTrain(std::vector<Train>& trains) {
  * - Usuwa pociąg z systemu
  * - Informuje o liczbie anulowanych biletów
  * 
- * @param trains Wektor pociągów
- * @param tickets Wektor biletów - wszystkie bilety dla usuwanego pociągu zostaną automatycznie anulowane
+ * @param io Kanał sesji
+ * @param trains Katalog pociągów
+ * @param tickets Magazyn biletów - wszystkie bilety dla usuwanego pociągu zostaną automatycznie anulowane
  */
-void Admin::removeTrain(std::vector<Train>& trains, std::vector<Ticket>& tickets) {
-	std::cout << "\n--- USUWANIE POCIAGU ---\n";
+Task<void> Admin::removeTrain(SessionIO& io, TrainCatalog& trains, TicketStore& tickets) {
+	std::ostream& out = io.out();
+	out << "\n--- USUWANIE POCIAGU ---\n";
 	if (trains.empty()) {
-		std::cout << "Baza pociagow jest pusta.\n";
-		return;
+		out << "Baza pociagow jest pusta.\n";
+		co_return;
 	}
 
-	int idToRemove;
-	readInt("Podaj ID pociagu do usuniecia: ", idToRemove);
+	int idToRemove = co_await readInt(io, "Podaj ID pociagu do usuniecia: ");
 
 	// Wyszukanie pociągu
-	auto it = std::find_if(trains.begin(), trains.end(),
-		[idToRemove](const Train& t) { return t.getID() == idToRemove; });
-
-	if (it == trains.end()) {
-		std::cout << "BLAD: Nie znaleziono pociagu o takim ID.\n";
-		return;
+	if (trains.find(idToRemove) == nullptr) {
+		out << "BLAD: Nie znaleziono pociagu o takim ID.\n";
+		co_return;
 	}
 
 	// Usunięcie wszystkich biletów związanych z pociągiem
-	auto initialTicketCount = tickets.size();
-	tickets.erase(
-		std::remove_if(tickets.begin(), tickets.end(),
-			[idToRemove](const Ticket& t) { return t.getTrainId() == idToRemove; }),
-		tickets.end()
-	);
-	int deletedTickets = initialTicketCount - tickets.size();
+	size_t deletedTickets = tickets.removeByTrain(idToRemove);
 
 	// Usunięcie pociągu
-	trains.erase(it);
+	trains.remove(idToRemove);
 
-	std::cout << "SUKCES: Usunieto pociag ID " << idToRemove << ".\n";
+	out << "SUKCES: Usunieto pociag ID " << idToRemove << ".\n";
 	if (deletedTickets > 0) {
-		std::cout << "UWAGA: Anulowano rowniez " << deletedTickets << " biletow.\n";
+		out << "UWAGA: Anulowano rowniez " << deletedTickets << " biletow.\n";
 	}
 }
 
+/**
+ * @brief Przenosi odjechane pociągi wraz z biletami do archiwum
+ *
+ * Archiwizowane są pociągi z datą wcześniejszą niż dzisiejsza.
+ *
+ * @param out Strumień wyjścia sesji
+ * @param trains Katalog pociągów
+ * @param tickets Magazyn biletów
+ * @param archive Archiwum
+ */
+void Admin::archiveDeparted(std::ostream& out, TrainCatalog& trains, TicketStore& tickets, ArchiveManager& archive) {
+	out << "\n--- ARCHIWIZACJA ---\n";
+	ArchiveSummary moved = archive.archiveBefore(trains, tickets, ArchiveManager::todayKey());
+	out << "SUKCES: Przeniesiono do archiwum " << moved.Ftrains << " pociagow i " << moved.Ftickets << " biletow.\n";
+}
+
 /**
  * @brief Generuje i wyświetla szczegółowy raport systemowy
  * 
@@ -152,23 +217,36 @@ void Admin::removeTrain(std::vector<Train>& trains, std::vector<Ticket>& tickets
  * - Liczbę pociągów w systemie
  * - Liczbę sprzedanych biletów
  * - Całkowity przychód ze sprzedaży biletów
+ * - Zajętość miejsc we wszystkich pociągach
+ * 
+ * Dane pochodzą z jednej migawki, więc wszystkie liczby opisują ten sam
+ * stan systemu, nawet gdy w trakcie raportu trwają rezerwacje.
  * 
- * @param trains Wektor wszystkich pociągów w systemie
- * @param tickets Wektor wszystkich biletów
- * @param users Wektor wszystkich użytkowników
+ * @param out Strumień wyjścia sesji
+ * @param snapshot Migawka pociągów i sprzedaży
+ * @param users Katalog wszystkich użytkowników
  */
-void Admin::generateReport(const std::vector<Train>& trains, const std::vector<Ticket>& tickets, const std::vector<std::unique_ptr<User>>& users) {
-	// Obliczenie całkowitego przychodu
-	double totalRevenue = 0.0;
-	for (const auto& t : tickets) {
-		totalRevenue += t.getPrice();
+void Admin::generateReport(std::ostream& out, const CatalogSnapshot& snapshot, const UserDirectory& users, ArchiveManager& archive) {
+	// Zajętość w procentach (sumy stron migawki)
+	double occupancy = snapshot.capacity() > 0 ? 100.0 * static_cast<double>(snapshot.occupiedSeats()) / static_cast<double>(snapshot.capacity()) : 0.0;
+
+	// Wyświetlenie raportu (składany w buforze, wypisywany jednym zapisem)
+	OutputBuffer report;
+	report << "\n================ RAPORT SYSTEMOWY ================\n";
+	report << "Liczba uzytkownikow: " << users.size() << "\n";
+	report << "Liczba pociagow: " << snapshot.trainCount() << "\n";
+	report << "Liczba sprzedanych biletow: " << snapshot.ticketCount() << "\n";
+	report << "Calkowity przychod z biletow: " << OutputBuffer::Fixed{ snapshot.revenue(), 2 } << " PLN\n";
+	report << "Zajetosc miejsc: " << snapshot.occupiedSeats() << " / " << snapshot.capacity() << " (" << OutputBuffer::Fixed{ occupancy, 1 } << "%)\n";
+
+	// Dane archiwalne - miesiące wczytywane leniwie, podsumowania zapamiętywane
+	std::vector<uint32_t> months = archive.months();
+	if (!months.empty()) {
+		ArchiveSummary archived = archive.total();
+		report << "--------------------------------------------------\n";
+		report << "Archiwum (" << months.size() << " mies.): pociagi: " << archived.Ftrains
+			<< ", bilety: " << archived.Ftickets << ", przychod: " << OutputBuffer::Fixed{ archived.Frevenue, 2 } << " PLN\n";
 	}
-	
-	// Wyświetlenie raportu
-	std::cout << "\n================ RAPORT SYSTEMOWY ================\n";
-	std::cout << "Liczba uzytkownikow: " << users.size() << "\n";
-	std::cout << "Liczba pociagow: " << trains.size() << "\n";
-	std::cout << "Liczba sprzedanych biletow: " << tickets.size() << "\n";
-	std::cout << "Calkowity przychod z biletow: " << std::fixed << std::setprecision(2) << totalRevenue << " PLN\n";
-	std::cout << "==================================================\n";
+	report << "==================================================\n";
+	report.writeTo(out);
 }
\ No newline at end of file
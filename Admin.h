@@ -6,17 +6,28 @@
 #pragma once
 #include "User.h"
 #include "Train.h"
+#include "TrainCatalog.h"
 #include "Ticket.h"
+#include "TicketStore.h"
+#include "UserDirectory.h"
+#include "ArchiveManager.h"
+#include "CatalogSnapshot.h"
+#include "SessionIO.h"
+#include "Task.h"
 #include <vector>
 #include <memory>
+#include <ostream>
 #include <string>
 
 /**
  * @class Admin
  * @brief Klasa reprezentująca administratora systemu
  * 
- * Administrator ma uprawnienia do zarządzania pociągami (dodawanie, usuwanie)
+ * Administrator ma uprawnienia do zarządzania pociągami (dodawanie, import rozkładu, usuwanie)
  * oraz generowania raportów systemowych. Dziedziczy po klasie User.
+ * 
+ * Kreatory wczytujące dane są korutynami sesji (co_await na odpowiedź
+ * administratora), więc w tym czasie obsługiwane są sesje innych użytkowników.
  */
 class Admin : public User
 {
@@ -24,15 +35,16 @@ public:
 	/**
 	 * @brief Konstruktor klasy Admin
 	 * @param login Login administratora
-	 * @param password Hasło administratora
+	 * @param password Skrót hasła administratora
 	 * @param id Unikalny identyfikator administratora
 	 */
 	Admin(std::string login, std::string password, int id);
 
 	/**
 	 * @brief Wyświetla menu dostępne dla administratora
+	 * @param out Strumień wyjścia sesji
 	 */
-	void showMenu() override;
+	void showMenu(std::ostream& out) override;
 	
 	/**
 	 * @brief Zwraca typ użytkownika
@@ -42,22 +54,41 @@ public:
 
 	/**
 	 * @brief Dodaje nowy pociąg do systemu
-	 * @param trains Wektor pociągów, do którego zostanie dodany nowy pociąg
+	 * @param io Kanał sesji
+	 * @param trains Katalog pociągów, do którego zostanie dodany nowy pociąg
+	 */
+	Task<void> addTrain(SessionIO& io, TrainCatalog& trains);
+
+	/**
+	 * @brief Importuje rozkład jazdy z pliku CSV (kursy cykliczne rozwijane na pociągi)
+	 * @param io Kanał sesji
+	 * @param trains Katalog pociągów, do którego trafią zaimportowane kursy
 	 */
-	void addTrain(std::vector<Train>& trains);
+	Task<void> importTimetable(SessionIO& io, TrainCatalog& trains);
 
 	/**
 	 * @brief Usuwa pociąg z systemu oraz anuluje wszystkie związane z nim bilety
-	 * @param trains Wektor pociągów
-	 * @param tickets Wektor biletów - wszystkie bilety dla usuwanego pociągu zostaną anulowane
+	 * @param io Kanał sesji
+	 * @param trains Katalog pociągów
+	 * @param tickets Magazyn biletów - wszystkie bilety dla usuwanego pociągu zostaną anulowane
+	 */
+	Task<void> removeTrain(SessionIO& io, TrainCatalog& trains, TicketStore& tickets);
+
+	/**
+	 * @brief Przenosi pociągi, które już odjechały, wraz z biletami do archiwum miesięcznego
+	 * @param out Strumień wyjścia sesji
+	 * @param trains Katalog pociągów
+	 * @param tickets Magazyn biletów
+	 * @param archive Archiwum
 	 */
-	void removeTrain(std::vector<Train>& trains, std::vector<Ticket>& tickets);
+	void archiveDeparted(std::ostream& out, TrainCatalog& trains, TicketStore& tickets, ArchiveManager& archive);
 
 	/**
 	 * @brief Generuje szczegółowy raport systemowy
-	 * @param trains Wektor pociągów w systemie
-	 * @param tickets Wektor wszystkich biletów
-	 * @param users Wektor wszystkich użytkowników systemu
+	 * @param out Strumień wyjścia sesji
+	 * @param snapshot Migawka pociągów i sprzedaży (raport nie blokuje rezerwacji)
+	 * @param users Katalog wszystkich użytkowników systemu
+	 * @param archive Archiwum (podsumowania miesięcy wczytywane przy pierwszym raporcie)
 	 */
-	void generateReport(const std::vector<Train>& trains, const std::vector<Ticket>& tickets, const std::vector<std::unique_ptr<User>>& users);
+	void generateReport(std::ostream& out, const CatalogSnapshot& snapshot, const UserDirectory& users, ArchiveManager& archive);
 };
\ No newline at end of file
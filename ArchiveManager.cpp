@@ -0,0 +1,304 @@
+/**
+ * @file ArchiveManager.cpp
+ * @brief Implementacja klasy ArchiveManager - zwarte pliki miesięczne i leniwe odczyty
+ */
+
+#include "ArchiveManager.h"
+#include "StringPool.h"
+#include "DurableFile.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <unordered_set>
+
+/// Nagłówek pliku archiwum (wersja formatu)
+static const char* const ARCHIVE_MAGIC = "ARC1";
+
+namespace {
+
+/**
+ * @brief Słownik napisów budowany przy zapisie (napis -> indeks w kolejności dodania)
+ */
+struct Dictionary {
+	std::vector<const std::string*> Fvalues;                ///< Napisy w kolejności indeksów
+	std::unordered_map<std::string, uint32_t> Findex;       ///< Napis -> indeks
+
+	/**
+	 * @brief Zwraca indeks napisu, dodając go przy pierwszym użyciu
+	 * @param value Napis
+	 * @return Indeks w słowniku
+	 */
+	uint32_t of(const std::string& value) {
+		auto it = Findex.emplace(value, static_cast<uint32_t>(Fvalues.size())).first;
+		if (it->second == Fvalues.size()) Fvalues.push_back(&it->first);
+		return it->second;
+	}
+};
+
+}
+
+/**
+ * @brief Konstruktor klasy ArchiveManager
+ * @param directory Katalog plików archiwum
+ */
+ArchiveManager::ArchiveManager(std::string directory) : Fdirectory(std::move(directory)) {}
+
+/**
+ * @brief Zwraca dzisiejszą datę
+ * @return Data jako RRRRMMDD
+ */
+uint32_t ArchiveManager::todayKey() {
+	std::chrono::year_month_day today(std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now()));
+	return static_cast<uint32_t>(static_cast<int>(today.year())) * 10000 +
+		static_cast<unsigned>(today.month()) * 100 + static_cast<unsigned>(today.day());
+}
+
+/**
+ * @brief Zwraca ścieżkę pliku miesiąca
+ * @param month Miesiąc (RRRRMM)
+ * @return Ścieżka RRRR-MM.arc w katalogu archiwum
+ */
+std::string ArchiveManager::monthPath(uint32_t month) const {
+	std::string name = std::to_string(month / 100) + "-" + (month % 100 < 10 ? "0" : "") + std::to_string(month % 100) + ".arc";
+	return (std::filesystem::path(Fdirectory) / name).string();
+}
+
+/**
+ * @brief Zapisuje zawartość miesiąca do pliku
+ *
+ * Plik zapisywany jest atomowo (DurableFile), więc przerwany zapis nie niszczy
+ * wcześniejszego archiwum miesiąca.
+ *
+ * @param month Miesiąc (RRRRMM)
+ * @param data Pociągi i bilety
+ * @return true jeśli zapis się powiódł
+ */
+bool ArchiveManager::writeMonth(uint32_t month, const ArchivedMonth& data) const {
+	// Słowniki stacji, układów i loginów - rekordy zapisują tylko indeksy
+	Dictionary stations, layouts, logins;
+	std::ostringstream records;
+	records << std::fixed << std::setprecision(2);
+	for (const ArchivedTrain& t : data.Ftrains) {
+		records << "T " << t.Fid << " " << stations.of(t.Forigin) << " " << stations.of(t.Fdestination) << " "
+			<< t.Fdate % 100 << " " << t.Fdeparture << " " << t.Farrival << " " << layouts.of(t.Flayout) << " "
+			<< t.FoccupiedCount << " " << (t.Foccupied.empty() ? "-" : t.Foccupied) << "\n";
+	}
+	for (const ArchivedTicket& k : data.Ftickets) {
+		records << "K " << k.Fid << " " << k.FtrainId << " " << logins.of(k.Fpassenger) << " " << k.Fseat << " " << k.Fprice << "\n";
+	}
+
+	std::ostringstream file;
+	file << ARCHIVE_MAGIC << "\n";
+	auto writeDictionary = [&file](char tag, const Dictionary& dictionary) {
+		file << tag << " " << dictionary.Fvalues.size() << "\n";
+		for (const std::string* value : dictionary.Fvalues) file << *value << "\n";
+	};
+	writeDictionary('S', stations);
+	writeDictionary('L', layouts);
+	writeDictionary('P', logins);
+	file << records.str();
+
+	std::error_code error;
+	std::filesystem::create_directories(Fdirectory, error);
+	return DurableFile::writeAtomically(monthPath(month), file.str());
+}
+
+/**
+ * @brief Wczytuje archiwum jednego miesiąca
+ * @param month Miesiąc (RRRRMM)
+ * @param data Zmienna, do której zostanie zapisana zawartość
+ * @return false jeśli miesiąc nie jest zarchiwizowany
+ */
+bool ArchiveManager::loadMonth(uint32_t month, ArchivedMonth& data) const {
+	std::ifstream file(monthPath(month));
+	if (!file.is_open()) return false;
+
+	std::string line;
+	if (!std::getline(file, line) || line != ARCHIVE_MAGIC) {
+		std::cerr << "Blad: Niepoprawny plik archiwum " << monthPath(month) << std::endl;
+		return false;
+	}
+
+	data.Ftrains.clear();
+	data.Ftickets.clear();
+	std::vector<std::string> stations, layouts, logins;
+	auto at = [](const std::vector<std::string>& dictionary, size_t index) {
+		return index < dictionary.size() ? dictionary[index] : std::string();
+	};
+
+	while (std::getline(file, line)) {
+		if (line.empty()) continue;
+		std::istringstream fields(line.substr(1));
+		char tag = line[0];
+
+		if (tag == 'S' || tag == 'L' || tag == 'P') {
+			// Słownik: liczba wpisów, potem po jednym wpisie w linii
+			std::vector<std::string>& dictionary = tag == 'S' ? stations : tag == 'L' ? layouts : logins;
+			size_t count = 0;
+			fields >> count;
+			dictionary.resize(count);
+			for (std::string& value : dictionary) std::getline(file, value);
+		}
+		else if (tag == 'T') {
+			ArchivedTrain t;
+			size_t origin, destination, layout;
+			uint32_t day;
+			fields >> t.Fid >> origin >> destination >> day >> t.Fdeparture >> t.Farrival >> layout >> t.FoccupiedCount >> t.Foccupied;
+			if (!fields) continue;
+			if (t.Foccupied == "-") t.Foccupied.clear();
+			t.Forigin = at(stations, origin);
+			t.Fdestination = at(stations, destination);
+			t.Fdate = month * 100 + day;
+			t.Flayout = at(layouts, layout);
+			data.Ftrains.push_back(std::move(t));
+		}
+		else if (tag == 'K') {
+			ArchivedTicket k;
+			size_t login;
+			fields >> k.Fid >> k.FtrainId >> login >> k.Fseat >> k.Fprice;
+			if (!fields) continue;
+			k.Fpassenger = at(logins, login);
+			data.Ftickets.push_back(std::move(k));
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Archiwizuje pociągi, które odjechały przed podaną datą, wraz z ich biletami
+ *
+ * Pociągi grupowane są według miesiąca. Plik miesiąca jest scalany z nowymi
+ * rekordami (ponowna archiwizacja tego samego pociągu zastępuje stary rekord)
+ * i zapisywany w całości; dopiero po udanym zapisie pociągi i bilety są usuwane
+ * z pamięci.
+ *
+ * @param trains Katalog pociągów
+ * @param tickets Magazyn biletów
+ * @param before Data graniczna (RRRRMMDD)
+ * @return Podsumowanie przeniesionych danych
+ */
+ArchiveSummary ArchiveManager::archiveBefore(TrainCatalog& trains, TicketStore& tickets, uint32_t before) {
+	ArchiveSummary moved;
+
+	std::map<uint32_t, std::vector<const Train*>> byMonth;
+	for (const Train* train : trains) {
+		uint32_t date = Train::dateKey(train->getDate());
+		if (date != 0 && date < before) byMonth[date / 100].push_back(train);
+	}
+
+	std::vector<int> archivedIds;
+	for (const auto& [month, monthTrains] : byMonth) {
+		ArchivedMonth data;
+		loadMonth(month, data);
+
+		// Nowe rekordy zastępują wcześniej zarchiwizowane o tym samym ID
+		std::unordered_set<int> trainIds, ticketIds;
+		for (const Train* train : monthTrains) {
+			trainIds.insert(train->getID());
+			tickets.forEachOfTrain(train->getID(), [&tickets, &ticketIds](size_t row) { ticketIds.insert(tickets.ticketId(row)); });
+		}
+		std::erase_if(data.Ftrains, [&trainIds](const ArchivedTrain& t) { return trainIds.count(t.Fid) > 0; });
+		std::erase_if(data.Ftickets, [&ticketIds](const ArchivedTicket& k) { return ticketIds.count(k.Fid) > 0; });
+
+		for (const Train* train : monthTrains) {
+			ArchivedTrain t;
+			t.Fid = train->getID();
+			t.Forigin = train->getOrigin();
+			t.Fdestination = train->getDestination();
+			t.Fdate = Train::dateKey(train->getDate());
+			t.Fdeparture = train->getDeparture();
+			t.Farrival = train->getArrival();
+			t.Flayout = train->getLayout().toString();
+			t.Foccupied = train->encodeSeats();
+			t.FoccupiedCount = train->getOccupiedSeatsCount();
+			data.Ftrains.push_back(std::move(t));
+
+			tickets.forEachOfTrain(train->getID(), [&tickets, &data](size_t row) {
+				data.Ftickets.push_back(ArchivedTicket{ tickets.ticketId(row), tickets.trainId(row),
+					StringPool::logins().get(tickets.passengerId(row)), tickets.seat(row), tickets.price(row) });
+			});
+		}
+
+		if (!writeMonth(month, data)) continue;
+		Fsummaries.erase(month);
+
+		// Zapis udany - zwolnienie pamięci i wpisów w indeksach
+		for (const Train* train : monthTrains) {
+			tickets.forEachOfTrain(train->getID(), [&tickets, &moved](size_t row) {
+				moved.Ftickets++;
+				moved.Frevenue += tickets.price(row);
+			});
+			archivedIds.push_back(train->getID());
+		}
+	}
+
+	for (int id : archivedIds) {
+		tickets.removeByTrain(id);
+		trains.remove(id);
+	}
+	moved.Ftrains = archivedIds.size();
+	if (!archivedIds.empty()) tickets.compact();
+	return moved;
+}
+
+/**
+ * @brief Zwraca miesiące obecne w archiwum
+ * @return Miesiące (RRRRMM) rosnąco
+ */
+std::vector<uint32_t> ArchiveManager::months() const {
+	std::vector<uint32_t> result;
+	std::error_code error;
+	for (const auto& entry : std::filesystem::directory_iterator(Fdirectory, error)) {
+		std::string name = entry.path().filename().string();
+		// Nazwa w postaci RRRR-MM.arc
+		if (name.size() != 11 || name[4] != '-' || name.substr(7) != ".arc") continue;
+		auto digit = [](char c) { return c >= '0' && c <= '9'; };
+		if (!std::all_of(name.begin(), name.begin() + 4, digit) || !std::all_of(name.begin() + 5, name.begin() + 7, digit)) continue;
+		result.push_back(static_cast<uint32_t>(std::stoul(name.substr(0, 4)) * 100 + std::stoul(name.substr(5, 2))));
+	}
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+/**
+ * @brief Zwraca podsumowanie miesiąca
+ *
+ * Plik wczytywany jest tylko przy pierwszym zapytaniu o dany miesiąc;
+ * kolejne zapytania korzystają z zapamiętanego podsumowania.
+ *
+ * @param month Miesiąc (RRRRMM)
+ * @return Podsumowanie
+ */
+const ArchiveSummary& ArchiveManager::summary(uint32_t month) {
+	auto it = Fsummaries.find(month);
+	if (it != Fsummaries.end()) return it->second;
+
+	ArchiveSummary result;
+	ArchivedMonth data;
+	if (loadMonth(month, data)) {
+		result.Ftrains = data.Ftrains.size();
+		result.Ftickets = data.Ftickets.size();
+		for (const ArchivedTicket& k : data.Ftickets) result.Frevenue += k.Fprice;
+	}
+	return Fsummaries.emplace(month, result).first->second;
+}
+
+/**
+ * @brief Zwraca podsumowanie całego archiwum
+ * @return Suma podsumowań wszystkich miesięcy
+ */
+ArchiveSummary ArchiveManager::total() {
+	ArchiveSummary result;
+	for (uint32_t month : months()) {
+		const ArchiveSummary& part = summary(month);
+		result.Ftrains += part.Ftrains;
+		result.Ftickets += part.Ftickets;
+		result.Frevenue += part.Frevenue;
+	}
+	return result;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file ArchiveManager.h
+ * @brief Deklaracja klasy ArchiveManager - archiwizacja odjechanych pociągów i ich biletów
+ */
+
+#pragma once
+#include "TrainCatalog.h"
+#include "TicketStore.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @struct ArchivedTrain
+ * @brief Pociąg odczytany z archiwum
+ */
+struct ArchivedTrain {
+	int Fid = 0;                  ///< ID pociągu
+	std::string Forigin;          ///< Stacja początkowa
+	std::string Fdestination;     ///< Stacja końcowa
+	uint32_t Fdate = 0;           ///< Data kursu (RRRRMMDD)
+	uint16_t Fdeparture = 0;      ///< Odjazd w minutach od północy (Train::NO_TIME - brak)
+	uint16_t Farrival = 0;        ///< Przyjazd w minutach od północy (Train::NO_TIME - brak)
+	std::string Flayout;          ///< Układ wagonów (zapis SeatLayout)
+	std::string Foccupied;        ///< Zajęte miejsca w zapisie Train::encodeSeats (przedziały lub mapa bitowa)
+	int FoccupiedCount = 0;       ///< Liczba zajętych miejsc
+};
+
+/**
+ * @struct ArchivedTicket
+ * @brief Bilet odczytany z archiwum
+ */
+struct ArchivedTicket {
+	int Fid = 0;                  ///< ID biletu
+	int FtrainId = 0;             ///< ID pociągu
+	std::string Fpassenger;       ///< Login pasażera
+	int Fseat = 0;                ///< Numer miejsca
+	double Fprice = 0.0;          ///< Cena
+};
+
+/**
+ * @struct ArchivedMonth
+ * @brief Zawartość archiwum jednego miesiąca
+ */
+struct ArchivedMonth {
+	std::vector<ArchivedTrain> Ftrains;     ///< Pociągi
+	std::vector<ArchivedTicket> Ftickets;   ///< Bilety
+};
+
+/**
+ * @struct ArchiveSummary
+ * @brief Podsumowanie archiwum (miesiąca, całości lub jednej archiwizacji)
+ */
+struct ArchiveSummary {
+	size_t Ftrains = 0;       ///< Liczba pociągów
+	size_t Ftickets = 0;      ///< Liczba biletów
+	double Frevenue = 0.0;    ///< Przychód z biletów
+};
+
+/**
+ * @class ArchiveManager
+ * @brief Przenosi pociągi sprzed wskazanej daty (wraz z biletami) do plików miesięcznych
+ *
+ * Każdy miesiąc ma osobny plik RRRR-MM.arc w katalogu archiwum. Zapis jest zwarty:
+ * nazwy stacji, układy wagonów i loginy trafiają do słowników na początku pliku,
+ * rekordy odwołują się do nich indeksami, a zajęte miejsca zapisywane są tak jak
+ * w trains.yaml - przedziałami lub mapą bitową, zależnie od gęstości (Train::encodeSeats).
+ *
+ * Zarchiwizowane pociągi są usuwane z katalogu (bloki areny wracają na listy wolnych
+ * bloków, wpisy znikają z indeksów ID, tras i odjazdów), a ich bilety z magazynu.
+ * Dzięki temu zbiór roboczy ogranicza się do pociągów, które jeszcze nie odjechały.
+ *
+ * Archiwum pozostaje dostępne dla raportów: miesiąc wczytywany jest dopiero przy
+ * pierwszym zapytaniu, a jego podsumowanie zapamiętywane do kolejnej zmiany pliku.
+ */
+class ArchiveManager
+{
+private:
+	std::string Fdirectory;                                    ///< Katalog plików archiwum
+	std::unordered_map<uint32_t, ArchiveSummary> Fsummaries;   ///< Podsumowania wczytanych miesięcy (klucz RRRRMM)
+
+	/**
+	 * @brief Zwraca ścieżkę pliku miesiąca
+	 * @param month Miesiąc (RRRRMM)
+	 * @return Ścieżka do pliku
+	 */
+	std::string monthPath(uint32_t month) const;
+
+	/**
+	 * @brief Zapisuje zawartość miesiąca do pliku
+	 * @param month Miesiąc (RRRRMM)
+	 * @param data Pociągi i bilety
+	 * @return true jeśli zapis się powiódł
+	 */
+	bool writeMonth(uint32_t month, const ArchivedMonth& data) const;
+
+public:
+	/**
+	 * @brief Konstruktor klasy ArchiveManager
+	 * @param directory Katalog plików archiwum
+	 */
+	explicit ArchiveManager(std::string directory = "archive");
+
+	/**
+	 * @brief Zwraca dzisiejszą datę
+	 * @return Data jako RRRRMMDD (czas systemowy, UTC)
+	 */
+	static uint32_t todayKey();
+
+	/**
+	 * @brief Archiwizuje pociągi, które odjechały przed podaną datą, wraz z ich biletami
+	 *
+	 * Pociągi z niepoprawną datą pozostają w katalogu.
+	 *
+	 * @param trains Katalog pociągów
+	 * @param tickets Magazyn biletów
+	 * @param before Data graniczna (RRRRMMDD) - archiwizowane są pociągi z wcześniejszą datą
+	 * @return Podsumowanie przeniesionych danych
+	 */
+	ArchiveSummary archiveBefore(TrainCatalog& trains, TicketStore& tickets, uint32_t before);
+
+	/**
+	 * @brief Zwraca miesiące obecne w archiwum
+	 * @return Miesiące (RRRRMM) rosnąco
+	 */
+	std::vector<uint32_t> months() const;
+
+	/**
+	 * @brief Wczytuje archiwum jednego miesiąca
+	 * @param month Miesiąc (RRRRMM)
+	 * @param data Zmienna, do której zostanie zapisana zawartość
+	 * @return false jeśli miesiąc nie jest zarchiwizowany
+	 */
+	bool loadMonth(uint32_t month, ArchivedMonth& data) const;
+
+	/**
+	 * @brief Zwraca podsumowanie miesiąca (wczytuje plik przy pierwszym zapytaniu)
+	 * @param month Miesiąc (RRRRMM)
+	 * @return Podsumowanie (puste dla nieznanego miesiąca)
+	 */
+	const ArchiveSummary& summary(uint32_t month);
+
+	/**
+	 * @brief Zwraca podsumowanie całego archiwum
+	 * @return Suma podsumowań wszystkich miesięcy
+	 */
+	ArchiveSummary total();
+};
@@ -0,0 +1,393 @@
+/**
+ * @file BatchProcessor.cpp
+ * @brief Implementacja klasy BatchProcessor - polecenia wsadowe z tokenami sesji
+ */
+
+#include "BatchProcessor.h"
+#include "Passenger.h"
+#include "Admin.h"
+#include "StringPool.h"
+#include <algorithm>
+#include <charconv>
+#include <vector>
+
+/**
+ * @brief Pobiera kolejne słowo z linii (słowa oddzielone spacjami)
+ * @param line Pozostała część linii - zostaje skrócona o pobrane słowo
+ * @return Słowo lub pusty widok, jeśli linia się skończyła
+ */
+static std::string_view nextWord(std::string_view& line) {
+	size_t start = line.find_first_not_of(" \t\r");
+	if (start == std::string_view::npos) {
+		line = {};
+		return {};
+	}
+	line.remove_prefix(start);
+	size_t end = line.find_first_of(" \t\r");
+	std::string_view word = line.substr(0, end);
+	line.remove_prefix(end == std::string_view::npos ? line.size() : end);
+	return word;
+}
+
+/**
+ * @brief Zamienia słowo na liczbę całkowitą
+ * @param word Słowo
+ * @param value Zmienna, do której zostanie zapisana liczba
+ * @return true jeśli całe słowo jest poprawną liczbą
+ */
+static bool parseInt(std::string_view word, int& value) {
+	auto result = std::from_chars(word.data(), word.data() + word.size(), value);
+	return !word.empty() && result.ec == std::errc() && result.ptr == word.data() + word.size();
+}
+
+/**
+ * @brief Dopisuje krótką odpowiedź do bufora
+ * @param out Bufor odpowiedzi
+ * @param text Odpowiedź
+ */
+static void reply(OutputBuffer& out, std::string_view text) {
+	out << text;
+}
+
+/**
+ * @brief Dopisuje odpowiedź na BOOK lub CANCEL
+ * @param operation Wykonana operacja
+ * @param out Bufor odpowiedzi
+ */
+static void formatResult(const QueuedOperation& operation, OutputBuffer& out) {
+	const BookingResult& result = operation.Fresult;
+	if (result.Fstatus == BookingStatus::NOT_DURABLE) return reply(out, "ERR blad zapisu dziennika");
+	if (operation.FcancelTicketId != 0) return reply(out, result.Fstatus == BookingStatus::OK ? "OK" : "ERR bilet nie istnieje");
+
+	if (result.Fstatus == BookingStatus::TRAIN_NOT_FOUND) return reply(out, "ERR pociag nie istnieje");
+	if (result.Fstatus == BookingStatus::CLASS_MISMATCH) return reply(out, "ERR miejsce w innej klasie");
+	if (result.Fstatus == BookingStatus::INVALID_SEAT) return reply(out, "ERR niepoprawne miejsce");
+	if (result.Fstatus != BookingStatus::OK) return reply(out, "ERR miejsce zajete");
+
+	out << "OK " << result.FticketId << " " << result.Fseat << " " << OutputBuffer::Fixed{ result.Fprice, 2 };
+}
+
+/**
+ * @brief Konstruktor klasy BatchProcessor
+ * @param engine Silnik rezerwacji
+ * @param users Katalog użytkowników
+ * @param sessions Menedżer sesji
+ */
+BatchProcessor::BatchProcessor(BookingEngine& engine, UserDirectory& users, SessionManager& sessions)
+	: Fengine(engine), Fusers(users), Fsessions(sessions), Freplica(nullptr) {}
+
+/**
+ * @brief Przełącza procesor w tryb repliki tylko do odczytu
+ * @param replica Replika
+ */
+void BatchProcessor::setReplica(ReplicaClient* replica) { Freplica = replica; }
+
+/**
+ * @brief Rozpoznaje pasażera na podstawie tokenu
+ * @param token Token sesji
+ * @param passengerId Zmienna, do której zostanie zapisany identyfikator loginu
+ * @return true jeśli token należy do zalogowanego pasażera
+ */
+bool BatchProcessor::resolvePassenger(std::string_view token, uint32_t& passengerId) const {
+	auto passenger = dynamic_cast<Passenger*>(Fsessions.resolve(token));
+	if (passenger == nullptr) return false;
+	passengerId = passenger->get_FloginId();
+	return true;
+}
+
+/**
+ * @brief Rozpoznaje polecenie BOOK lub CANCEL, które można dołączyć do partii
+ * @param line Linia z poleceniem
+ * @param operation Zmienna, do której zostanie zapisana operacja
+ * @return true jeśli linia to poprawne BOOK lub CANCEL zalogowanego pasażera
+ */
+bool BatchProcessor::parseOperation(std::string_view line, QueuedOperation& operation) const {
+	std::string_view command = nextWord(line);
+	if (command != "BOOK" && command != "CANCEL") return false;
+	if (!resolvePassenger(nextWord(line), operation.FpassengerId)) return false;
+
+	if (command == "CANCEL") return parseInt(nextWord(line), operation.FcancelTicketId) && operation.FcancelTicketId != 0;
+
+	BookingRequest& request = operation.Frequest;
+	request.FtravelClass = BookingEngine::ANY_CLASS;
+	if (!parseInt(nextWord(line), request.FtrainId) || !parseInt(nextWord(line), request.Fseat)) return false;
+	std::string_view classWord = nextWord(line);
+	return classWord.empty() || parseInt(classWord, request.FtravelClass);
+}
+
+/**
+ * @brief Wykonuje pojedyncze polecenie
+ * @param line Linia z poleceniem
+ * @param out Bufor, do którego zostanie dopisana odpowiedź (bez końcowego znaku nowej linii)
+ */
+void BatchProcessor::execute(std::string_view line, OutputBuffer& out) {
+	std::string_view command = nextWord(line);
+
+	// Replika - dane zmienia tylko wątek replikacji, odczyty pod jego blokadą
+	std::unique_lock<std::mutex> replicaLock;
+	if (Freplica != nullptr) {
+		replicaLock = std::unique_lock<std::mutex>(Freplica->stateMutex());
+		if (command == "BOOK" || command == "CANCEL" || command == "MOVE" || command == "TRANSACT") return reply(out, "ERR replika tylko do odczytu");
+	}
+
+	if (command == "LAG") {
+		if (Freplica == nullptr) return reply(out, "ERR brak replikacji");
+		ReplicationStatus status = Freplica->status();
+		out << "OK " << status.Fapplied << " " << status.FprimarySequence
+			<< " " << OutputBuffer::Fixed{ status.FlagMicros / 1000.0, 3 } << " " << OutputBuffer::Fixed{ status.FmaxLagMicros / 1000.0, 3 };
+		return;
+	}
+
+	if (command == "LOGIN") {
+		std::string_view login = nextWord(line);
+		// Hasło to reszta linii (może zawierać spacje)
+		size_t start = line.find_first_not_of(" \t");
+		std::string_view password = start == std::string_view::npos ? std::string_view() : line.substr(start);
+		if (!password.empty() && password.back() == '\r') password.remove_suffix(1);
+
+		User* user = Fusers.authenticate(login, password);
+		if (user == nullptr) return reply(out, "ERR bledny login lub haslo");
+		return reply(out, "OK " + Fsessions.open(user));
+	}
+
+	std::string_view token = nextWord(line);
+
+	if (command == "LOGOUT") {
+		return reply(out, Fsessions.close(token) ? "OK" : "ERR nieznana sesja");
+	}
+
+	if (command == "REPORT") {
+		if (dynamic_cast<Admin*>(Fsessions.resolve(token)) == nullptr) return reply(out, "ERR nieznana sesja");
+		std::shared_ptr<const CatalogSnapshot> snapshot = Fengine.snapshot();
+		out << "OK " << Fusers.size() << " " << snapshot->trainCount() << " " << snapshot->ticketCount() << " "
+			<< OutputBuffer::Fixed{ snapshot->revenue(), 2 };
+		return;
+	}
+
+	if (command == "TRAINS") {
+		if (Fsessions.resolve(token) == nullptr) return reply(out, "ERR nieznana sesja");
+
+		int offset, limit;
+		if (!parseInt(nextWord(line), offset) || !parseInt(nextWord(line), limit) || offset < 0 || limit < 1) {
+			return reply(out, "ERR niepoprawne argumenty");
+		}
+
+		// Strona listy z jednej migawki - kolejne strony mogą pochodzić z różnych migawek
+		std::shared_ptr<const CatalogSnapshot> snapshot = Fengine.snapshot();
+		size_t begin = std::min(static_cast<size_t>(offset), snapshot->trainCount());
+		size_t end = std::min(begin + std::min(static_cast<size_t>(limit), MAX_PAGE_SIZE), snapshot->trainCount());
+		const StringPool& stations = StringPool::stations();
+		out << "OK " << (end - begin) << " " << snapshot->trainCount();
+		for (size_t i = begin; i < end; i++) {
+			const TrainSummary& t = snapshot->at(i);
+			uint32_t month = t.FdateKey / 100 % 100, day = t.FdateKey % 100;
+			out << '\n' << t.Fid << " " << stations.get(t.ForiginId) << " " << stations.get(t.FdestinationId) << " "
+				<< t.FdateKey / 10000 << '-' << static_cast<char>('0' + month / 10) << static_cast<char>('0' + month % 10)
+				<< '-' << static_cast<char>('0' + day / 10) << static_cast<char>('0' + day % 10)
+				<< " " << Train::formatTime(t.Fdeparture) << " " << t.FfreeSecond << " " << t.FfreeFirst;
+		}
+		return;
+	}
+
+	uint32_t passengerId;
+	if (command == "LIST") {
+		if (!resolvePassenger(token, passengerId)) return reply(out, "ERR nieznana sesja");
+
+		const TicketStore& tickets = Fengine.tickets();
+		size_t count = 0;
+		tickets.forEachOfPassenger(passengerId, [&count](size_t) { count++; });
+		out << "OK " << count;
+		tickets.forEachOfPassenger(passengerId, [&tickets, &out](size_t row) {
+			out << '\n';
+			tickets.at(row).appendTo(out);
+		});
+		return;
+	}
+
+	if (command == "BOOK") {
+		if (!resolvePassenger(token, passengerId)) return reply(out, "ERR nieznana sesja");
+
+		int trainId, seat, travelClass = BookingEngine::ANY_CLASS;
+		if (!parseInt(nextWord(line), trainId) || !parseInt(nextWord(line), seat)) return reply(out, "ERR niepoprawne argumenty");
+		std::string_view classWord = nextWord(line);
+		if (!classWord.empty() && !parseInt(classWord, travelClass)) return reply(out, "ERR niepoprawne argumenty");
+
+		QueuedOperation operation;
+		operation.Fresult = Fengine.book(passengerId, trainId, seat, travelClass);
+		return formatResult(operation, out);
+	}
+
+	if (command == "SEARCH") {
+		if (!resolvePassenger(token, passengerId)) return reply(out, "ERR nieznana sesja");
+
+		std::string_view sortWord = nextWord(line);
+		SearchSort sort;
+		if (sortWord == "DATE") sort = SearchSort::DATE;
+		else if (sortWord == "FREE") sort = SearchSort::FREE_SEATS;
+		else if (sortWord == "PRICE") sort = SearchSort::PRICE;
+		else return reply(out, "ERR niepoprawne argumenty");
+
+		int offset, limit, travelClass = BookingEngine::ANY_CLASS;
+		if (!parseInt(nextWord(line), offset) || !parseInt(nextWord(line), limit) || offset < 0 || limit < 1) {
+			return reply(out, "ERR niepoprawne argumenty");
+		}
+
+		// Opcjonalne filtry - '-' oznacza brak filtra
+		auto filter = [](std::string_view word) { return word == "-" ? std::string_view() : word; };
+		std::string_view origin = filter(nextWord(line));
+		std::string_view destination = filter(nextWord(line));
+		std::string_view date = filter(nextWord(line));
+		std::string_view classWord = nextWord(line);
+		if (!classWord.empty() && !parseInt(classWord, travelClass)) return reply(out, "ERR niepoprawne argumenty");
+
+		SearchPage page = Fengine.searchPage(SearchQuery::make(origin, destination, date, travelClass), sort,
+			static_cast<size_t>(offset), std::min(static_cast<size_t>(limit), MAX_PAGE_SIZE));
+
+		out << "OK " << page.Ftrains.size() << " " << page.Ftotal;
+		for (size_t i = 0; i < page.Ftrains.size(); i++) {
+			const Train* t = page.Ftrains[i];
+			out << '\n' << t->getID() << " " << t->getOrigin() << " " << t->getDestination() << " " << t->getDate()
+				<< " " << Train::formatTime(t->getDeparture()) << " " << (t->getCapacity() - t->getOccupiedSeatsCount()) << " " << OutputBuffer::Fixed{ page.Fprices[i], 2 };
+		}
+		return;
+	}
+
+	if (command == "CANCEL") {
+		if (!resolvePassenger(token, passengerId)) return reply(out, "ERR nieznana sesja");
+
+		int ticketId;
+		if (!parseInt(nextWord(line), ticketId)) return reply(out, "ERR niepoprawne argumenty");
+		QueuedOperation operation;
+		operation.FcancelTicketId = ticketId;
+		operation.Fresult = Fengine.cancel(passengerId, ticketId);
+		return formatResult(operation, out);
+	}
+
+	if (command == "MOVE") {
+		if (!resolvePassenger(token, passengerId)) return reply(out, "ERR nieznana sesja");
+
+		int ticketId, seat;
+		if (!parseInt(nextWord(line), ticketId) || !parseInt(nextWord(line), seat)) return reply(out, "ERR niepoprawne argumenty");
+		BookingResult result = Fengine.changeSeat(passengerId, ticketId, seat);
+		if (result.Fstatus == BookingStatus::TICKET_NOT_FOUND) return reply(out, "ERR bilet nie istnieje");
+		if (result.Fstatus == BookingStatus::NOT_DURABLE) return reply(out, "ERR blad zapisu dziennika");
+		if (result.Fstatus == BookingStatus::TRAIN_NOT_FOUND) return reply(out, "ERR pociag nie istnieje");
+		if (result.Fstatus == BookingStatus::INVALID_SEAT) return reply(out, "ERR niepoprawne miejsce");
+		if (result.Fstatus == BookingStatus::CLASS_MISMATCH) return reply(out, "ERR miejsce w innej klasie");
+		return reply(out, result.Fstatus == BookingStatus::OK ? "OK" : "ERR miejsce zajete");
+	}
+
+	if (command == "TRANSACT") {
+		if (!resolvePassenger(token, passengerId)) return reply(out, "ERR nieznana sesja");
+
+		// Elementy: "-<id biletu>" (anulowanie) lub "<pociąg>:<miejsce>[:klasa]" (rezerwacja)
+		std::vector<int> cancellations;
+		std::vector<BookingRequest> bookings;
+		std::vector<size_t> cancelPositions, bookPositions;   // numery elementów w poleceniu
+		size_t position = 0;
+		for (std::string_view word = nextWord(line); !word.empty(); word = nextWord(line), position++) {
+			if (word.front() == '-') {
+				int ticketId;
+				if (!parseInt(word.substr(1), ticketId)) return reply(out, "ERR " + std::to_string(position) + " niepoprawne argumenty");
+				cancellations.push_back(ticketId);
+				cancelPositions.push_back(position);
+				continue;
+			}
+
+			BookingRequest request;
+			size_t first = word.find(':');
+			size_t second = first == std::string_view::npos ? first : word.find(':', first + 1);
+			bool valid = first != std::string_view::npos && parseInt(word.substr(0, first), request.FtrainId);
+			if (valid && second == std::string_view::npos) valid = parseInt(word.substr(first + 1), request.Fseat);
+			else if (valid) {
+				valid = parseInt(word.substr(first + 1, second - first - 1), request.Fseat) &&
+					parseInt(word.substr(second + 1), request.FtravelClass);
+			}
+			if (!valid) return reply(out, "ERR " + std::to_string(position) + " niepoprawne argumenty");
+			bookings.push_back(request);
+			bookPositions.push_back(position);
+		}
+		if (position == 0) return reply(out, "ERR niepoprawne argumenty");
+
+		TransactionResult result = Fengine.transact(passengerId, cancellations, bookings);
+		if (result.Fstatus == BookingStatus::NOT_DURABLE) return reply(out, "ERR blad zapisu dziennika");
+		if (result.Fstatus == BookingStatus::TICKET_NOT_FOUND) {
+			return reply(out, "ERR " + std::to_string(cancelPositions[result.FfailedIndex]) + " bilet nie istnieje");
+		}
+		if (result.Fstatus != BookingStatus::OK) {
+			std::string failed = "ERR " + std::to_string(bookPositions[result.FfailedIndex]);
+			if (result.Fstatus == BookingStatus::TRAIN_NOT_FOUND) return reply(out, failed + " pociag nie istnieje");
+			if (result.Fstatus == BookingStatus::CLASS_MISMATCH) return reply(out, failed + " miejsce w innej klasie");
+			if (result.Fstatus == BookingStatus::INVALID_SEAT) return reply(out, failed + " niepoprawne miejsce");
+			return reply(out, failed + " miejsce zajete");
+		}
+
+		out << "OK " << result.Fbookings.size();
+		for (const BookingResult& booked : result.Fbookings) {
+			out << '\n' << booked.FticketId << " " << booked.FtrainId << " " << booked.Fseat << " " << OutputBuffer::Fixed{ booked.Fprice, 2 };
+		}
+		return;
+	}
+
+	return reply(out, "ERR nieznane polecenie");
+}
+
+/**
+ * @brief Wykonuje wszystkie polecenia z wejścia
+ *
+ * Linie są widokami na bufor czytnika - polecenie jest rozbierane na słowa
+ * bez kopiowania. Odpowiedzi składane są w jednym buforze i wypisywane
+ * jednym zapisem, gdy bufor przekroczy OUTPUT_CHUNK albo na wejściu nie ma
+ * kolejnych poleceń.
+ *
+ * @param in Czytnik linii z poleceniami
+ * @param out Strumień na odpowiedzi
+ * @return Liczba wykonanych poleceń
+ */
+size_t BatchProcessor::run(LineReader& in, std::ostream& out) {
+	size_t executed = 0;
+	std::vector<QueuedOperation> pending;
+	OutputBuffer responses;
+	auto flush = [this, &responses, &pending]() {
+		if (pending.empty()) return;
+		Fengine.applyGrouped(pending);
+		for (const QueuedOperation& operation : pending) {
+			formatResult(operation, responses);
+			responses << '\n';
+		}
+		pending.clear();
+	};
+
+	std::string_view line;
+	while (in.next(line)) {
+		size_t start = line.find_first_not_of(" \t\r");
+		if (start == std::string_view::npos || line[start] == '#') continue;
+		executed++;
+
+		// BOOK i CANCEL czekają w partii; inne polecenie najpierw wykonuje oczekujące
+		QueuedOperation operation;
+		if (Freplica == nullptr && parseOperation(line, operation)) {
+			pending.push_back(operation);
+			if (pending.size() < BATCH_SIZE && in.ready()) continue;
+			flush();
+		}
+		else {
+			flush();
+			execute(line, responses);
+			responses << '\n';
+		}
+
+		// Brak kolejnych poleceń na wejściu - odpowiedzi wysyłane przed oczekiwaniem
+		if (!in.ready()) {
+			responses.writeTo(out);
+			out.flush();
+		}
+		else if (responses.size() >= OUTPUT_CHUNK) {
+			responses.writeTo(out);
+		}
+	}
+	flush();
+	responses.writeTo(out);
+	out.flush();
+	return executed;
+}
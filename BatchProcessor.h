@@ -0,0 +1,113 @@
+/**
+ * @file BatchProcessor.h
+ * @brief Deklaracja klasy BatchProcessor - nieinteraktywny tryb obsługi żądań
+ */
+
+#pragma once
+#include "BookingEngine.h"
+#include "UserDirectory.h"
+#include "SessionManager.h"
+#include "ReplicaClient.h"
+#include "OutputBuffer.h"
+#include "LineReader.h"
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class BatchProcessor
+ * @brief Wykonuje polecenia tekstowe (po jednym w linii) na silniku rezerwacji
+ *
+ * Obsługiwane polecenia:
+ * - LOGIN <login> <hasło>                    -> OK <token>
+ * - LOGOUT <token>                           -> OK
+ * - LIST <token>                             -> OK <n>, a następnie n linii z biletami
+ * - BOOK <token> <id pociągu> <miejsce> [1|2] -> OK <id biletu> <miejsce> <cena>
+ *   (miejsce 0 - pierwsze wolne miejsce w podanej klasie; numer spoza pociągu: "ERR niepoprawne miejsce")
+ * - CANCEL <token> <id biletu>               -> OK
+ * - MOVE <token> <id biletu> <miejsce>       -> OK (nowe miejsce w tym samym pociągu i tej samej klasie,
+ *   obecne miejsce biletu - bez zmian; numer spoza pociągu: "ERR niepoprawne miejsce", inna klasa: "ERR miejsce w innej klasie")
+ * - TRANSACT <token> <element>...            -> OK <n>, a następnie n linii "<id biletu> <pociąg> <miejsce> <cena>"
+ *   (element "-<id biletu>" anuluje bilet, "<pociąg>:<miejsce>[:klasa]" rezerwuje miejsce;
+ *   wszystkie elementy wykonywane są razem albo żaden - błąd: "ERR <nr elementu> <opis>")
+ * - REPORT <token administratora>           -> OK <użytkownicy> <pociągi> <bilety> <przychód>
+ *   (z migawki BookingEngine::snapshot - nie blokuje rezerwacji)
+ * - TRAINS <token> <offset> <limit>          -> OK <n> <wszystkie>, a następnie n linii
+ *   "<id> <skąd> <dokąd> <data> <odjazd> <wolne 2 kl.> <wolne 1 kl.>" (wszystkie pociągi, z jednej migawki)
+ * - LAG                                      -> OK <zastosowana operacja> <operacja głównego> <opóźnienie ms> <maks. ms>
+ *   (tylko replika)
+ * - SEARCH <token> <DATE|FREE|PRICE> <offset> <limit> [skąd] [dokąd] [data] [1|2]
+ *                                            -> OK <n> <wszystkie>, a następnie n linii
+ *   "<id> <skąd> <dokąd> <data> <odjazd> <wolne> <cena>" (pominięty filtr: '-', limit do MAX_PAGE_SIZE)
+ *
+ * Kolejne polecenia BOOK i CANCEL, które są już dostępne na wejściu (do BATCH_SIZE),
+ * wykonywane są jedną partią pogrupowaną według pociągów (BookingEngine::applyGrouped),
+ * a odpowiedzi wypisywane w kolejności poleceń. Każde inne polecenie zamyka partię.
+ *
+ * W replice (setReplica) polecenia zmieniające bilety są odrzucane, a każde
+ * polecenie wykonywane jest pod blokadą danych repliki.
+ *
+ * Hasło weryfikowane jest tylko przy LOGIN; kolejne żądania przedstawiają token sesji.
+ * Puste linie i linie zaczynające się od '#' są pomijane. Błędy zwracane są jako "ERR <opis>".
+ */
+class BatchProcessor
+{
+public:
+	static constexpr size_t MAX_PAGE_SIZE = 100;   ///< Maksymalna liczba wyników SEARCH
+	static constexpr size_t BATCH_SIZE = 256;      ///< Maksymalna liczba operacji w jednej partii
+	static constexpr size_t OUTPUT_CHUNK = 64 * 1024;   ///< Rozmiar porcji odpowiedzi wypisywanej jednym zapisem
+
+private:
+	BookingEngine& Fengine;       ///< Silnik rezerwacji
+	UserDirectory& Fusers;        ///< Katalog użytkowników
+	SessionManager& Fsessions;    ///< Aktywne sesje
+	ReplicaClient* Freplica;      ///< Replikacja (nullptr - proces główny)
+
+	/**
+	 * @brief Rozpoznaje pasażera na podstawie tokenu
+	 * @param token Token sesji
+	 * @param passengerId Zmienna, do której zostanie zapisany identyfikator loginu
+	 * @return true jeśli token należy do zalogowanego pasażera
+	 */
+	bool resolvePassenger(std::string_view token, uint32_t& passengerId) const;
+
+	/**
+	 * @brief Rozpoznaje polecenie BOOK lub CANCEL, które można dołączyć do partii
+	 * @param line Linia z poleceniem
+	 * @param operation Zmienna, do której zostanie zapisana operacja
+	 * @return true jeśli linia to poprawne BOOK lub CANCEL zalogowanego pasażera
+	 */
+	bool parseOperation(std::string_view line, QueuedOperation& operation) const;
+
+public:
+	/**
+	 * @brief Konstruktor klasy BatchProcessor
+	 * @param engine Silnik rezerwacji
+	 * @param users Katalog użytkowników
+	 * @param sessions Menedżer sesji
+	 */
+	BatchProcessor(BookingEngine& engine, UserDirectory& users, SessionManager& sessions);
+
+	/**
+	 * @brief Przełącza procesor w tryb repliki tylko do odczytu
+	 * @param replica Replika, której dane są odczytywane
+	 */
+	void setReplica(ReplicaClient* replica);
+
+	/**
+	 * @brief Wykonuje pojedyncze polecenie
+	 * @param line Linia z poleceniem
+	 * @param out Bufor, do którego zostanie dopisana odpowiedź (bez końcowego znaku nowej linii)
+	 */
+	void execute(std::string_view line, OutputBuffer& out);
+
+	/**
+	 * @brief Wykonuje wszystkie polecenia z wejścia
+	 * @param in Czytnik linii z poleceniami
+	 * @param out Strumień na odpowiedzi
+	 * @return Liczba wykonanych poleceń
+	 */
+	size_t run(LineReader& in, std::ostream& out);
+};
@@ -0,0 +1,681 @@
+/**
+ * @file BookingEngine.cpp
+ * @brief Implementacja klasy BookingEngine - rezerwacja i anulowanie biletów
+ */
+
+#include "BookingEngine.h"
+#include "StringPool.h"
+#include <algorithm>
+#include <numeric>
+#include <unordered_set>
+
+/**
+ * @brief Konstruktor klasy BookingEngine
+ * @param trains Katalog pociągów
+ * @param tickets Magazyn biletów
+ * @param ticketIds Generator ID biletów
+ * @param pricing Cennik
+ */
+BookingEngine::BookingEngine(TrainCatalog& trains, TicketStore& tickets, IdAllocator& ticketIds, const PricingEngine& pricing)
+	: Ftrains(trains), Ftickets(tickets), FticketIds(ticketIds), Fpricing(pricing), Fjournal(nullptr), Fshards(nullptr) {}
+
+/**
+ * @brief Podłącza dziennik operacji
+ * @param journal Dziennik (nullptr - bez dziennika)
+ */
+void BookingEngine::setJournal(Journal* journal) { Fjournal = journal; }
+
+/**
+ * @brief Podłącza pulę partycji
+ * @param shards Pula (nullptr - partie wykonywane w wątku wywołującym)
+ */
+void BookingEngine::setShards(ShardPool* shards) { Fshards = shards; }
+
+/**
+ * @brief Tworzy wpis dziennika dla wyniku operacji
+ * @param operation Rodzaj operacji
+ * @param result Wynik operacji
+ * @param passengerId Identyfikator loginu pasażera
+ * @param newSeat Nowe miejsce (tylko zmiana miejsca)
+ * @return Wpis dziennika (bez numeru sekwencyjnego)
+ */
+Journal::Record BookingEngine::journalEntry(Journal::Operation operation, const BookingResult& result, uint32_t passengerId, int newSeat) {
+	Journal::Record entry;
+	entry.Foperation = operation;
+	entry.FticketId = result.FticketId;
+	entry.FtrainId = result.FtrainId;
+	entry.Fseat = result.Fseat;
+	entry.FnewSeat = newSeat;
+	entry.Fprice = result.Fprice;
+	entry.Fpassenger = StringPool::logins().get(passengerId);
+	return entry;
+}
+
+// Dostęp do danych silnika
+TrainCatalog& BookingEngine::trains() { return Ftrains; }
+const TrainCatalog& BookingEngine::trains() const { return Ftrains; }
+TicketStore& BookingEngine::tickets() { return Ftickets; }
+const TicketStore& BookingEngine::tickets() const { return Ftickets; }
+const SearchCache& BookingEngine::searchCache() const { return Fsearch; }
+
+/**
+ * @brief Wyszukuje pociągi pasujące do zapytania
+ * @param query Znormalizowane zapytanie
+ * @return Pasujące pociągi
+ */
+const std::vector<const Train*>& BookingEngine::search(const SearchQuery& query) {
+	return Fsearch.search(Ftrains, query, Fshards);
+}
+
+/**
+ * @brief Zwraca stronę posortowanych wyników wyszukiwania
+ * @param query Znormalizowane zapytanie
+ * @param sort Kolejność wyników
+ * @param offset Liczba pominiętych wyników
+ * @param pageSize Maksymalna liczba wyników na stronie
+ * @return Strona wyników z cenami
+ */
+SearchPage BookingEngine::searchPage(const SearchQuery& query, SearchSort sort, size_t offset, size_t pageSize) {
+	const std::vector<const Train*>& matches = search(query);
+	SearchPage page;
+	page.Ftotal = matches.size();
+	if (offset >= matches.size() || pageSize == 0) return page;
+
+	size_t k = offset + std::min(pageSize, matches.size() - offset);
+	int priceClass = query.FtravelClass != ANY_CLASS ? query.FtravelClass : SECOND_CLASS;
+
+	// Klucze sortowania wyliczane raz na wynik (nie w każdym porównaniu)
+	std::vector<double> prices;
+	std::vector<int> freeSeats;
+	if (sort == SearchSort::PRICE) {
+		prices.resize(matches.size());
+		quoteBatch(matches, priceClass, prices);
+	}
+	else if (sort == SearchSort::FREE_SEATS) {
+		freeSeats.resize(matches.size());
+		for (size_t i = 0; i < matches.size(); i++) {
+			freeSeats[i] = matches[i]->getCapacity() - matches[i]->getOccupiedSeatsCount();
+		}
+	}
+
+	auto before = [&matches, &prices, &freeSeats, sort](uint32_t a, uint32_t b) {
+		if (sort == SearchSort::PRICE && prices[a] != prices[b]) return prices[a] < prices[b];
+		if (sort == SearchSort::FREE_SEATS && freeSeats[a] != freeSeats[b]) return freeSeats[a] > freeSeats[b];
+		if (sort == SearchSort::DATE && matches[a]->getDate() != matches[b]->getDate()) {
+			return matches[a]->getDate() < matches[b]->getDate();
+		}
+		if (sort == SearchSort::DATE && matches[a]->getDeparture() != matches[b]->getDeparture()) {
+			return matches[a]->getDeparture() < matches[b]->getDeparture();
+		}
+		return matches[a]->getID() < matches[b]->getID();
+	};
+
+	// Częściowe sortowanie indeksów - uporządkowane jest tylko k pierwszych pozycji
+	std::vector<uint32_t> order(matches.size());
+	std::iota(order.begin(), order.end(), 0u);
+	std::partial_sort(order.begin(), order.begin() + k, order.end(), before);
+
+	page.Ftrains.reserve(k - offset);
+	for (size_t i = offset; i < k; i++) page.Ftrains.push_back(matches[order[i]]);
+
+	page.Fprices.resize(page.Ftrains.size());
+	if (sort == SearchSort::PRICE) {
+		for (size_t i = offset; i < k; i++) page.Fprices[i - offset] = prices[order[i]];
+	}
+	else {
+		quoteBatch(page.Ftrains, priceClass, page.Fprices);
+	}
+	return page;
+}
+
+/**
+ * @brief Wylicza cenę biletu według cennika
+ * @param train Pociąg
+ * @param travelClass Klasa podróży
+ * @return Cena w PLN
+ */
+double BookingEngine::quote(const Train& train, int travelClass) const {
+	return Fpricing.quote(train, travelClass);
+}
+
+/**
+ * @brief Wylicza ceny dla strony wyników wyszukiwania
+ * @param trains Pociągi na stronie wyników
+ * @param travelClass Klasa podróży
+ * @param prices Tablica na ceny
+ */
+void BookingEngine::quoteBatch(std::span<const Train* const> trains, int travelClass, std::span<double> prices) const {
+	Fpricing.quoteBatch(trains, travelClass, prices);
+}
+
+/**
+ * @brief Zakłada blokady pociągów w ustalonej kolejności
+ *
+ * Blokady to paski (ID pociągu modulo LOCK_STRIPES) zakładane rosnąco
+ * według numeru paska, więc dwie transakcje na tych samych pociągach
+ * nigdy nie czekają na siebie nawzajem.
+ *
+ * @param trainIds ID pociągów (mogą się powtarzać)
+ * @return Założone blokady (zwalniane przy zniszczeniu)
+ */
+std::vector<std::unique_lock<std::mutex>> BookingEngine::lockTrains(std::span<const int> trainIds) {
+	std::vector<size_t> stripes;
+	stripes.reserve(trainIds.size());
+	for (int trainId : trainIds) stripes.push_back(static_cast<uint32_t>(trainId) % LOCK_STRIPES);
+	std::sort(stripes.begin(), stripes.end());
+	stripes.erase(std::unique(stripes.begin(), stripes.end()), stripes.end());
+
+	std::vector<std::unique_lock<std::mutex>> locks;
+	locks.reserve(stripes.size());
+	for (size_t stripe : stripes) locks.emplace_back(FtrainLocks[stripe]);
+	return locks;
+}
+
+/**
+ * @brief Rezerwuje miejsce w zablokowanym pociągu (bez wystawienia biletu)
+ * @param train Pociąg
+ * @param request Żądana rezerwacja
+ * @return Wynik (przy powodzeniu - miejsce, klasa i cena)
+ */
+BookingResult BookingEngine::reserve(Train& train, const BookingRequest& request) {
+	BookingResult result;
+	result.FtrainId = request.FtrainId;
+
+	if (request.Fseat != 0 && (request.Fseat < 1 || request.Fseat > train.getCapacity())) {
+		result.Fseat = request.Fseat;
+		result.Fstatus = BookingStatus::INVALID_SEAT;
+		return result;
+	}
+
+	// Dowolne wolne miejsce w klasie - jedno przejście po przedziale mapy bitowej
+	result.Fseat = request.Fseat != 0 ? request.Fseat : train.findFreeSeat(request.FtravelClass);
+	int seatClass = train.getSeatClass(result.Fseat);
+	if (seatClass != 0 && request.FtravelClass != ANY_CLASS && seatClass != request.FtravelClass) {
+		result.Fstatus = BookingStatus::CLASS_MISMATCH;
+		return result;
+	}
+	if (!train.reserveSeat(result.Fseat)) {
+		result.Fstatus = BookingStatus::SEAT_TAKEN;
+		return result;
+	}
+	result.FtravelClass = seatClass;
+	result.Fprice = quote(train, seatClass);
+	return result;
+}
+
+/**
+ * @brief Rezerwuje miejsce i wystawia bilet
+ *
+ * Miejsce rezerwowane jest przed wydaniem ID, więc nieudana rezerwacja
+ * nie zużywa numeru biletu. Cena liczona jest według klasy miejsca.
+ *
+ * @param passengerId Identyfikator loginu pasażera
+ * @param trainId ID pociągu
+ * @param seat Numer miejsca (0 - pierwsze wolne w klasie)
+ * @param travelClass Klasa podróży (ANY_CLASS - klasa wybranego miejsca)
+ * @return Wynik rezerwacji
+ */
+BookingResult BookingEngine::book(uint32_t passengerId, int trainId, int seat, int travelClass) {
+	BookingRequest request{ trainId, seat, travelClass };
+	TransactionResult transaction = transact(passengerId, {}, std::span<const BookingRequest>(&request, 1));
+	if (transaction.Fstatus == BookingStatus::OK) return transaction.Fbookings.front();
+
+	BookingResult result;
+	result.Fstatus = transaction.Fstatus;
+	result.FtrainId = trainId;
+	result.Fseat = transaction.Fbookings.empty() ? seat : transaction.Fbookings.front().Fseat;
+	return result;
+}
+
+/**
+ * @brief Anuluje bilet pasażera
+ *
+ * Bilet usuwany jest nawet wtedy, gdy jego pociąg już nie istnieje.
+ *
+ * @param passengerId Identyfikator loginu właściciela
+ * @param ticketId ID biletu
+ * @return Wynik anulowania
+ */
+BookingResult BookingEngine::cancel(uint32_t passengerId, int ticketId) {
+	TransactionResult transaction = transact(passengerId, std::span<const int>(&ticketId, 1), {});
+	if (transaction.Fstatus == BookingStatus::OK) return transaction.Fcancellations.front();
+
+	BookingResult result;
+	result.Fstatus = transaction.Fstatus;
+	result.FticketId = ticketId;
+	return result;
+}
+
+/**
+ * @brief Wykonuje transakcję: anulowania i rezerwacje na wielu pociągach
+ *
+ * Przebieg:
+ * 1. Odczyt pociągów anulowanych biletów, blokady wszystkich pociągów transakcji
+ *    (rosnąco według paska - bez blokady globalnej i bez zakleszczeń).
+ * 2. Zwolnienie miejsc anulowanych biletów, potem kolejne rezerwacje; miejsce 0
+ *    to pierwsze wolne w klasie (kolejne żądania widzą już zajęte miejsca).
+ * 3. Przy pierwszym niepowodzeniu wszystkie zmiany w mapach miejsc są cofane.
+ * 4. Po powodzeniu - jedna krótka sekcja magazynu biletów i jeden wpis
+ *    grupy w dzienniku (po awarii odtwarzana jest cała transakcja albo nic).
+ *
+ * @param passengerId Identyfikator loginu pasażera
+ * @param cancellations ID biletów pasażera do anulowania
+ * @param bookings Żądane rezerwacje
+ * @return Wynik transakcji
+ */
+TransactionResult BookingEngine::transact(uint32_t passengerId, std::span<const int> cancellations, std::span<const BookingRequest> bookings) {
+	TransactionResult result;
+	auto fail = [&result](BookingStatus status, size_t index) {
+		result.Fstatus = status;
+		result.FfailedIndex = index;
+		return result;
+	};
+
+	// Pociągi transakcji - dla anulowań odczytywane z magazynu biletów; ten sam bilet anulowany jest tylko raz
+	std::vector<int> trainIds;
+	trainIds.reserve(cancellations.size() + bookings.size());
+	{
+		std::lock_guard<std::mutex> store(FstoreMutex);
+		std::unordered_set<int> cancelled;
+		for (size_t i = 0; i < cancellations.size(); i++) {
+			size_t row = Ftickets.findRow(cancellations[i], passengerId);
+			if (row == TicketStore::NPOS || !cancelled.insert(cancellations[i]).second) return fail(BookingStatus::TICKET_NOT_FOUND, i);
+			trainIds.push_back(Ftickets.trainId(row));
+		}
+	}
+	for (const BookingRequest& request : bookings) trainIds.push_back(request.FtrainId);
+	auto locks = lockTrains(trainIds);
+
+	// Bilety mogły zmienić się przed założeniem blokad - ponowny odczyt
+	{
+		std::lock_guard<std::mutex> store(FstoreMutex);
+		for (size_t i = 0; i < cancellations.size(); i++) {
+			size_t row = Ftickets.findRow(cancellations[i], passengerId);
+			if (row == TicketStore::NPOS || Ftickets.trainId(row) != trainIds[i]) return fail(BookingStatus::TICKET_NOT_FOUND, i);
+
+			BookingResult cancelled;
+			cancelled.FticketId = cancellations[i];
+			cancelled.FtrainId = trainIds[i];
+			cancelled.Fseat = Ftickets.seat(row);
+			cancelled.Fprice = Ftickets.price(row);
+			result.Fcancellations.push_back(cancelled);
+		}
+	}
+
+	// Zmiany w mapach miejsc (pod blokadami pociągów) - z możliwością cofnięcia
+	std::vector<std::pair<Train*, uint32_t>> touched;   // pociąg i jego wersja przed transakcją
+	auto touch = [&touched](Train* train) {
+		for (const auto& entry : touched) if (entry.first == train) return;
+		touched.emplace_back(train, train->getVersion());
+	};
+	auto rollback = [&]() {
+		for (const BookingResult& booked : result.Fbookings) Ftrains.find(booked.FtrainId)->cancelSeat(booked.Fseat);
+		for (const BookingResult& cancelled : result.Fcancellations) {
+			Train* train = Ftrains.find(cancelled.FtrainId);
+			if (train != nullptr) train->reserveSeat(cancelled.Fseat);
+		}
+	};
+
+	for (BookingResult& cancelled : result.Fcancellations) {
+		Train* train = Ftrains.find(cancelled.FtrainId);
+		if (train == nullptr) continue;
+		touch(train);
+		cancelled.FtravelClass = train->getSeatClass(cancelled.Fseat);
+		train->cancelSeat(cancelled.Fseat);
+	}
+
+	for (size_t i = 0; i < bookings.size(); i++) {
+		const BookingRequest& request = bookings[i];
+		Train* train = Ftrains.find(request.FtrainId);
+		if (train == nullptr) {
+			rollback();
+			return fail(BookingStatus::TRAIN_NOT_FOUND, i);
+		}
+
+		touch(train);
+		BookingResult booked = reserve(*train, request);
+		if (booked.Fstatus != BookingStatus::OK) {
+			rollback();
+			result.Fbookings.clear();
+			result.Fbookings.push_back(booked);
+			return fail(booked.Fstatus, i);
+		}
+		result.Fbookings.push_back(booked);
+	}
+
+	// Zatwierdzenie - magazyn biletów, wersje tras i dziennik
+	{
+		std::lock_guard<std::mutex> store(FstoreMutex);
+		for (const BookingResult& cancelled : result.Fcancellations) {
+			Ftickets.remove(Ftickets.findRow(cancelled.FticketId, passengerId));
+			Ftrains.markChanged(cancelled.FtrainId);
+		}
+		for (BookingResult& booked : result.Fbookings) {
+			// ID zajęte (np. generator odtworzony za nisko) - kolejne ID
+			do booked.FticketId = FticketIds.next();
+			while (!Ftickets.add(booked.FticketId, booked.FtrainId, passengerId, booked.Fseat, booked.Fprice));
+			Ftrains.markChanged(booked.FtrainId);
+		}
+		// Klasa wyprzedana lub odzyskana - wyniki wyszukiwania tej trasy są nieaktualne
+		for (const auto& [train, version] : touched) {
+			if (train->getVersion() != version) Ftrains.touchRoute(*train);
+		}
+	}
+
+	if (Fjournal != nullptr) {
+		std::vector<Journal::Record> entries;
+		for (const BookingResult& cancelled : result.Fcancellations) entries.push_back(journalEntry(Journal::Operation::CANCEL, cancelled, passengerId));
+		for (const BookingResult& booked : result.Fbookings) entries.push_back(journalEntry(Journal::Operation::BOOK, booked, passengerId));
+
+		// Transakcja nieutrwalona - wycofanie z magazynu i map miejsc (blokady pociągów nadal założone)
+		if (Fjournal->appendGroup(std::move(entries)) == 0) {
+			std::lock_guard<std::mutex> store(FstoreMutex);
+			for (const BookingResult& booked : result.Fbookings) {
+				Ftickets.remove(Ftickets.findRow(booked.FticketId, passengerId));
+				Ftrains.markChanged(booked.FtrainId);
+			}
+			for (const BookingResult& cancelled : result.Fcancellations) {
+				Ftickets.add(cancelled.FticketId, cancelled.FtrainId, passengerId, cancelled.Fseat, cancelled.Fprice);
+				Ftrains.markChanged(cancelled.FtrainId);
+			}
+			rollback();
+			for (const auto& touchedTrain : touched) Ftrains.touchRoute(*touchedTrain.first);
+			result.Fbookings.clear();
+			result.Fcancellations.clear();
+			return fail(BookingStatus::NOT_DURABLE, 0);
+		}
+	}
+	return result;
+}
+
+/**
+ * @brief Przenosi bilet na inne miejsce w tym samym pociągu
+ * @param passengerId Identyfikator loginu właściciela biletu
+ * @param ticketId ID biletu
+ * @param newSeat Nowe miejsce
+ * @return Wynik zmiany
+ */
+BookingResult BookingEngine::changeSeat(uint32_t passengerId, int ticketId, int newSeat) {
+	BookingResult result;
+	result.FticketId = ticketId;
+
+	// Pociąg biletu, potem blokada pociągu i ponowny odczyt biletu
+	int trainId;
+	{
+		std::lock_guard<std::mutex> store(FstoreMutex);
+		size_t row = Ftickets.findRow(ticketId, passengerId);
+		if (row == TicketStore::NPOS) {
+			result.Fstatus = BookingStatus::TICKET_NOT_FOUND;
+			return result;
+		}
+		trainId = Ftickets.trainId(row);
+	}
+	auto locks = lockTrains(std::span<const int>(&trainId, 1));
+	{
+		std::lock_guard<std::mutex> store(FstoreMutex);
+		size_t row = Ftickets.findRow(ticketId, passengerId);
+		if (row == TicketStore::NPOS || Ftickets.trainId(row) != trainId) {
+			result.Fstatus = BookingStatus::TICKET_NOT_FOUND;
+			return result;
+		}
+		result.FtrainId = trainId;
+		result.Fseat = Ftickets.seat(row);
+		result.Fprice = Ftickets.price(row);
+	}
+
+	Train* train = Ftrains.find(result.FtrainId);
+	if (train == nullptr) {
+		result.Fstatus = BookingStatus::TRAIN_NOT_FOUND;
+		return result;
+	}
+	if (newSeat < 1 || newSeat > train->getCapacity()) {
+		result.Fstatus = BookingStatus::INVALID_SEAT;
+		return result;
+	}
+	result.FtravelClass = train->getSeatClass(result.Fseat);
+	if (newSeat == result.Fseat) return result;   // bilet ma już to miejsce
+	if (train->getSeatClass(newSeat) != result.FtravelClass) {
+		result.Fstatus = BookingStatus::CLASS_MISMATCH;
+		return result;
+	}
+
+	// Jedna operacja na mapie miejsc - przy niepowodzeniu stare miejsce pozostaje nietknięte
+	if (!train->moveSeat(result.Fseat, newSeat)) {
+		result.Fstatus = BookingStatus::SEAT_TAKEN;
+		return result;
+	}
+	{
+		std::lock_guard<std::mutex> store(FstoreMutex);
+		Ftickets.setSeat(Ftickets.findRow(ticketId, passengerId), newSeat);
+		Ftrains.markChanged(trainId);
+	}
+
+	// Zmiana nieutrwalona - powrót na stare miejsce
+	if (Fjournal != nullptr && Fjournal->append(journalEntry(Journal::Operation::MOVE, result, passengerId, newSeat)) == 0) {
+		train->moveSeat(newSeat, result.Fseat);
+		std::lock_guard<std::mutex> store(FstoreMutex);
+		Ftickets.setSeat(Ftickets.findRow(ticketId, passengerId), result.Fseat);
+		result.Fstatus = BookingStatus::NOT_DURABLE;
+		return result;
+	}
+	result.Fseat = newSeat;
+	return result;
+}
+
+/**
+ * @brief Wykonuje partię rezerwacji i anulowań pogrupowaną według pociągów
+ *
+ * Operacje sortowane są stabilnie według ID pociągu, więc operacje na jednym
+ * pociągu zachowują kolejność z partii. Blokady pociągów zakładane są raz
+ * na całą partię, a każdy pociąg wyszukiwany raz na grupę. Przebieg:
+ * 1. Odczyt pociągów anulowanych biletów i blokady pociągów.
+ * 2. Zmiany w mapach miejsc - grupa po grupie; przy podłączonej puli partycji
+ *    i dużej partii każda partycja obsługuje swoje pociągi we własnym wątku.
+ * 3. Zatwierdzenie w magazynie biletów (ID biletów, wersje tras) i jeden
+ *    zapis dziennika dla całej partii.
+ * Anulowanie biletu, którego jeszcze nie ma (wystawianego w tej samej partii),
+ * wykonywane jest na końcu.
+ *
+ * @param operations Operacje - wyniki zapisywane są w polach Fresult
+ */
+void BookingEngine::applyGrouped(std::span<QueuedOperation> operations) {
+	// Pociągi anulowanych biletów - klucz grupowania zapisywany w Fresult.FtrainId
+	std::vector<size_t> order, deferred;
+	order.reserve(operations.size());
+	{
+		std::lock_guard<std::mutex> store(FstoreMutex);
+		for (size_t i = 0; i < operations.size(); i++) {
+			QueuedOperation& operation = operations[i];
+			operation.Fresult = BookingResult();
+			operation.Fresult.FticketId = operation.FcancelTicketId;
+			operation.Fresult.FtrainId = operation.Frequest.FtrainId;
+			if (operation.FcancelTicketId != 0) {
+				size_t row = Ftickets.findRow(operation.FcancelTicketId, operation.FpassengerId);
+				if (row == TicketStore::NPOS) {
+					deferred.push_back(i);
+					continue;
+				}
+				operation.Fresult.FtrainId = Ftickets.trainId(row);
+			}
+			order.push_back(i);
+		}
+	}
+	std::stable_sort(order.begin(), order.end(), [operations](size_t a, size_t b) {
+		return operations[a].Fresult.FtrainId < operations[b].Fresult.FtrainId;
+	});
+
+	// Grupy - przedziały tablicy order z jednym pociągiem
+	std::vector<std::pair<size_t, size_t>> groups;
+	std::vector<int> trainIds;
+	for (size_t begin = 0, end; begin < order.size(); begin = end) {
+		int trainId = operations[order[begin]].Fresult.FtrainId;
+		end = begin;
+		while (end < order.size() && operations[order[end]].Fresult.FtrainId == trainId) end++;
+		groups.emplace_back(begin, end);
+		trainIds.push_back(trainId);
+	}
+	auto locks = lockTrains(trainIds);
+
+	// Bilety mogły zmienić się przed założeniem blokad; ten sam bilet anulowany jest tylko raz
+	{
+		std::lock_guard<std::mutex> store(FstoreMutex);
+		std::unordered_set<int> cancelled;
+		for (size_t i : order) {
+			QueuedOperation& operation = operations[i];
+			if (operation.FcancelTicketId == 0) continue;
+			size_t row = Ftickets.findRow(operation.FcancelTicketId, operation.FpassengerId);
+			if (row == TicketStore::NPOS || Ftickets.trainId(row) != operation.Fresult.FtrainId ||
+				!cancelled.insert(operation.FcancelTicketId).second) {
+				operation.Fresult.Fstatus = BookingStatus::TICKET_NOT_FOUND;
+				continue;
+			}
+			operation.Fresult.Fseat = Ftickets.seat(row);
+			operation.Fresult.Fprice = Ftickets.price(row);
+		}
+	}
+
+	// Mapy miejsc - każda grupa dotyka tylko swojego pociągu
+	std::vector<Train*> groupTrains(groups.size());
+	std::vector<uint8_t> touched(groups.size(), 0);
+	auto applyGroup = [&](size_t g) {
+		Train* train = Ftrains.find(trainIds[g]);
+		groupTrains[g] = train;
+		uint32_t version = train != nullptr ? train->getVersion() : 0;
+		for (size_t k = groups[g].first; k < groups[g].second; k++) {
+			QueuedOperation& operation = operations[order[k]];
+			BookingResult& result = operation.Fresult;
+			if (operation.FcancelTicketId != 0) {
+				if (result.Fstatus == BookingStatus::OK && train != nullptr) {
+					result.FtravelClass = train->getSeatClass(result.Fseat);
+					train->cancelSeat(result.Fseat);
+				}
+			}
+			else if (train == nullptr) {
+				result.Fstatus = BookingStatus::TRAIN_NOT_FOUND;
+				result.Fseat = operation.Frequest.Fseat;
+			}
+			else {
+				result = reserve(*train, operation.Frequest);
+			}
+		}
+		touched[g] = train != nullptr && train->getVersion() != version;
+	};
+	if (Fshards != nullptr && Fshards->size() > 1 && order.size() >= PARALLEL_OPERATIONS) {
+		// Grupy rozdzielone z góry - wątek partycji przegląda tylko swoje grupy
+		std::vector<std::vector<size_t>> shardGroups(Fshards->size());
+		for (size_t g = 0; g < groups.size(); g++) shardGroups[Fshards->shardOf(trainIds[g])].push_back(g);
+		Fshards->scatter([&](size_t shard) {
+			for (size_t g : shardGroups[shard]) applyGroup(g);
+		});
+	}
+	else {
+		for (size_t g = 0; g < groups.size(); g++) applyGroup(g);
+	}
+
+	// Zatwierdzenie - magazyn biletów i wersje tras w kolejności grup, jeden zapis dziennika
+	{
+		std::lock_guard<std::mutex> store(FstoreMutex);
+		std::vector<Journal::Record> entries;
+		for (size_t i : order) {
+			QueuedOperation& operation = operations[i];
+			BookingResult& result = operation.Fresult;
+			if (result.Fstatus != BookingStatus::OK) continue;
+			Ftrains.markChanged(result.FtrainId);
+
+			if (operation.FcancelTicketId != 0) {
+				Ftickets.remove(Ftickets.findRow(operation.FcancelTicketId, operation.FpassengerId));
+				entries.push_back(journalEntry(Journal::Operation::CANCEL, result, operation.FpassengerId));
+			}
+			else {
+				do result.FticketId = FticketIds.next();
+				while (!Ftickets.add(result.FticketId, result.FtrainId, operation.FpassengerId, result.Fseat, result.Fprice));
+				entries.push_back(journalEntry(Journal::Operation::BOOK, result, operation.FpassengerId));
+			}
+		}
+		for (size_t g = 0; g < groups.size(); g++) {
+			if (touched[g]) Ftrains.touchRoute(*groupTrains[g]);
+		}
+
+		// Partia nieutrwalona - operacje wycofywane od końca (miejsce zwolnione i zajęte w tej partii wraca do pierwszego właściciela)
+		if (Fjournal != nullptr && !entries.empty() && Fjournal->appendGroup(std::move(entries)) == 0) {
+			for (size_t k = order.size(); k-- > 0;) {
+				QueuedOperation& operation = operations[order[k]];
+				BookingResult& result = operation.Fresult;
+				if (result.Fstatus != BookingStatus::OK) continue;
+				Train* train = Ftrains.find(result.FtrainId);
+				if (operation.FcancelTicketId != 0) {
+					Ftickets.add(result.FticketId, result.FtrainId, operation.FpassengerId, result.Fseat, result.Fprice);
+					if (train != nullptr) train->reserveSeat(result.Fseat);
+				}
+				else {
+					Ftickets.remove(Ftickets.findRow(result.FticketId, operation.FpassengerId));
+					if (train != nullptr) train->cancelSeat(result.Fseat);
+				}
+				result.Fstatus = BookingStatus::NOT_DURABLE;
+			}
+			for (size_t g = 0; g < groups.size(); g++) {
+				if (groupTrains[g] != nullptr) Ftrains.touchRoute(*groupTrains[g]);
+			}
+		}
+	}
+	locks.clear();
+
+	for (size_t i : deferred) operations[i].Fresult = cancel(operations[i].FpassengerId, operations[i].FcancelTicketId);
+}
+
+/**
+ * @brief Zwraca aktualną migawkę pociągów i sprzedaży
+ *
+ * Przebieg:
+ * 1. Odczyt zbioru zmienionych pociągów (pod blokadą magazynu).
+ * 2. Blokady tych pociągów i magazynu. Jeśli w międzyczasie zatwierdzono
+ *    zmiany innych pociągów, blokady są zwalniane i zakładane ponownie
+ *    dla sumy obu zbiorów - migawka nie może objąć połowy transakcji.
+ * 3. Kopia stron ze zmienionymi pociągami; pozostałe strony są współdzielone.
+ * Pociągi spoza zbioru nie mają zatwierdzonych zmian, więc ich
+ * podsumowania z poprzedniej migawki są aktualne.
+ *
+ * @return Migawka
+ */
+std::shared_ptr<const CatalogSnapshot> BookingEngine::snapshot() {
+	std::lock_guard<std::mutex> guard(FsnapshotMutex);
+
+	std::vector<int> changed;
+	{
+		std::lock_guard<std::mutex> store(FstoreMutex);
+		if (Fsnapshot != nullptr && Fsnapshot->structureVersion() == Ftrains.structureVersion() && Ftrains.changed().empty()) return Fsnapshot;
+		changed.assign(Ftrains.changed().begin(), Ftrains.changed().end());
+	}
+
+	while (Fsnapshot != nullptr) {
+		auto locks = lockTrains(changed);
+		std::lock_guard<std::mutex> store(FstoreMutex);
+		if (Fsnapshot->structureVersion() != Ftrains.structureVersion()) break;
+
+		// Każdy zmieniony pociąg musi być zablokowany (blokada paska)
+		std::vector<bool> locked(LOCK_STRIPES, false);
+		for (int trainId : changed) locked[static_cast<uint32_t>(trainId) % LOCK_STRIPES] = true;
+		bool covered = true;
+		for (int trainId : Ftrains.changed()) {
+			if (!locked[static_cast<uint32_t>(trainId) % LOCK_STRIPES]) {
+				changed.push_back(trainId);
+				covered = false;
+			}
+		}
+		if (!covered) continue;
+
+		changed.assign(Ftrains.changed().begin(), Ftrains.changed().end());
+		Fsnapshot = Fsnapshot->update(changed, Ftrains, Ftickets);
+		Ftrains.clearChanged();
+		return Fsnapshot;
+	}
+
+	// Pierwsza migawka lub zmiana zbioru pociągów - pełna migawka pod wszystkimi blokadami
+	std::vector<std::unique_lock<std::mutex>> locks;
+	locks.reserve(LOCK_STRIPES);
+	for (std::mutex& stripe : FtrainLocks) locks.emplace_back(stripe);
+	std::lock_guard<std::mutex> store(FstoreMutex);
+	Fsnapshot = CatalogSnapshot::build(Ftrains, Ftickets);
+	Ftrains.clearChanged();
+	return Fsnapshot;
+}
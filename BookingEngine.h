@@ -0,0 +1,314 @@
+/**
+ * @file BookingEngine.h
+ * @brief Deklaracja klasy BookingEngine - nieinteraktywny rdzeń operacji rezerwacyjnych
+ */
+
+#pragma once
+#include "Train.h"
+#include "TrainCatalog.h"
+#include "TicketStore.h"
+#include "IdAllocator.h"
+#include "PricingEngine.h"
+#include "SearchCache.h"
+#include "Journal.h"
+#include "ShardPool.h"
+#include "CatalogSnapshot.h"
+#include <array>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @enum BookingStatus
+ * @brief Wynik operacji rezerwacyjnej
+ */
+enum class BookingStatus {
+	OK,                 ///< Operacja zakończona powodzeniem
+	TRAIN_NOT_FOUND,    ///< Pociąg o podanym ID nie istnieje
+	SEAT_TAKEN,         ///< Miejsce zajęte lub brak wolnych miejsc w klasie
+	CLASS_MISMATCH,     ///< Wybrane miejsce należy do innej klasy
+	INVALID_SEAT,       ///< Numer miejsca spoza zakresu 1..pojemność pociągu
+	TICKET_NOT_FOUND,   ///< Bilet nie istnieje lub należy do innego pasażera
+	NOT_DURABLE         ///< Zapis w dzienniku nie powiódł się - operacja została wycofana
+};
+
+/**
+ * @struct BookingResult
+ * @brief Szczegóły wykonanej rezerwacji lub anulowania
+ */
+struct BookingResult {
+	BookingStatus Fstatus = BookingStatus::OK;   ///< Wynik operacji
+	int FticketId = 0;                           ///< ID biletu
+	int FtrainId = 0;                            ///< ID pociągu
+	int Fseat = 0;                               ///< Numer miejsca
+	int FtravelClass = 0;                        ///< Klasa miejsca
+	double Fprice = 0.0;                         ///< Cena biletu
+};
+
+/**
+ * @struct BookingRequest
+ * @brief Jedna rezerwacja w transakcji
+ */
+struct BookingRequest {
+	int FtrainId = 0;       ///< ID pociągu
+	int Fseat = 0;          ///< Numer miejsca (0 - pierwsze wolne w klasie)
+	int FtravelClass = 0;   ///< Klasa podróży (0 - klasa wybranego miejsca)
+};
+
+/**
+ * @struct TransactionResult
+ * @brief Wynik transakcji złożonej z anulowań i rezerwacji
+ */
+struct TransactionResult {
+	BookingStatus Fstatus = BookingStatus::OK;   ///< Wynik całej transakcji
+	size_t FfailedIndex = 0;                     ///< Indeks nieudanego elementu (anulowania przy TICKET_NOT_FOUND, inaczej rezerwacji)
+	std::vector<BookingResult> Fcancellations;   ///< Anulowane bilety (przy powodzeniu)
+	std::vector<BookingResult> Fbookings;        ///< Wystawione bilety (przy niepowodzeniu rezerwacji - tylko nieudana)
+};
+
+/**
+ * @struct QueuedOperation
+ * @brief Rezerwacja lub anulowanie oczekujące w partii (BookingEngine::applyGrouped)
+ */
+struct QueuedOperation {
+	uint32_t FpassengerId = 0;   ///< Identyfikator loginu pasażera
+	int FcancelTicketId = 0;     ///< Bilet do anulowania (0 - rezerwacja Frequest)
+	BookingRequest Frequest;     ///< Żądana rezerwacja
+	BookingResult Fresult;       ///< Wynik operacji (wypełniany przy wykonaniu)
+};
+
+/**
+ * @enum SearchSort
+ * @brief Kolejność wyników wyszukiwania
+ */
+enum class SearchSort {
+	DATE,           ///< Według daty i godziny odjazdu (rosnąco)
+	FREE_SEATS,     ///< Według liczby wolnych miejsc (malejąco)
+	PRICE           ///< Według ceny (rosnąco)
+};
+
+/**
+ * @struct SearchPage
+ * @brief Jedna strona posortowanych wyników wyszukiwania
+ */
+struct SearchPage {
+	std::vector<const Train*> Ftrains;   ///< Pociągi na stronie
+	std::vector<double> Fprices;         ///< Ceny (równoległe do Ftrains)
+	size_t Ftotal = 0;                   ///< Liczba wszystkich pasujących pociągów
+};
+
+/**
+ * @class BookingEngine
+ * @brief Wspólny rdzeń rezerwacji dla menu interaktywnego i trybu wsadowego
+ *
+ * Silnik nie prowadzi dialogu z użytkownikiem - przyjmuje gotowe parametry
+ * i zwraca wynik. Operuje na katalogu pociągów, magazynie biletów
+ * i generatorze ID przekazanych w konstruktorze (nie jest ich właścicielem).
+ * Ceny wylicza podłączony PricingEngine, wyszukiwanie korzysta z SearchCache.
+ * Gdy rezerwacja lub anulowanie zmienia dostępność klasy pociągu, silnik
+ * zwiększa wersję trasy, unieważniając zależne wyniki wyszukiwania.
+ *
+ * Operacje na biletach mogą być wywoływane z wielu wątków. Mapy miejsc
+ * chronią blokady pociągów (paski według ID pociągu, zakładane rosnąco),
+ * a magazyn biletów i wersje tras - krótka blokada magazynu, zakładana
+ * zawsze po blokadach pociągów.
+ *
+ * Raporty i pełne przeglądy katalogu korzystają z migawek (snapshot()) -
+ * czytelnik przegląda niezmienną migawkę bez żadnych blokad.
+ */
+class BookingEngine
+{
+public:
+	static constexpr int ANY_CLASS = 0;      ///< Dowolna klasa (klasa wynika z wybranego miejsca)
+	static constexpr int SECOND_CLASS = 1;   ///< Druga klasa (standard)
+	static constexpr int FIRST_CLASS = 2;    ///< Pierwsza klasa (komfort)
+	static constexpr size_t LOCK_STRIPES = 64;   ///< Liczba blokad pociągów
+	static constexpr size_t PARALLEL_OPERATIONS = 64;   ///< Najmniejsza partia rozdzielana między partycje
+
+private:
+	TrainCatalog& Ftrains;      ///< Katalog pociągów
+	TicketStore& Ftickets;      ///< Magazyn biletów
+	IdAllocator& FticketIds;    ///< Generator ID biletów
+	const PricingEngine& Fpricing;  ///< Cennik
+	SearchCache Fsearch;        ///< Pamięć podręczna wyników wyszukiwania
+	Journal* Fjournal;          ///< Dziennik operacji (nullptr - bez dziennika)
+	ShardPool* Fshards;         ///< Pula partycji pociągów (nullptr - bez wątków roboczych)
+
+	std::array<std::mutex, LOCK_STRIPES> FtrainLocks;   ///< Blokady map miejsc (pasek = ID pociągu % LOCK_STRIPES)
+	std::mutex FstoreMutex;     ///< Chroni magazyn biletów i wersje tras
+	std::mutex FsnapshotMutex;  ///< Jedna aktualizacja migawki naraz
+	std::shared_ptr<const CatalogSnapshot> Fsnapshot;   ///< Ostatnia migawka (chroniona przez FsnapshotMutex)
+
+	/**
+	 * @brief Tworzy wpis dziennika dla wyniku operacji
+	 * @param operation Rodzaj operacji
+	 * @param result Wynik operacji (bilet, pociąg, miejsce, cena)
+	 * @param passengerId Identyfikator loginu pasażera
+	 * @param newSeat Nowe miejsce (tylko zmiana miejsca)
+	 * @return Wpis dziennika
+	 */
+	static Journal::Record journalEntry(Journal::Operation operation, const BookingResult& result, uint32_t passengerId, int newSeat = 0);
+
+	/**
+	 * @brief Rezerwuje miejsce w zablokowanym pociągu (bez wystawienia biletu)
+	 * @param train Pociąg
+	 * @param request Żądana rezerwacja
+	 * @return Wynik (przy powodzeniu - miejsce, klasa i cena)
+	 */
+	BookingResult reserve(Train& train, const BookingRequest& request);
+
+	/**
+	 * @brief Zakłada blokady pociągów rosnąco według paska (bez zakleszczeń)
+	 * @param trainIds ID pociągów (mogą się powtarzać)
+	 * @return Założone blokady
+	 */
+	std::vector<std::unique_lock<std::mutex>> lockTrains(std::span<const int> trainIds);
+
+public:
+	/**
+	 * @brief Konstruktor klasy BookingEngine
+	 * @param trains Katalog pociągów
+	 * @param tickets Magazyn biletów
+	 * @param ticketIds Generator ID biletów
+	 * @param pricing Cennik
+	 */
+	BookingEngine(TrainCatalog& trains, TicketStore& tickets, IdAllocator& ticketIds, const PricingEngine& pricing);
+
+	/**
+	 * @brief Podłącza dziennik, do którego trafia każda udana operacja na biletach
+	 * @param journal Dziennik (nullptr - bez dziennika)
+	 */
+	void setJournal(Journal* journal);
+
+	/**
+	 * @brief Podłącza pulę partycji - duże partie i pełne przeglądy katalogu wykonywane są równolegle
+	 * @param shards Pula (nullptr - wszystko w wątku wywołującym)
+	 */
+	void setShards(ShardPool* shards);
+
+	// Dostęp do danych, na których operuje silnik
+	TrainCatalog& trains();
+	const TrainCatalog& trains() const;
+	TicketStore& tickets();
+	const TicketStore& tickets() const;
+
+	/**
+	 * @brief Wyszukuje pociągi pasujące do zapytania (z pamięcią podręczną)
+	 * @param query Znormalizowane zapytanie
+	 * @return Pasujące pociągi (ważne do następnego wyszukiwania lub zmiany katalogu)
+	 */
+	const std::vector<const Train*>& search(const SearchQuery& query);
+
+	/**
+	 * @brief Zwraca pamięć podręczną wyszukiwania (statystyki)
+	 * @return Pamięć podręczna
+	 */
+	const SearchCache& searchCache() const;
+
+	/**
+	 * @brief Zwraca stronę posortowanych wyników wyszukiwania
+	 *
+	 * Sortowana jest tylko część wyników potrzebna do wskazanej strony
+	 * (częściowe sortowanie pierwszych offset + pageSize elementów),
+	 * więc strona kosztuje O(n log k) zamiast sortowania całego wyniku.
+	 * Remisy rozstrzyga ID pociągu, dzięki czemu strony są rozłączne.
+	 *
+	 * @param query Znormalizowane zapytanie
+	 * @param sort Kolejność wyników
+	 * @param offset Liczba pominiętych wyników
+	 * @param pageSize Maksymalna liczba wyników na stronie
+	 * @return Strona wyników z cenami (klasa zapytania lub druga klasa)
+	 */
+	SearchPage searchPage(const SearchQuery& query, SearchSort sort, size_t offset, size_t pageSize);
+
+	/**
+	 * @brief Wylicza cenę biletu na dany pociąg
+	 * @param train Pociąg
+	 * @param travelClass Klasa podróży (SECOND_CLASS lub FIRST_CLASS)
+	 * @return Cena w PLN
+	 */
+	double quote(const Train& train, int travelClass) const;
+
+	/**
+	 * @brief Wylicza ceny dla strony wyników wyszukiwania jednym wywołaniem cennika
+	 * @param trains Pociągi na stronie wyników
+	 * @param travelClass Klasa podróży
+	 * @param prices Tablica na ceny (co najmniej trains.size() elementów)
+	 */
+	void quoteBatch(std::span<const Train* const> trains, int travelClass, std::span<double> prices) const;
+
+	/**
+	 * @brief Rezerwuje miejsce i wystawia bilet
+	 * @param passengerId Identyfikator loginu pasażera
+	 * @param trainId ID pociągu
+	 * @param seat Numer miejsca (0 - pierwsze wolne miejsce w podanej klasie)
+	 * @param travelClass Klasa podróży (ANY_CLASS - klasa wybranego miejsca)
+	 * @return Wynik rezerwacji (ID biletu i cena przy powodzeniu)
+	 */
+	BookingResult book(uint32_t passengerId, int trainId, int seat, int travelClass);
+
+	/**
+	 * @brief Anuluje bilet pasażera i zwalnia miejsce w pociągu
+	 * @param passengerId Identyfikator loginu właściciela biletu
+	 * @param ticketId ID biletu
+	 * @return Wynik anulowania (pociąg i miejsce anulowanego biletu)
+	 */
+	BookingResult cancel(uint32_t passengerId, int ticketId);
+
+	/**
+	 * @brief Wykonuje atomowo anulowania i rezerwacje, także na wielu pociągach
+	 *
+	 * Wszystkie elementy udają się razem albo żaden nie zostaje zastosowany
+	 * (np. zamiana biletu: nowa rezerwacja i anulowanie starej). Blokowane są
+	 * tylko pociągi transakcji. W dzienniku transakcja zapisywana jest jako
+	 * jedna grupa - po awarii odtwarzana w całości albo wcale.
+	 *
+	 * @param passengerId Identyfikator loginu pasażera
+	 * @param cancellations ID biletów pasażera do anulowania
+	 * @param bookings Żądane rezerwacje
+	 * @return Wynik transakcji (przy niepowodzeniu - status i indeks elementu)
+	 */
+	TransactionResult transact(uint32_t passengerId, std::span<const int> cancellations, std::span<const BookingRequest> bookings);
+
+	/**
+	 * @brief Wykonuje partię niezależnych rezerwacji i anulowań pogrupowaną według pociągów
+	 *
+	 * Każda operacja ma własny wynik (nie jest to transakcja). Operacje jednego
+	 * pociągu wykonywane są razem i w kolejności z partii, pod jedną blokadą,
+	 * a udane operacje całej partii zapisywane są w dzienniku jednym zapisem.
+	 *
+	 * @param operations Operacje - wyniki w polach Fresult, w kolejności partii
+	 */
+	void applyGrouped(std::span<QueuedOperation> operations);
+
+	/**
+	 * @brief Przenosi bilet pasażera na inne miejsce tej samej klasy w tym samym pociągu
+	 *
+	 * Miejsce zmieniane jest jedną operacją Train::moveSeat pod blokadą pociągu,
+	 * więc bilet nigdy nie wskazuje miejsca zajętego przez kogoś innego,
+	 * a przy niepowodzeniu zachowuje dotychczasowe miejsce.
+	 *
+	 * @param passengerId Identyfikator loginu właściciela biletu
+	 * @param ticketId ID biletu
+	 * @param newSeat Nowe miejsce
+	 * @return Wynik zmiany (Fseat - nowe miejsce przy powodzeniu, także gdy bilet
+	 *         już ma to miejsce; INVALID_SEAT - numer spoza zakresu)
+	 */
+	BookingResult changeSeat(uint32_t passengerId, int ticketId, int newSeat);
+
+	/**
+	 * @brief Zwraca aktualną, spójną migawkę pociągów i sprzedaży
+	 *
+	 * Migawka jest uzupełniana tylko o pociągi zmienione od poprzedniej
+	 * (blokowane są wyłącznie one i to na czas przeliczenia ich podsumowań).
+	 * Dopiero dodanie lub usunięcie pociągu wymaga pełnej migawki pod
+	 * blokadami wszystkich pociągów. Zwróconą migawkę można przeglądać
+	 * dowolnie długo bez blokad - rezerwacje w tym czasie jej nie zmieniają.
+	 *
+	 * @return Migawka (współdzielona, niezmienna)
+	 */
+	std::shared_ptr<const CatalogSnapshot> snapshot();
+};
@@ -0,0 +1,164 @@
+/**
+ * @file CatalogSnapshot.cpp
+ * @brief Implementacja klasy CatalogSnapshot - strony podsumowań kopiowane przy zmianie
+ */
+
+#include "CatalogSnapshot.h"
+#include <algorithm>
+
+/**
+ * @brief Przelicza sumy częściowe strony
+ */
+void CatalogSnapshot::Page::total() {
+	Ftickets = 0;
+	Frevenue = 0.0;
+	Foccupied = 0;
+	Fcapacity = 0;
+	for (const TrainSummary& row : Frows) {
+		Ftickets += row.Ftickets;
+		Frevenue += row.Frevenue;
+		Foccupied += static_cast<uint64_t>(row.Foccupied);
+		Fcapacity += static_cast<uint64_t>(row.Fcapacity);
+	}
+}
+
+/**
+ * @brief Tworzy podsumowanie pociągu
+ * @param train Pociąg
+ * @param tickets Magazyn biletów
+ * @return Podsumowanie
+ */
+TrainSummary CatalogSnapshot::summarize(const Train& train, const TicketStore& tickets) {
+	TrainSummary summary;
+	summary.Fid = train.getID();
+	summary.ForiginId = train.getOriginId();
+	summary.FdestinationId = train.getDestinationId();
+	summary.FdateKey = Train::dateKey(train.getDate());
+	summary.Fdeparture = train.getDeparture();
+	summary.Farrival = train.getArrival();
+	summary.Fcapacity = train.getCapacity();
+	summary.Foccupied = train.getOccupiedSeatsCount();
+	summary.FfreeSecond = train.getFreeSeatsCount(1);
+	summary.FfreeFirst = train.getFreeSeatsCount(2);
+	tickets.forEachOfTrain(summary.Fid, [&summary, &tickets](size_t row) {
+		summary.Ftickets++;
+		summary.Frevenue += tickets.price(row);
+	});
+	return summary;
+}
+
+/**
+ * @brief Przelicza sumy migawki z sum częściowych stron
+ */
+void CatalogSnapshot::total() {
+	Ftickets = 0;
+	Frevenue = 0.0;
+	Foccupied = 0;
+	Fcapacity = 0;
+	for (const auto& page : Fpages) {
+		Ftickets += page->Ftickets;
+		Frevenue += page->Frevenue;
+		Foccupied += page->Foccupied;
+		Fcapacity += page->Fcapacity;
+	}
+}
+
+/**
+ * @brief Tworzy pełną migawkę katalogu
+ *
+ * Pociągi trafiają na strony w kolejności gęstej tablicy katalogu.
+ *
+ * @param trains Katalog pociągów
+ * @param tickets Magazyn biletów
+ * @return Migawka
+ */
+std::shared_ptr<const CatalogSnapshot> CatalogSnapshot::build(const TrainCatalog& trains, const TicketStore& tickets) {
+	auto snapshot = std::make_shared<CatalogSnapshot>();
+	auto positions = std::make_shared<std::unordered_map<int, uint32_t>>();
+	positions->reserve(trains.size());
+
+	std::shared_ptr<Page> page;
+	for (const Train* train : trains) {
+		if (page == nullptr) {
+			page = std::make_shared<Page>();
+			page->Frows.reserve(PAGE_TRAINS);
+		}
+		positions->emplace(train->getID(), static_cast<uint32_t>(snapshot->Ftrains++));
+		page->Frows.push_back(summarize(*train, tickets));
+		if (page->Frows.size() == PAGE_TRAINS) {
+			page->total();
+			snapshot->Fpages.push_back(std::move(page));
+		}
+	}
+	if (page != nullptr) {
+		page->total();
+		snapshot->Fpages.push_back(std::move(page));
+	}
+
+	snapshot->Fpositions = std::move(positions);
+	snapshot->Fstructure = trains.structureVersion();
+	snapshot->total();
+	return snapshot;
+}
+
+/**
+ * @brief Tworzy kolejną migawkę ze zmienionymi pociągami
+ *
+ * Każda strona zawierająca zmieniony pociąg jest kopiowana raz; pozostałe
+ * strony i mapa pozycji są współdzielone z tą migawką.
+ *
+ * @param changed ID zmienionych pociągów
+ * @param trains Katalog pociągów
+ * @param tickets Magazyn biletów
+ * @return Nowa migawka
+ */
+std::shared_ptr<const CatalogSnapshot> CatalogSnapshot::update(std::span<const int> changed, const TrainCatalog& trains, const TicketStore& tickets) const {
+	auto snapshot = std::make_shared<CatalogSnapshot>(*this);
+
+	std::unordered_map<size_t, std::shared_ptr<Page>> copies;   // numer strony -> kopia
+	for (int id : changed) {
+		auto position = Fpositions->find(id);
+		const Train* train = trains.find(id);
+		if (position == Fpositions->end() || train == nullptr) continue;
+
+		size_t pageIndex = position->second / PAGE_TRAINS;
+		std::shared_ptr<Page>& copy = copies[pageIndex];
+		if (copy == nullptr) copy = std::make_shared<Page>(*Fpages[pageIndex]);
+		copy->Frows[position->second % PAGE_TRAINS] = summarize(*train, tickets);
+	}
+
+	for (auto& [pageIndex, copy] : copies) {
+		copy->total();
+		snapshot->Fpages[pageIndex] = std::move(copy);
+	}
+	snapshot->total();
+	return snapshot;
+}
+
+/**
+ * @brief Wyszukuje podsumowanie pociągu
+ * @param id ID pociągu
+ * @return Podsumowanie lub nullptr
+ */
+const TrainSummary* CatalogSnapshot::find(int id) const {
+	auto position = Fpositions->find(id);
+	if (position == Fpositions->end()) return nullptr;
+	return &at(position->second);
+}
+
+/**
+ * @brief Zwraca podsumowanie pociągu o danym numerze wiersza
+ * @param index Numer wiersza
+ * @return Podsumowanie
+ */
+const TrainSummary& CatalogSnapshot::at(size_t index) const {
+	return Fpages[index / PAGE_TRAINS]->Frows[index % PAGE_TRAINS];
+}
+
+// Sumy z chwili wykonania migawki
+uint64_t CatalogSnapshot::structureVersion() const { return Fstructure; }
+size_t CatalogSnapshot::trainCount() const { return Ftrains; }
+size_t CatalogSnapshot::ticketCount() const { return Ftickets; }
+double CatalogSnapshot::revenue() const { return Frevenue; }
+uint64_t CatalogSnapshot::occupiedSeats() const { return Foccupied; }
+uint64_t CatalogSnapshot::capacity() const { return Fcapacity; }
@@ -0,0 +1,149 @@
+/**
+ * @file CatalogSnapshot.h
+ * @brief Deklaracja klasy CatalogSnapshot - niezmienna migawka katalogu do raportów
+ */
+
+#pragma once
+#include "TrainCatalog.h"
+#include "TicketStore.h"
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct TrainSummary
+ * @brief Stan jednego pociągu w chwili wykonania migawki
+ */
+struct TrainSummary {
+	int Fid = 0;                   ///< ID pociągu
+	uint32_t ForiginId = 0;        ///< Identyfikator stacji początkowej
+	uint32_t FdestinationId = 0;   ///< Identyfikator stacji końcowej
+	uint32_t FdateKey = 0;         ///< Data kursu (RRRRMMDD)
+	uint16_t Fdeparture = 0;       ///< Odjazd w minutach od północy
+	uint16_t Farrival = 0;         ///< Przyjazd w minutach od północy
+	int Fcapacity = 0;             ///< Liczba miejsc
+	int Foccupied = 0;             ///< Liczba zajętych miejsc
+	int FfreeSecond = 0;           ///< Wolne miejsca w drugiej klasie
+	int FfreeFirst = 0;            ///< Wolne miejsca w pierwszej klasie
+	size_t Ftickets = 0;           ///< Liczba biletów na pociąg
+	double Frevenue = 0.0;         ///< Przychód z biletów na pociąg
+};
+
+/**
+ * @class CatalogSnapshot
+ * @brief Spójny, niezmienny widok pociągów i sprzedaży (wielowersyjność przez kopiowanie stron)
+ *
+ * Podsumowania pociągów leżą na stronach po PAGE_TRAINS wierszy. Kolejna
+ * migawka powstaje przez update(): kopiowane są tylko strony z pociągami
+ * zmienionymi od poprzedniej migawki, pozostałe strony są współdzielone
+ * (shared_ptr). Strona żyje, dopóki trzyma ją którakolwiek migawka, więc
+ * czytelnik, który zachował wskaźnik na migawkę, przegląda ją bez blokad,
+ * a piszący w tym czasie rezerwują dalej.
+ *
+ * Migawkę tworzy i publikuje BookingEngine::snapshot(); sama klasa
+ * niczego nie blokuje - wywołujący zapewnia, że katalog i magazyn
+ * nie zmieniają się w trakcie build() i update().
+ */
+class CatalogSnapshot
+{
+public:
+	static constexpr size_t PAGE_TRAINS = 256;   ///< Liczba pociągów na stronie
+
+private:
+	/**
+	 * @struct Page
+	 * @brief Strona podsumowań z sumami częściowymi
+	 */
+	struct Page {
+		std::vector<TrainSummary> Frows;   ///< Podsumowania pociągów
+		size_t Ftickets = 0;               ///< Suma biletów na stronie
+		double Frevenue = 0.0;             ///< Suma przychodu na stronie
+		uint64_t Foccupied = 0;            ///< Suma zajętych miejsc na stronie
+		uint64_t Fcapacity = 0;            ///< Suma miejsc na stronie
+
+		/**
+		 * @brief Przelicza sumy częściowe strony
+		 */
+		void total();
+	};
+
+	std::vector<std::shared_ptr<const Page>> Fpages;                          ///< Strony (współdzielone między migawkami)
+	std::shared_ptr<const std::unordered_map<int, uint32_t>> Fpositions;      ///< ID pociągu -> numer wiersza (współdzielone)
+	uint64_t Fstructure = 0;      ///< Wersja struktury katalogu (TrainCatalog::structureVersion)
+	size_t Ftrains = 0;           ///< Liczba pociągów
+	size_t Ftickets = 0;          ///< Liczba biletów
+	double Frevenue = 0.0;        ///< Przychód z biletów
+	uint64_t Foccupied = 0;       ///< Zajęte miejsca we wszystkich pociągach
+	uint64_t Fcapacity = 0;       ///< Miejsca we wszystkich pociągach
+
+	/**
+	 * @brief Tworzy podsumowanie pociągu
+	 * @param train Pociąg
+	 * @param tickets Magazyn biletów
+	 * @return Podsumowanie
+	 */
+	static TrainSummary summarize(const Train& train, const TicketStore& tickets);
+
+	/**
+	 * @brief Przelicza sumy migawki z sum częściowych stron
+	 */
+	void total();
+
+public:
+	/**
+	 * @brief Tworzy pełną migawkę katalogu
+	 * @param trains Katalog pociągów
+	 * @param tickets Magazyn biletów
+	 * @return Migawka
+	 */
+	static std::shared_ptr<const CatalogSnapshot> build(const TrainCatalog& trains, const TicketStore& tickets);
+
+	/**
+	 * @brief Tworzy kolejną migawkę, w której zmieniły się tylko podane pociągi
+	 *
+	 * Struktura katalogu (zbiór pociągów) musi być taka sama jak przy tej
+	 * migawce - inaczej potrzebna jest pełna migawka build().
+	 *
+	 * @param changed ID zmienionych pociągów (mogą się powtarzać)
+	 * @param trains Katalog pociągów
+	 * @param tickets Magazyn biletów
+	 * @return Nowa migawka (ta migawka pozostaje bez zmian)
+	 */
+	std::shared_ptr<const CatalogSnapshot> update(std::span<const int> changed, const TrainCatalog& trains, const TicketStore& tickets) const;
+
+	/**
+	 * @brief Wyszukuje podsumowanie pociągu
+	 * @param id ID pociągu
+	 * @return Podsumowanie lub nullptr
+	 */
+	const TrainSummary* find(int id) const;
+
+	/**
+	 * @brief Zwraca podsumowanie pociągu o danym numerze wiersza
+	 * @param index Numer wiersza (0..trainCount()-1)
+	 * @return Podsumowanie
+	 */
+	const TrainSummary& at(size_t index) const;
+
+	// Sumy z chwili wykonania migawki
+	uint64_t structureVersion() const;
+	size_t trainCount() const;
+	size_t ticketCount() const;
+	double revenue() const;
+	uint64_t occupiedSeats() const;
+	uint64_t capacity() const;
+
+	/**
+	 * @brief Odwiedza podsumowania wszystkich pociągów
+	 * @param visit Funkcja wywoływana jako visit(const TrainSummary&)
+	 */
+	template <typename Visitor>
+	void forEach(Visitor visit) const {
+		for (const auto& page : Fpages) {
+			for (const TrainSummary& row : page->Frows) visit(row);
+		}
+	}
+};
@@ -4,15 +4,20 @@
  */
 
 #include "DataManager.h"
+#include "StringPool.h"
+#include "PasswordHasher.h"
+#include "DurableFile.h"
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <utility>
 
 /**
  * @brief Konstruktor DataManager
+ * @param log Strumień komunikatów o wczytaniu i zapisie plików
  */
-DataManager::DataManager(){}
+DataManager::DataManager(std::ostream& log) : Flog(log), Fjournal(FjournalFile), FtrainsSequence(0), FticketsSequence(0) {}
 
 /**
  * @brief Usuwa białe znaki (spacje, tabulatory, nowe linie) z początku i końca tekstu
@@ -29,6 +34,95 @@ std::string DataManager::trim(const std::string& str) {
 	return str.substr(first, (last - first + 1));
 }
 
+/**
+ * @brief Dopisuje rekord YAML zakończony sumą kontrolną
+ * @param out Zawartość pliku
+ * @param fields Pola rekordu (linie "klucz: wartość")
+ */
+static void appendRecord(std::string& out, const std::string& fields) {
+	out += "---\n";
+	out += fields;
+	out += "checksum: " + DurableFile::formatCrc(DurableFile::crc32(fields)) + "\n";
+}
+
+/**
+ * @brief Wczytuje plik rekordów YAML, sprawdzając sumy kontrolne
+ *
+ * Suma kontrolna rekordu liczona jest z jego linii (bez separatora "---"
+ * i bez znaków '\r'), w postaci, w jakiej zapisuje je appendRecord.
+ *
+ * @param path Ścieżka do pliku
+ * @param sequence Zmienna, do której zostanie zapisany numer z nagłówka
+ * @param field Obsługa pola rekordu
+ * @param flush Obsługa końca rekordu
+ * @return false jeśli pliku nie udało się otworzyć
+ */
+template<typename Field, typename Flush>
+bool DataManager::readRecords(const std::string& path, uint64_t& sequence, Field field, Flush flush) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open()) return false;
+
+	sequence = 0;
+	std::string line, fields, checksum;
+	std::vector<std::pair<std::string, std::string>> pairs;
+	size_t rejected = 0;
+
+	// Przekazuje zebrany rekord, jeśli jego suma kontrolna się zgadza
+	auto finishRecord = [&]() {
+		if (!pairs.empty()) {
+			if (!checksum.empty() && checksum != DurableFile::formatCrc(DurableFile::crc32(fields))) {
+				rejected++;
+			}
+			else {
+				for (const auto& [key, value] : pairs) field(key, value);
+				flush();
+			}
+		}
+		pairs.clear(); fields.clear(); checksum.clear();
+	};
+
+	// Parsowanie pliku YAML linia po linii
+	while (std::getline(file, line)) {
+		if (!line.empty() && line.back() == '\r') line.pop_back();
+		std::string trimmed = trim(line);
+		if (trimmed == "---") {
+			finishRecord();
+			continue;
+		}
+		if (trimmed.rfind("# sequence:", 0) == 0) {
+			try { sequence = std::stoull(trimmed.substr(11)); } catch (...) { sequence = 0; }
+			continue;
+		}
+
+		// Parsowanie pary klucz:wartość
+		size_t colonPos = trimmed.find(":");
+		if (colonPos == std::string::npos || trimmed[0] == '#') continue;
+		std::string key = trim(trimmed.substr(0, colonPos));
+		std::string value = trim(trimmed.substr(colonPos + 1));
+		if (key == "checksum") {
+			checksum = value;
+			continue;
+		}
+		fields += line;
+		fields += '\n';
+		pairs.emplace_back(std::move(key), std::move(value));
+	}
+	finishRecord();
+
+	if (rejected > 0) {
+		std::cerr << "Ostrzezenie: " << rejected << " rekordow w " << path << " ma bledna sume kontrolna (pominiete)" << std::endl;
+	}
+	return true;
+}
+
+/**
+ * @brief Czyści dziennik, gdy obie migawki obejmują wszystkie jego operacje
+ */
+void DataManager::releaseJournal() {
+	uint64_t last = Fjournal.sequence();
+	if (FtrainsSequence >= last && FticketsSequence >= last) Fjournal.reset();
+}
+
 /**
  * @brief Zapisuje wszystkich użytkowników do pliku YAML
  * 
@@ -37,218 +131,175 @@ std::string DataManager::trim(const std::string& str) {
  * type: ADMIN/PASSENGER
  * id: [numer]
  * login: [login]
- * password: [hasło]
+ * password: [pbkdf2-sha256$iteracje$sól$skrót]
+ * checksum: [CRC-32 pól rekordu]
  * 
- * @param users Wektor użytkowników do zapisania
+ * @param users Katalog użytkowników do zapisania
  */
-void DataManager::saveUsers(const std::vector<std::unique_ptr<User>>& users) {
-	std::ofstream file(FusersFile);
-	if (!file.is_open()) {
-		std::cerr << "Blad: Nie mozna otworzyc pliku " << FusersFile << " do zapisu" << std::endl;
-		return;
-	}
+void DataManager::saveUsers(const UserDirectory& users) {
+	std::string out;
+	std::ostringstream record;
 
 	// Zapisz każdego użytkownika w formacie YAML
 	for (const auto& user : users) {
-		file << "---\n";
-		file << "type: " << user->getType() << "\n";
-		file << "id: " << user->get_Fid() << "\n";
-		file << "login: " << user->get_Flogin() << "\n";
-		file << "password: " << user->get_Fpassword() << "\n";
+		record.str("");
+		record << "type: " << user->getType() << "\n";
+		record << "id: " << user->get_Fid() << "\n";
+		record << "login: " << user->get_Flogin() << "\n";
+		record << "password: " << user->get_Fpassword() << "\n";
+		appendRecord(out, record.str());
 	}
-	file.close();
-	std::cout << "Zapisano uzytkownikow do " << FusersFile << std::endl;
+	if (!DurableFile::writeAtomically(FusersFile, out)) return;
+	Flog << "Zapisano uzytkownikow do " << FusersFile << "\n";
 }
 
 /**
  * @brief Wczytuje użytkowników z pliku YAML
  * 
  * Parsuje plik YAML i tworzy obiekty Admin lub Passenger w zależności od typu.
- * Jeśli plik nie istnieje, zwraca pusty wektor (pierwsze uruchomienie)
+ * Hasła zapisane jawnym tekstem są zamieniane na solone skróty.
+ * Jeśli plik nie istnieje, katalog pozostaje pusty (pierwsze uruchomienie)
  * 
- * @param users Wektor, do którego zostaną wczytani użytkownicy
+ * @param users Katalog, do którego zostaną wczytani użytkownicy
  */
-void DataManager::loadUsers(std::vector<std::unique_ptr<User>>& users) {
-	std::ifstream file(FusersFile);
-	if (!file.is_open()) {
-		std::cout << "Plik " << FusersFile << " nie istnieje. Tworze nowy startowy." << std::endl;
-		return;
-	}
-
-	std::string line;
+void DataManager::loadUsers(UserDirectory& users) {
 	std::string type, login, password;
 	int id = 0;
-
-	// Parsowanie pliku YAML linia po linii
-	while (std::getline(file, line)) {
-		line = trim(line);
-		if (line == "---") {
-			// Separator - jeśli mamy zebrane dane, utwórz użytkownika
-			if (!login.empty()) {
-				if (type == "ADMIN") {
-					users.push_back(std::make_unique<Admin>(login, password, id));
-				}
-				else if (type == "PASSENGER") { 
-					users.push_back(std::make_unique<Passenger>(login, password, id));
-				}
-				login = ""; password = ""; type = ""; id = 0;
+	uint64_t sequence = 0;
+
+	// Zbiera pola rekordu
+	auto field = [&](const std::string& key, const std::string& value) {
+		if (key == "type") type = value;
+		else if (key == "id") id = std::stoi(value);
+		else if (key == "login") login = value;
+		else if (key == "password") password = value;
+	};
+
+	// Tworzy użytkownika z zebranych pól; hasło jawne zamieniane jest na skrót
+	auto flushUser = [&]() {
+		if (!login.empty()) {
+			if (!PasswordHasher::isHashed(password)) password = PasswordHasher::hash(password);
+
+			if (type == "ADMIN") {
+				users.add(std::make_unique<Admin>(std::move(login), std::move(password), id));
+			}
+			else if (type == "PASSENGER") {
+				users.add(std::make_unique<Passenger>(std::move(login), std::move(password), id));
 			}
-			continue; 
-		}
-
-		// Parsowanie pary klucz:wartość
-		size_t colonPos = line.find(":");
-		if (colonPos != std::string::npos) {
-			std::string key = trim(line.substr(0, colonPos));
-			std::string value = trim(line.substr(colonPos + 1));
-
-			if (key == "type") type = value;
-			else if (key == "id") id = std::stoi(value);
-			else if (key == "login") login = value;
-			else if (key == "password") password = value;
 		}
-	}
+		login = ""; password = ""; type = ""; id = 0;
+	};
 
-	// Utwórz ostatniego użytkownika jeśli dane są kompletne
-	if (!login.empty()) {
-		if (type == "ADMIN") users.push_back(std::make_unique<Admin>(login, password, id));
-		else if (type == "PASSENGER") users.push_back(std::make_unique<Passenger>(login, password, id));
+	if (!readRecords(FusersFile, sequence, field, flushUser)) {
+		Flog << "Plik " << FusersFile << " nie istnieje. Tworze nowy startowy.\n";
+		return;
 	}
-
-	file.close();
-	std::cout << "Wczytano " << users.size() << " uzytkownikow." << std::endl;
+	Flog << "Wczytano " << users.size() << " uzytkownikow.\n";
 }
 
 /**
  * @brief Zapisuje wszystkie pociągi do pliku YAML
  * 
- * Format YAML dla każdego pociągu:
+ * Plik zaczyna się nagłówkiem "# sequence: N" - numerem ostatniej operacji
+ * dziennika, którą obejmuje migawka. Format YAML dla każdego pociągu:
  * ---
  * id: [numer]
  * origin: [stacja początkowa]
  * destination: [stacja końcowa]
  * date: [data w formacie RRRR-MM-DD]
+ * departure: [godzina odjazdu GG:MM, opcjonalnie]
+ * arrival: [godzina przyjazdu GG:MM, opcjonalnie]
  * capacity: [liczba miejsc]
- * occupied: [lista numerów zajętych miejsc oddzielonych przecinkami]
+ * layout: [układ wagonów, np. 2:1x10x3,1:4x20x4]
+ * occupied: [zajęte miejsca - przedziały, np. 1-40,45, lub mapa bitowa x:<cyfry szesnastkowe>]
+ * checksum: [CRC-32 pól rekordu]
  * 
- * @param trains Wektor pociągów do zapisania
+ * @param trains Katalog pociągów do zapisania
  */
-void DataManager::saveTrains(const std::vector<Train>& trains) {
-	std::ofstream file(FtrainsFile);
-	if (!file.is_open()) {
-		std::cerr << "Blad: Nie mozna otworzyc pliku " << FtrainsFile << " do zapisu" << std::endl;
-		return;
-	}
+void DataManager::saveTrains(const TrainCatalog& trains) {
+	uint64_t sequence = Fjournal.sequence();
+	std::string out = "# sequence: " + std::to_string(sequence) + "\n";
+	std::ostringstream record;
 
 	// Zapisz każdy pociąg w formacie YAML
-	for (const auto& train : trains) {
-		file << "---\n";
-		file << "id: " << train.getID() << "\n";
-		file << "origin: " << train.getOrigin() << "\n";
-		file << "destination: " << train.getDestination() << "\n";
-		file << "date: " << train.getDate() << "\n";
-		file << "capacity: " << train.getCapacity() << "\n";
-
-		// Zapisz listę zajętych miejsc jako liczby oddzielone przecinkami
-		file << "occupied: ";
-
-		bool first = true;
-
-		for (auto i = 1; i <= train.getCapacity(); i++) {
-			if (!train.isSeatFree(i)) {
-				if (!first) file << ",";
-				file << i;
-				first = false;
-			}
-		}
-		file << "\n";
+	for (const Train* train : trains) {
+		record.str("");
+		record << "id: " << train->getID() << "\n";
+		record << "origin: " << train->getOrigin() << "\n";
+		record << "destination: " << train->getDestination() << "\n";
+		record << "date: " << train->getDate() << "\n";
+		if (train->getDeparture() != Train::NO_TIME) record << "departure: " << Train::formatTime(train->getDeparture()) << "\n";
+		if (train->getArrival() != Train::NO_TIME) record << "arrival: " << Train::formatTime(train->getArrival()) << "\n";
+		record << "capacity: " << train->getCapacity() << "\n";
+		record << "layout: " << train->getLayout().toString() << "\n";
+
+		// Zajęte miejsca - krótszy z zapisów: przedziały lub mapa bitowa (patrz Train::encodeSeats)
+		record << "occupied: " << train->encodeSeats() << "\n";
+		appendRecord(out, record.str());
 	}
-	file.close();
-	std::cout << "Zapisano pociagi do " << FtrainsFile << std::endl;
+	if (!DurableFile::writeAtomically(FtrainsFile, out)) return;
+	FtrainsSequence = sequence;
+	releaseJournal();
+	Flog << "Zapisano pociagi do " << FtrainsFile << "\n";
 }
 
 /**
  * @brief Wczytuje pociągi z pliku YAML
  * 
  * Parsuje plik YAML i odtwarza obiekty Train wraz z ich stanem zajętości miejsc.
- * Jeśli plik nie istnieje, zwraca pusty wektor
+ * Jeśli plik nie istnieje, katalog pozostaje pusty
  * 
- * @param trains Wektor, do którego zostaną wczytane pociągi
+ * @param trains Katalog, do którego zostaną wczytane pociągi
  */
-void DataManager::loadTrains(std::vector<Train>& trains) {
-	std::ifstream file(FtrainsFile);
-	if (!file.is_open()) {
-		std::cout << "Plik " << FtrainsFile << " nie istnieje. Stworzono nowy." << std::endl;
-		return;
-	}
-
-	std::string line;
+void DataManager::loadTrains(TrainCatalog& trains) {
 	int id = 0, capacity = 0;
-	std::string origin, destination, date, occupiedStr;
-
-
-	// Parsowanie pliku YAML linia po linii
-	while (std::getline(file, line)) {
-		line = trim(line);
-		if (line == "---") {
-			// Separator - jeśli mamy zebrane dane, utwórz pociąg
-			if (capacity > 0) {
-				Train t(id, origin, destination, date, capacity);
-
-				// Parsuj listę zajętych miejsc i zarezerwuj je
-				if (!occupiedStr.empty()) {
-					std::stringstream ss(occupiedStr);
-					std::string segment;
-					while (std::getline(ss, segment, ',')) {
-						try {
-							int seatNum = std::stoi(segment);
-							t.reserveSeat(seatNum);
-						} catch (...) {}
-					}
-				}
-				trains.push_back(t);
-
-				// Reset zmiennych dla następnego pociągu
-				id = 0; capacity = 0; origin = ""; destination = ""; date = ""; occupiedStr = "";
+	std::string origin, destination, date, layoutStr, occupiedStr;
+	uint16_t departure = Train::NO_TIME, arrival = Train::NO_TIME;
+
+	// Zbiera pola rekordu
+	auto field = [&](const std::string& key, const std::string& value) {
+		if (key == "id") id = std::stoi(value);
+		else if (key == "origin") origin = value;
+		else if (key == "destination") destination = value;
+		else if (key == "date") date = value;
+		else if (key == "departure") Train::parseTime(value, departure);
+		else if (key == "arrival") Train::parseTime(value, arrival);
+		else if (key == "capacity") capacity = std::stoi(value);
+		else if (key == "layout") layoutStr = value;
+		else if (key == "occupied") occupiedStr = value;
+	};
+
+	// Tworzy pociąg z zebranych pól
+	auto flushTrain = [&]() {
+		if (capacity > 0) {
+			// Pliki bez układu wagonów - jeden wagon drugiej klasy
+			SeatLayout layout;
+			if (layoutStr.empty() || !SeatLayout::parse(layoutStr, layout)) layout = SeatLayout::uniform(capacity);
+			Train* t = trains.add(id, origin, destination, date, layout);
+			if (t != nullptr && (departure != Train::NO_TIME || arrival != Train::NO_TIME)) trains.setTimes(*t, departure, arrival);
+
+			// Odtwórz zajętość miejsc bezpośrednio w mapie bitowej
+			if (t != nullptr && !occupiedStr.empty() && !t->decodeSeats(occupiedStr)) {
+				std::cerr << "Ostrzezenie: Niepoprawne zajete miejsca pociagu " << id << " (pominiete)" << std::endl;
 			}
-			continue;
 		}
 
-		// Parsowanie pary klucz:wartość
-		size_t colonPos = line.find(":");
-		if (colonPos != std::string::npos) {
-			std::string key = trim(line.substr(0, colonPos));
-			std::string value = trim(line.substr(colonPos + 1));
+		// Reset zmiennych dla następnego pociągu
+		id = 0; capacity = 0; origin = ""; destination = ""; date = ""; layoutStr = ""; occupiedStr = "";
+		departure = Train::NO_TIME; arrival = Train::NO_TIME;
+	};
 
-			if (key == "id") id = std::stoi(value);
-			else if (key == "origin") origin = value;
-			else if (key == "destination") destination = value;
-			else if (key == "date") date = value;
-			else if (key == "capacity") capacity = std::stoi(value);
-			else if (key == "occupied") occupiedStr = value;
-		}
-	}
-	
-	// Utwórz ostatni pociąg jeśli dane są kompletne
-	if (capacity > 0) {
-		Train t(id, origin, destination, date, capacity);
-		if (!occupiedStr.empty()) {
-			std::stringstream ss(occupiedStr);
-			std::string segment;
-			while (std::getline(ss, segment, ',')) {
-				try { t.reserveSeat(std::stoi(segment)); } catch(...) {}
-			}
-		}
-		trains.push_back(t);
+	if (!readRecords(FtrainsFile, FtrainsSequence, field, flushTrain)) {
+		Flog << "Plik " << FtrainsFile << " nie istnieje. Stworzono nowy.\n";
+		return;
 	}
-	file.close();
-	std::cout << "Wczytano " << trains.size() << "pociągów" << std::endl;
-
+	Flog << "Wczytano " << trains.size() << " pociagow\n";
 }
 
 /**
  * @brief Zapisuje wszystkie bilety do pliku YAML
  * 
+ * Plik zaczyna się nagłówkiem "# sequence: N" (jak w saveTrains).
  * Format YAML dla każdego biletu:
  * ---
  * id: [numer biletu]
@@ -256,60 +307,222 @@ void DataManager::loadTrains(std::vector<Train>& trains) {
  * passenger: [login pasażera]
  * seat: [numer miejsca]
  * price: [cena]
+ * checksum: [CRC-32 pól rekordu]
  * 
- * @param tickets Wektor biletów do zapisania
+ * @param tickets Magazyn biletów do zapisania
  */
-void DataManager::saveTickets(const std::vector<Ticket>& tickets) {
-	std::ofstream file(FticketsFile);
-	if (!file.is_open()) {
-		std::cerr << "Blad: Nie mozna otworzyc pliku " << FticketsFile << " do zapisu" << std::endl;
-	}
-
-	// Zapisz każdy bilet w formacie YAML
-	for (const auto& ticket : tickets) {
-		file << "---\n";
-		file << "id: " << ticket.getTicketId() << "\n";
-		file << "trainId: " << ticket.getTrainId() << "\n";
-		file << "passenger: " << ticket.getPassengerLogin() << "\n";
-		file << "seat: " << ticket.getSeatNumber() << "\n";
-		file << "price: " << ticket.getPrice() << "\n";
-	}
-	file.close();
-	std::cout << "Zapisano bilety do " << FticketsFile << std::endl;
+void DataManager::saveTickets(const TicketStore& tickets) {
+	uint64_t sequence = Fjournal.sequence();
+	std::string out = "# sequence: " + std::to_string(sequence) + "\n";
+	std::ostringstream record;
+
+	// Zapisz każdy żywy bilet w formacie YAML
+	tickets.forEachLive([&out, &record, &tickets](size_t row) {
+		record.str("");
+		record << "id: " << tickets.ticketId(row) << "\n";
+		record << "trainId: " << tickets.trainId(row) << "\n";
+		record << "passenger: " << StringPool::logins().get(tickets.passengerId(row)) << "\n";
+		record << "seat: " << tickets.seat(row) << "\n";
+		record << "price: " << tickets.price(row) << "\n";
+		appendRecord(out, record.str());
+	});
+	if (!DurableFile::writeAtomically(FticketsFile, out)) return;
+	FticketsSequence = sequence;
+	releaseJournal();
+	Flog << "Zapisano bilety do " << FticketsFile << "\n";
 }
 
 /**
  * @brief Wczytuje bilety z pliku YAML
  * 
- * Parsuje plik YAML i tworzy obiekty Ticket.
- * Jeśli plik nie istnieje, zwraca pusty wektor
+ * Parsuje plik YAML i dodaje bilety do magazynu.
+ * Jeśli plik nie istnieje, magazyn pozostaje pusty
  * 
- * @param tickets Wektor, do którego zostaną wczytane bilety
+ * @param tickets Magazyn, do którego zostaną wczytane bilety
+ */
+void DataManager::loadTickets(TicketStore& tickets) {
+	int id = 0, trainId = 0, seat = 0;
+	double price = 0.0;
+	std::string passengerLogin;
+
+	// Zbiera pola rekordu
+	auto field = [&](const std::string& key, const std::string& value) {
+		if (key == "id") id = std::stoi(value);
+		else if (key == "trainId") trainId = std::stoi(value);
+		else if (key == "passenger") passengerLogin = value;
+		else if (key == "seat") seat = std::stoi(value);
+		else if (key == "price") {
+			try {
+				price = std::stod(value);
+			}
+			catch (...) { price = 0.0; }
+		}
+	};
+
+	// Dodaje bilet z zebranych pól
+	auto flushTicket = [&]() {
+		if (id > 0 && !passengerLogin.empty() &&
+			!tickets.add(id, trainId, StringPool::logins().intern(passengerLogin), seat, price)) {
+			Flog << "Pominieto powtorzony bilet ID " << id << " w " << FticketsFile << "\n";
+		}
+
+		// Reset zmiennych dla następnego biletu
+		id = 0; trainId = 0; seat = 0; price = 0.0; passengerLogin = "";
+	};
+
+	if (!readRecords(FticketsFile, FticketsSequence, field, flushTicket)) {
+		Flog << "Plik " << FticketsFile << " nie istnieje, Stworzono nowy\n";
+		return;
+	}
+	Flog << "Wczytano " << tickets.size() << " biletow\n";
+}
+
+/**
+ * @brief Stosuje jedną operację dziennika do pociągów i biletów
+ * @param record Operacja
+ * @param trains Katalog pociągów (nullptr - zajętość miejsc bez zmian)
+ * @param tickets Magazyn biletów (nullptr - bilety bez zmian)
+ * @param log Strumień komunikatów o pominiętych operacjach
+ * @return Pociąg, którego mapa miejsc się zmieniła (lub nullptr)
+ */
+Train* DataManager::apply(const Journal::Record& record, TrainCatalog* trains, TicketStore* tickets, std::ostream& log) {
+	// Znacznik zmian w migawkach - wczytane migawki już je zawierają
+	if (record.Foperation == Journal::Operation::RELOAD) return nullptr;
+
+	Train* train = trains != nullptr ? trains->find(record.FtrainId) : nullptr;
+	uint32_t passengerId = StringPool::logins().intern(record.Fpassenger);
+	size_t row = tickets != nullptr ? tickets->findRow(record.FticketId, passengerId) : TicketStore::NPOS;
+
+	switch (record.Foperation) {
+	case Journal::Operation::BOOK:
+		// ID zajęte przez bilet innego pasażera - operacja pomijana (także miejsce)
+		if (tickets != nullptr && row == TicketStore::NPOS &&
+			!tickets->add(record.FticketId, record.FtrainId, passengerId, record.Fseat, record.Fprice)) {
+			log << "Pominieto rezerwacje z dziennika - bilet ID " << record.FticketId << " juz istnieje\n";
+			break;
+		}
+		if (train != nullptr) train->reserveSeat(record.Fseat);
+		break;
+	case Journal::Operation::CANCEL:
+		if (train != nullptr) train->cancelSeat(record.Fseat);
+		if (row != TicketStore::NPOS) tickets->remove(row);
+		break;
+	case Journal::Operation::MOVE:
+		if (train != nullptr) train->moveSeat(record.Fseat, record.FnewSeat);
+		if (row != TicketStore::NPOS) tickets->setSeat(row, record.FnewSeat);
+		break;
+	case Journal::Operation::RELOAD:
+		break;
+	}
+	if (trains != nullptr) trains->markChanged(record.FtrainId);
+	return train;
+}
+
+/**
+ * @brief Odtwarza operacje z dziennika nowsze niż migawki
+ *
+ * Zajętość miejsc odtwarzana jest dla operacji nowszych od migawki pociągów,
+ * bilety - dla operacji nowszych od migawki biletów (migawki mogą być
+ * zapisane w różnych chwilach, np. po dodaniu pociągu zapisywane są tylko pociągi).
+ * W trybie tylko do odczytu (replika) plik dziennika nie jest obcinany
+ * ani otwierany do zapisu.
+ *
+ * @param trains Katalog pociągów
+ * @param tickets Magazyn biletów
+ * @param readOnly Czy proces tylko czyta dane (replika)
+ * @return Numer ostatniej operacji odzwierciedlonej w danych
+ */
+uint64_t DataManager::recover(TrainCatalog& trains, TicketStore& tickets, bool readOnly) {
+	uint64_t checkpoint = std::max(FtrainsSequence, FticketsSequence);
+	std::vector<Journal::Record> records = readOnly ? Fjournal.read() : Fjournal.recover(checkpoint);
+
+	size_t replayed = 0;
+	for (const Journal::Record& record : records) {
+		bool applyTrains = record.Fsequence > FtrainsSequence;
+		bool applyTickets = record.Fsequence > FticketsSequence;
+		if ((!applyTrains && !applyTickets) || record.Foperation == Journal::Operation::RELOAD) continue;
+		replayed++;
+		apply(record, applyTrains ? &trains : nullptr, applyTickets ? &tickets : nullptr, Flog);
+	}
+	if (replayed > 0) Flog << "Odtworzono " << replayed << " operacji z dziennika " << FjournalFile << "\n";
+	return records.empty() ? checkpoint : std::max(checkpoint, records.back().Fsequence);
+}
+
+/**
+ * @brief Zwraca dziennik operacji
+ * @return Dziennik
+ */
+Journal& DataManager::journal() { return Fjournal; }
+
+/**
+ * @brief Zapisuje w dzienniku znacznik zmiany objętej tylko migawkami
+ *
+ * Dodanie, usunięcie i import pociągów, archiwizacja oraz nowe konta nie
+ * przechodzą przez dziennik - trafiają od razu do migawek. Znacznik RELOAD
+ * dopisany po ich zapisie dociera do replik w strumieniu dziennika (także
+ * po restarcie procesu głównego), a replika wczytuje wtedy migawki od nowa.
+ */
+void DataManager::announceSnapshots() {
+	Journal::Record record;
+	record.Foperation = Journal::Operation::RELOAD;
+	if (Fjournal.append(record) == 0) {
+		std::cerr << "Ostrzezenie: Repliki nie zostana powiadomione o zmianie migawek" << std::endl;
+	}
+}
+
+/**
+ * @brief Zapisuje migawki, gdy dziennik urósł ponad CHECKPOINT_RECORDS
+ *
+ * Zapis obu migawek czyści dziennik, więc czas odtwarzania po awarii
+ * pozostaje ograniczony.
+ *
+ * @param trains Katalog pociągów
+ * @param tickets Magazyn biletów
+ */
+void DataManager::checkpointIfDue(const TrainCatalog& trains, const TicketStore& tickets) {
+	if (Fjournal.size() < CHECKPOINT_RECORDS) return;
+	saveTrains(trains);
+	saveTickets(tickets);
+}
+
+/**
+ * @brief Wczytuje tabelę odległości z pliku YAML
+ *
+ * Format YAML dla każdej trasy (odległość obowiązuje w obu kierunkach):
+ * ---
+ * origin: [stacja początkowa]
+ * destination: [stacja końcowa]
+ * distance: [kilometry]
+ *
+ * @param pricing Cennik, do którego zostaną wczytane odległości
  */
-void DataManager::loadTickets(std::vector<Ticket>& tickets) {
-	std::ifstream file(FticketsFile);
+void DataManager::loadFares(PricingEngine& pricing) {
+	std::ifstream file(FfaresFile);
 	if (!file.is_open()) {
-		std::cout << "Plik " << FticketsFile << " nie istnieje, Stworzono nowy" << std::endl;
+		Flog << "Plik " << FfaresFile << " nie istnieje. Stosowany jest cennik domyslny.\n";
+		pricing.compile();
 		return;
 	}
 
 	std::string line;
-	int id = 0, trainId = 0, seat = 0;
-	double price = 0.0;
-	std::string passengerLogin;
+	std::string origin, destination;
+	double distance = 0.0;
+	int routes = 0;
+
+	// Dodaje trasę z zebranych pól
+	auto flushRoute = [&]() {
+		if (!origin.empty() && !destination.empty() && distance > 0.0) {
+			pricing.setDistance(origin, destination, distance);
+			routes++;
+		}
+		origin = ""; destination = ""; distance = 0.0;
+	};
 
 	// Parsowanie pliku YAML linia po linii
 	while (std::getline(file, line)) {
 		line = trim(line);
 		if (line == "---") {
-			// Separator - jeśli mamy zebrane dane, utwórz bilet
-			if (id > 0 && !passengerLogin.empty()) {
-				Ticket t(id, trainId, passengerLogin, seat, price);
-				tickets.push_back(t);
-
-				// Reset zmiennych dla następnego biletu
-				id = 0; trainId = 0; seat = 0; price = 0.0; passengerLogin = "";
-			}
+			flushRoute();
 			continue;
 		}
 
@@ -318,25 +531,19 @@ void DataManager::loadTickets(std::vector<Ticket>& tickets) {
 		if (colonPos != std::string::npos) {
 			std::string key = trim(line.substr(0, colonPos));
 			std::string value = trim(line.substr(colonPos + 1));
-			if (key == "id") id = std::stoi(value);
-			else if (key == "trainId") trainId = std::stoi(value);
-			else if (key == "passenger") passengerLogin = value;
-			else if (key == "seat") seat = std::stoi(value);
-			else if (key == "price") {
+			if (key == "origin") origin = value;
+			else if (key == "destination") destination = value;
+			else if (key == "distance") {
 				try {
-					price = std::stod(value);
+					distance = std::stod(value);
 				}
-				catch (...) { price = 0.0; }
+				catch (...) { distance = 0.0; }
 			}
 		}
 	}
-
-	// Utwórz ostatni bilet jeśli dane są kompletne
-	if (id > 0 && !passengerLogin.empty()) {
-		Ticket t(id, trainId, passengerLogin, seat, price);
-		tickets.push_back(t);
-	}
+	flushRoute();
 
 	file.close();
-	std::cout << "Wczytano " << tickets.size() << " biletow" << std::endl;
+	pricing.compile();
+	Flog << "Wczytano " << routes << " tras cennika\n";
 }
\ No newline at end of file
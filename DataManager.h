@@ -10,8 +10,15 @@
 #include "User.h"
 #include "Admin.h"
 #include "Passenger.h"
+#include "UserDirectory.h"
+#include "PricingEngine.h"
 #include "Train.h"
+#include "TrainCatalog.h"
 #include "Ticket.h"
+#include "TicketStore.h"
+#include "Journal.h"
+#include <cstdint>
+#include <iostream>
 
 /**
  * @class DataManager
@@ -22,7 +29,18 @@
  * - Zapisuje i wczytuje pociągi wraz ze stanem zajętości miejsc
  * - Zapisuje i wczytuje bilety
  * 
- * Dane przechowywane są w plikach YAML dla łatwej edycji i przeglądania
+ * Dane przechowywane są w plikach YAML dla łatwej edycji i przeglądania.
+ *
+ * Odporność na awarie:
+ * - każdy plik zapisywany jest atomowo (plik tymczasowy, fsync, rename - DurableFile),
+ * - każdy rekord kończy się polem checksum (CRC-32 pól rekordu); rekord
+ *   z błędną sumą jest przy wczytaniu pomijany (rekordy bez sumy - starsze
+ *   pliki - są przyjmowane),
+ * - rezerwacje, anulowania i zmiany miejsc trafiają na bieżąco do dziennika
+ *   (Journal); migawki pociągów i biletów zapisują w nagłówku numer ostatniej
+ *   objętej operacji, a recover() odtwarza tylko nowsze operacje,
+ * - zmiany zapisywane tylko w migawkach zostawiają w dzienniku znacznik
+ *   dla replik (announceSnapshots).
  */
 class DataManager
 {
@@ -30,6 +48,33 @@ private:
 	const std::string FusersFile = "users.yaml";      ///< Nazwa pliku z użytkownikami
 	const std::string FtrainsFile = "trains.yaml";    ///< Nazwa pliku z pociągami
 	const std::string FticketsFile = "tickets.yaml";  ///< Nazwa pliku z biletami
+	const std::string FfaresFile = "fares.yaml";      ///< Nazwa pliku z tabelą odległości
+	const std::string FjournalFile = "journal.log";   ///< Nazwa pliku dziennika operacji
+	std::ostream& Flog;             ///< Strumień komunikatów (replika - std::cerr, bo std::cout to jej odpowiedzi)
+
+	Journal Fjournal;               ///< Dziennik rezerwacji, anulowań i zmian miejsc
+	uint64_t FtrainsSequence;       ///< Ostatnia operacja dziennika objęta migawką pociągów
+	uint64_t FticketsSequence;      ///< Ostatnia operacja dziennika objęta migawką biletów
+
+	/**
+	 * @brief Wczytuje plik rekordów YAML, sprawdzając sumy kontrolne
+	 *
+	 * Dla każdego poprawnego rekordu wywołuje field(klucz, wartość) dla kolejnych
+	 * pól, a następnie flush(). Rekordy z błędną sumą kontrolną są pomijane.
+	 *
+	 * @param path Ścieżka do pliku
+	 * @param sequence Zmienna, do której zostanie zapisany numer z nagłówka "# sequence:" (0 - brak)
+	 * @param field Obsługa pola rekordu
+	 * @param flush Obsługa końca rekordu
+	 * @return false jeśli pliku nie udało się otworzyć
+	 */
+	template<typename Field, typename Flush>
+	bool readRecords(const std::string& path, uint64_t& sequence, Field field, Flush flush);
+
+	/**
+	 * @brief Czyści dziennik, jeśli obie migawki obejmują już wszystkie jego operacje
+	 */
+	void releaseJournal();
 
 	/**
 	 * @brief Usuwa białe znaki z początku i końca tekstu
@@ -39,51 +84,111 @@ private:
 	std::string trim(const std::string& str);
 
 public:
+	static constexpr size_t CHECKPOINT_RECORDS = 1000;   ///< Liczba operacji w dzienniku wymuszająca zapis migawek
+
 	/**
 	 * @brief Konstruktor klasy DataManager
+	 * @param log Strumień komunikatów o wczytaniu i zapisie plików
 	 */
-	DataManager();
+	explicit DataManager(std::ostream& log = std::cout);
 
 	/**
 	 * @brief Zapisuje wszystkich użytkowników do pliku YAML
-	 * @param users Wektor użytkowników do zapisania
+	 * @param users Katalog użytkowników do zapisania
 	 */
-	void saveUsers(const std::vector < std::unique_ptr<User>>& users);
+	void saveUsers(const UserDirectory& users);
 	
 	/**
 	 * @brief Wczytuje użytkowników z pliku YAML
-	 * @param users Wektor, do którego zostaną wczytani użytkownicy
+	 *
+	 * Hasła zapisane jawnym tekstem (starsze pliki) są od razu zamieniane
+	 * na solone skróty - trafią do pliku przy najbliższym zapisie.
+	 *
+	 * @param users Katalog, do którego zostaną wczytani użytkownicy
 	 */
-	void loadUsers(std::vector<std::unique_ptr<User>>& users);
+	void loadUsers(UserDirectory& users);
 
 	/**
 	 * @brief Zapisuje wszystkie pociągi do pliku YAML
 	 * 
 	 * Zapisuje pełną informację o pociągach wraz ze stanem zajętości miejsc
 	 * 
-	 * @param trains Wektor pociągów do zapisania
+	 * @param trains Katalog pociągów do zapisania
 	 */
-	void saveTrains(const std::vector<Train>& trains);
+	void saveTrains(const TrainCatalog& trains);
 	
 	/**
 	 * @brief Wczytuje pociągi z pliku YAML
 	 * 
 	 * Odtwarza pociągi wraz z ich stanem zajętości miejsc
 	 * 
-	 * @param trains Wektor, do którego zostaną wczytane pociągi
+	 * @param trains Katalog, do którego zostaną wczytane pociągi
 	 */
-	void loadTrains(std::vector<Train>& trains);
+	void loadTrains(TrainCatalog& trains);
 
 	/**
 	 * @brief Zapisuje wszystkie bilety do pliku YAML
-	 * @param tickets Wektor biletów do zapisania
+	 * @param tickets Magazyn biletów do zapisania
 	 */
-	void saveTickets(const std::vector<Ticket>& tickets);
+	void saveTickets(const TicketStore& tickets);
 	
 	/**
 	 * @brief Wczytuje bilety z pliku YAML
-	 * @param tickets Wektor, do którego zostaną wczytane bilety
+	 * @param tickets Magazyn, do którego zostaną wczytane bilety
+	 */
+	void loadTickets(TicketStore& tickets);
+
+	/**
+	 * @brief Wczytuje tabelę odległości do cennika i kompiluje ją
+	 *
+	 * Brak pliku nie jest błędem - wszystkie trasy wyceniane są wtedy
+	 * według wzoru domyślnego.
+	 *
+	 * @param pricing Cennik, do którego zostaną wczytane odległości
+	 */
+	void loadFares(PricingEngine& pricing);
+
+	/**
+	 * @brief Odtwarza operacje z dziennika nowsze niż wczytane migawki
+	 *
+	 * Wywoływane po loadTrains i loadTickets. Każda operacja stosowana jest
+	 * do pociągów i do biletów osobno - tylko tam, gdzie jest nowsza od migawki.
+	 *
+	 * @param trains Katalog pociągów
+	 * @param tickets Magazyn biletów
+	 * @param readOnly Czy proces tylko czyta dane (replika - dziennik nie jest obcinany ani otwierany do zapisu)
+	 * @return Numer ostatniej operacji odzwierciedlonej w danych
+	 */
+	uint64_t recover(TrainCatalog& trains, TicketStore& tickets, bool readOnly = false);
+
+	/**
+	 * @brief Stosuje jedną operację dziennika do pociągów i biletów
+	 * @param record Operacja
+	 * @param trains Katalog pociągów (nullptr - zajętość miejsc bez zmian; pociąg oznaczany jest jako zmieniony dla migawek)
+	 * @param tickets Magazyn biletów (nullptr - bilety bez zmian)
+	 * @param log Strumień komunikatów o pominiętych operacjach (replika - std::cerr)
+	 * @return Pociąg, którego mapa miejsc się zmieniła (lub nullptr)
+	 */
+	static Train* apply(const Journal::Record& record, TrainCatalog* trains, TicketStore* tickets, std::ostream& log);
+
+	/**
+	 * @brief Zwraca dziennik operacji (do podłączenia w BookingEngine)
+	 * @return Dziennik
+	 */
+	Journal& journal();
+
+	/**
+	 * @brief Zapisuje w dzienniku znacznik RELOAD po zapisie zmiany nieobjętej dziennikiem
+	 *
+	 * Wywoływane po zapisie dodanych, usuniętych, zaimportowanych lub zarchiwizowanych
+	 * pociągów i nowych kont - repliki po odebraniu znacznika wczytują migawki od nowa.
+	 */
+	void announceSnapshots();
+	/**
+	 * @brief Zapisuje migawki pociągów i biletów, gdy dziennik urósł ponad CHECKPOINT_RECORDS
+	 * @param trains Katalog pociągów
+	 * @param tickets Magazyn biletów
 	 */
-	void loadTickets(std::vector<Ticket>& tickets);
+	void checkpointIfDue(const TrainCatalog& trains, const TicketStore& tickets);
 };
 
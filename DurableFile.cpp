@@ -0,0 +1,116 @@
+/**
+ * @file DurableFile.cpp
+ * @brief Implementacja klasy DurableFile - plik tymczasowy, fsync, rename
+ */
+
+#include "DurableFile.h"
+#include <array>
+#include <filesystem>
+#include <iostream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Utrwala na dysku dane zapisane do otwartego pliku
+ * @param file Plik
+ * @return true jeśli dane trafiły na dysk
+ */
+bool DurableFile::sync(std::FILE* file) {
+	if (std::fflush(file) != 0) return false;
+#ifdef _WIN32
+	return _commit(_fileno(file)) == 0;
+#else
+	return fsync(fileno(file)) == 0;
+#endif
+}
+
+/**
+ * @brief Utrwala wpis katalogu po podmianie pliku (tylko POSIX)
+ * @param path Ścieżka do pliku w utrwalanym katalogu
+ */
+static void syncDirectory(const std::filesystem::path& path) {
+#ifndef _WIN32
+	std::filesystem::path directory = path.parent_path();
+	int fd = open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+	if (fd < 0) return;
+	fsync(fd);
+	close(fd);
+#else
+	(void)path;
+#endif
+}
+
+/**
+ * @brief Zapisuje zawartość pliku atomowo
+ *
+ * Kolejność: zapis do pliku .tmp, fsync, rename na plik docelowy, fsync katalogu.
+ * Przy błędzie plik docelowy pozostaje nietknięty.
+ *
+ * @param path Ścieżka do pliku docelowego
+ * @param content Pełna zawartość pliku
+ * @return true jeśli plik został zapisany i podmieniony
+ */
+bool DurableFile::writeAtomically(const std::string& path, std::string_view content) {
+	std::string temporary = path + ".tmp";
+	std::FILE* file = std::fopen(temporary.c_str(), "wb");
+	if (file == nullptr) {
+		std::cerr << "Blad: Nie mozna otworzyc pliku " << temporary << " do zapisu" << std::endl;
+		return false;
+	}
+
+	bool written = std::fwrite(content.data(), 1, content.size(), file) == content.size() && sync(file);
+	written = std::fclose(file) == 0 && written;
+	if (!written) {
+		std::cerr << "Blad: Zapis pliku " << temporary << " nie powiodl sie" << std::endl;
+		std::remove(temporary.c_str());
+		return false;
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporary, path, error);
+	if (error) {
+		std::cerr << "Blad: Nie mozna podmienic pliku " << path << std::endl;
+		return false;
+	}
+	syncDirectory(path);
+	return true;
+}
+
+/**
+ * @brief Oblicza sumę kontrolną CRC-32 (tablica 256 wpisów liczona raz)
+ * @param data Dane
+ * @param crc Suma poprzedniego fragmentu
+ * @return Suma kontrolna
+ */
+uint32_t DurableFile::crc32(std::string_view data, uint32_t crc) {
+	static const std::array<uint32_t, 256> table = [] {
+		std::array<uint32_t, 256> result{};
+		for (uint32_t i = 0; i < 256; i++) {
+			uint32_t value = i;
+			for (int bit = 0; bit < 8; bit++) value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+			result[i] = value;
+		}
+		return result;
+	}();
+
+	crc = ~crc;
+	for (unsigned char c : data) crc = table[(crc ^ c) & 0xFF] ^ (crc >> 8);
+	return ~crc;
+}
+
+/**
+ * @brief Zapisuje sumę kontrolną jako 8 cyfr szesnastkowych
+ * @param crc Suma kontrolna
+ * @return Napis
+ */
+std::string DurableFile::formatCrc(uint32_t crc) {
+	static constexpr char HEX[] = "0123456789abcdef";
+	std::string text(8, '0');
+	for (int i = 7; i >= 0; i--, crc >>= 4) text[i] = HEX[crc & 0xF];
+	return text;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file DurableFile.h
+ * @brief Deklaracja klasy DurableFile - trwały zapis plików i sumy kontrolne
+ */
+
+#pragma once
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @class DurableFile
+ * @brief Zapis plików odporny na przerwanie programu (np. kill -9 lub awarię zasilania)
+ *
+ * Plik zapisywany jest obok docelowego (".tmp"), utrwalany na dysku (fsync),
+ * a dopiero potem podmieniany jedną operacją rename. Po awarii na dysku
+ * zostaje więc albo cały stary, albo cały nowy plik - nigdy plik ucięty.
+ */
+class DurableFile
+{
+public:
+	/**
+	 * @brief Zapisuje zawartość pliku atomowo (plik tymczasowy, fsync, rename)
+	 * @param path Ścieżka do pliku docelowego
+	 * @param content Pełna zawartość pliku
+	 * @return true jeśli plik został zapisany i podmieniony
+	 */
+	static bool writeAtomically(const std::string& path, std::string_view content);
+
+	/**
+	 * @brief Utrwala na dysku dane zapisane do otwartego pliku (fflush + fsync)
+	 * @param file Plik
+	 * @return true jeśli dane trafiły na dysk
+	 */
+	static bool sync(std::FILE* file);
+
+	/**
+	 * @brief Oblicza sumę kontrolną CRC-32 (wielomian IEEE, jak w zlib)
+	 * @param data Dane
+	 * @param crc Suma poprzedniego fragmentu (przy liczeniu w częściach)
+	 * @return Suma kontrolna
+	 */
+	static uint32_t crc32(std::string_view data, uint32_t crc = 0);
+
+	/**
+	 * @brief Zapisuje sumę kontrolną jako 8 cyfr szesnastkowych
+	 * @param crc Suma kontrolna
+	 * @return Napis, np. "0a1b2c3d"
+	 */
+	static std::string formatCrc(uint32_t crc);
+};
@@ -0,0 +1,119 @@
+/**
+ * @file IdAllocator.cpp
+ * @brief Implementacja klasy IdAllocator - dzierżawa bloków i trwały high-water mark
+ */
+
+#include "IdAllocator.h"
+#include "DurableFile.h"
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <utility>
+
+/**
+ * @brief Lokalna dla wątku dzierżawa bloku identyfikatorów
+ */
+struct IdLease {
+	uint64_t Fowner = 0;   ///< Numer instancji generatora, do której należy dzierżawa
+	int Fnext = 0;         ///< Następny numer do wydania
+	int Fend = 0;          ///< Numer za ostatnim numerem bloku
+};
+
+static thread_local IdLease tlsLease;
+static std::atomic<uint64_t> allocatorSerials{ 0 };
+
+/**
+ * @brief Konstruktor klasy IdAllocator
+ * @param file Plik z high-water mark
+ */
+IdAllocator::IdAllocator(std::string file)
+	: Ffile(std::move(file)), FnextBlock(1), Fpersisted(1), Fserial(++allocatorSerials) {}
+
+/**
+ * @brief Odtwarza stan generatora z pliku i migawki danych
+ *
+ * Plik ma postać YAML z jednym kluczem: "high_water: N".
+ *
+ * @param minimumNext Najmniejszy dopuszczalny następny numer
+ */
+void IdAllocator::recover(int minimumNext) {
+	int stored = 1;
+	std::ifstream file(Ffile);
+	std::string line;
+	while (std::getline(file, line)) {
+		size_t colonPos = line.find(':');
+		if (colonPos != std::string::npos && line.compare(0, colonPos, "high_water") == 0) {
+			try { stored = std::stoi(line.substr(colonPos + 1)); } catch (...) {}
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(FpersistMutex);
+	int start = std::max({ stored, minimumNext, 1 });
+	FnextBlock.store(start);
+	Fpersisted = start;
+	tlsLease = IdLease{};
+}
+
+/**
+ * @brief Zapisuje high-water mark do pliku
+ *
+ * Zapis odbywa się do pliku tymczasowego, który po utrwaleniu na dysku zastępuje
+ * właściwy plik, więc przerwany zapis nie niszczy poprzedniej wartości.
+ *
+ * @param value Wartość do zapisania
+ */
+void IdAllocator::persist(int value) {
+	if (!DurableFile::writeAtomically(Ffile, "high_water: " + std::to_string(value) + "\n")) {
+		std::cerr << "Blad: Nie mozna zapisac pliku " << Ffile << std::endl;
+	}
+}
+
+/**
+ * @brief Dzierżawi nowy blok numerów
+ *
+ * Ścieżka szybka to jedna operacja fetch_add. Blokada zakładana jest tylko wtedy,
+ * gdy blok wykracza poza zapisany high-water mark - wtedy rezerwacja na dysku
+ * przesuwana jest od razu o PERSIST_AHEAD numerów.
+ *
+ * @param begin Pierwszy numer bloku
+ * @param end Numer za ostatnim numerem bloku
+ */
+void IdAllocator::leaseBlock(int& begin, int& end) {
+	begin = FnextBlock.fetch_add(BLOCK_SIZE);
+	end = begin + BLOCK_SIZE;
+
+	std::lock_guard<std::mutex> lock(FpersistMutex);
+	if (end > Fpersisted) {
+		Fpersisted = end + PERSIST_AHEAD;
+		persist(Fpersisted);
+	}
+}
+
+/**
+ * @brief Wydaje kolejny unikalny identyfikator
+ *
+ * Numery wydawane są z bloku dzierżawionego przez bieżący wątek;
+ * nowy blok pobierany jest dopiero po wyczerpaniu poprzedniego.
+ *
+ * @return Nowy identyfikator
+ */
+int IdAllocator::next() {
+	IdLease& lease = tlsLease;
+	if (lease.Fowner != Fserial || lease.Fnext >= lease.Fend) {
+		lease.Fowner = Fserial;
+		leaseBlock(lease.Fnext, lease.Fend);
+	}
+	return lease.Fnext++;
+}
+
+/**
+ * @brief Zapisuje dokładny koniec wydanych bloków
+ *
+ * Numery z niewykorzystanej części bloków nie zostaną już wydane, więc bezpiecznie
+ * jest zapisać początek następnego bloku jako nowy high-water mark.
+ */
+void IdAllocator::checkpoint() {
+	std::lock_guard<std::mutex> lock(FpersistMutex);
+	Fpersisted = FnextBlock.load();
+	persist(Fpersisted);
+}
@@ -0,0 +1,84 @@
+/**
+ * @file IdAllocator.h
+ * @brief Deklaracja klasy IdAllocator - monotoniczny generator identyfikatorów
+ */
+
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <cstdint>
+
+/**
+ * @class IdAllocator
+ * @brief Generator unikalnych, rosnących identyfikatorów (np. biletów)
+ *
+ * Identyfikatory wydawane są z bloków dzierżawionych przez każdy wątek osobno:
+ * wątek pobiera blok BLOCK_SIZE kolejnych numerów jedną operacją atomową,
+ * a potem wydaje je lokalnie, bez żadnej synchronizacji.
+ *
+ * Najwyższy zarezerwowany numer (high-water mark) zapisywany jest do pliku,
+ * zanim jakikolwiek numer z nowego zakresu zostanie wydany. Po restarcie
+ * (również po awarii) numeracja zaczyna się od zapisanej wartości, więc
+ * identyfikatory nigdy się nie powtarzają - co najwyżej powstają luki.
+ */
+class IdAllocator
+{
+public:
+	static constexpr int BLOCK_SIZE = 64;           ///< Liczba numerów w bloku dzierżawionym przez wątek
+	static constexpr int PERSIST_AHEAD = 1024;      ///< O ile numerów do przodu rezerwowany jest zapis na dysku
+
+private:
+	std::string Ffile;                    ///< Plik z zapisanym high-water mark
+	std::atomic<int> FnextBlock;          ///< Początek następnego wolnego bloku
+	int Fpersisted;                       ///< Wartość zapisana w pliku (numery < Fpersisted są zarezerwowane)
+	std::mutex FpersistMutex;             ///< Chroni zapis pliku (tylko przy dzierżawie bloku)
+	uint64_t Fserial;                     ///< Unikalny numer instancji (rozróżnia dzierżawy wątków)
+
+	/**
+	 * @brief Zapisuje wartość high-water mark do pliku
+	 * @param value Wartość do zapisania
+	 */
+	void persist(int value);
+
+	/**
+	 * @brief Dzierżawi nowy blok numerów
+	 * @param begin Zmienna, do której zostanie zapisany pierwszy numer bloku
+	 * @param end Zmienna, do której zostanie zapisany numer za ostatnim numerem bloku
+	 */
+	void leaseBlock(int& begin, int& end);
+
+public:
+	/**
+	 * @brief Konstruktor klasy IdAllocator
+	 * @param file Plik, w którym przechowywany jest high-water mark
+	 */
+	explicit IdAllocator(std::string file);
+
+	IdAllocator(const IdAllocator&) = delete;
+	IdAllocator& operator=(const IdAllocator&) = delete;
+
+	/**
+	 * @brief Odtwarza stan generatora po uruchomieniu programu
+	 *
+	 * Następny numer to większa z wartości: zapisany high-water mark
+	 * lub minimumNext (np. najwyższe ID biletu w migawce + 1).
+	 *
+	 * @param minimumNext Najmniejszy dopuszczalny następny numer
+	 */
+	void recover(int minimumNext);
+
+	/**
+	 * @brief Wydaje kolejny unikalny identyfikator
+	 * @return Nowy identyfikator
+	 */
+	int next();
+
+	/**
+	 * @brief Zapisuje dokładny koniec wydanych bloków (przy poprawnym zamknięciu programu)
+	 *
+	 * Zmniejsza lukę w numeracji po restarcie z PERSIST_AHEAD do co najwyżej BLOCK_SIZE.
+	 * Wolno wywołać tylko, gdy żaden inny wątek nie wydaje już numerów.
+	 */
+	void checkpoint();
+};
@@ -4,69 +4,115 @@
  */
 
 #include "InputValidation.h"
-#include <iostream>
-#include <limits>
+#include "Train.h"
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <cctype>
 
  /**
-  * @brief Wczytuje liczbę całkowitą od użytkownika z powtarzaniem próby aż do poprawnego wprowadzenia.
+  * @brief Pobiera liczbę z linii tak jak operator >> strumienia
   *
-  * @param prompt Komunikat do wyświetlenia użytkownikowi.
-  * @param value Referencja do zmiennej, w której zostanie zapisana wczytana liczba.
-  * @return true Po poprawnym wczytaniu liczby całkowitej.
+  * Białe znaki na początku są pomijane, a tekst za liczbą ignorowany
+  * (jak std::cin >> value z odrzuceniem reszty linii). Liczba zamieniana jest
+  * przez std::from_chars - bez lokalizacji i bez tworzenia strumienia; różnice
+  * względem operatora >> (znak '+', "inf"/"nan", niepełny wykładnik) są
+  * obsługiwane tak samo jak przez strumień.
+  *
+  * @param line Linia wejścia.
+  * @param value Zmienna, do której zostanie zapisana liczba.
+  * @return true Jeśli linia zaczyna się od liczby mieszczącej się w typie.
   */
-bool readInt(const std::string& prompt, int& value) {
-    while (true) {
-        std::cout << prompt;
-        if (std::cin >> value) {
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            return true;
-        }
-        else {
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            std::cout << "Nieprawidlowy format. Sprobuj ponownie.\n";
+template <typename T>
+static bool parseLeading(std::string_view line, T& value) {
+    size_t start = line.find_first_not_of(" \t\r\f\v");
+    if (start == std::string_view::npos) return false;
+    line.remove_prefix(start);
+    if (line.size() > 1 && line[0] == '+' && line[1] != '-') line.remove_prefix(1);
+
+    const char* end = line.data() + line.size();
+    if constexpr (std::is_floating_point_v<T>) {
+        // Strumień czyta tylko cyfry, '.', wykładnik i znak - bez "inf" i "nan"
+        size_t digits = line.empty() || line[0] != '-' ? 0 : 1;
+        if (digits >= line.size() || (!std::isdigit(static_cast<unsigned char>(line[digits])) && line[digits] != '.')) return false;
+        auto result = std::from_chars(line.data(), end, value, std::chars_format::general);
+        // "1e" lub "1e+" - strumień odrzuca liczbę z niepełnym wykładnikiem
+        std::string_view number(line.data(), static_cast<size_t>(result.ptr - line.data()));
+        if (number.find_first_of("eE") == std::string_view::npos && result.ptr != end && (*result.ptr == 'e' || *result.ptr == 'E')) return false;
+        // Poza zakresem strumień (przez strtod) przyjmuje niedomiar, a odrzuca nadmiar
+        if (result.ec == std::errc::result_out_of_range) {
+            value = std::strtod(std::string(number).c_str(), nullptr);
+            return std::isfinite(value);
         }
+        return result.ec == std::errc();
+    }
+    else {
+        auto result = std::from_chars(line.data(), end, value);
+        return result.ec == std::errc();
+    }
+}
+
+/**
+ * @brief Wczytuje pierwszą niepustą linię (operator >> pomija puste linie bez ponownego komunikatu)
+ *
+ * @param io Kanał sesji.
+ * @return Linia zawierająca co najmniej jeden znak inny niż biały.
+ */
+static Task<std::string> nextNonBlankLine(SessionIO& io) {
+    std::string line = co_await io.nextLine();
+    while (line.find_first_not_of(" \t\r\f\v") == std::string::npos) line = co_await io.nextLine();
+    co_return line;
+}
+
+/**
+ * @brief Wczytuje liczbę całkowitą od użytkownika z powtarzaniem próby aż do poprawnego wprowadzenia.
+ *
+ * @param io Kanał sesji.
+ * @param prompt Komunikat do wyświetlenia użytkownikowi.
+ * @return Wczytana liczba całkowita.
+ */
+Task<int> readInt(SessionIO& io, const std::string& prompt) {
+    while (true) {
+        io.out() << prompt;
+        int value;
+        if (parseLeading(co_await nextNonBlankLine(io), value)) co_return value;
+        io.out() << "Nieprawidlowy format. Sprobuj ponownie.\n";
     }
 }
 
 /**
  * @brief Wczytuje liczbę zmiennoprzecinkową od użytkownika z powtarzaniem próby aż do poprawnego wprowadzenia.
  *
+ * @param io Kanał sesji.
  * @param prompt Komunikat do wyświetlenia użytkownikowi.
- * @param value Referencja do zmiennej, w której zostanie zapisana wczytana liczba.
- * @return true Po poprawnym wczytaniu liczby zmiennoprzecinkowej.
+ * @return Wczytana liczba zmiennoprzecinkowa.
  */
-bool readDouble(const std::string& prompt, double& value) {
+Task<double> readDouble(SessionIO& io, const std::string& prompt) {
     while (true) {
-        std::cout << prompt;
-        if (std::cin >> value) {
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            return true;
-        }
-        else {
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            std::cout << "Nieprawidlowy format. Sprobuj ponownie.\n";
-        }
+        io.out() << prompt;
+        double value;
+        if (parseLeading(co_await nextNonBlankLine(io), value)) co_return value;
+        io.out() << "Nieprawidlowy format. Sprobuj ponownie.\n";
     }
 }
 
 /**
  * @brief Wczytuje linię tekstu od użytkownika po wyświetleniu podanego komunikatu.
  *
+ * Pusta linia na początku (pozostałość po poprzedniej odpowiedzi) jest pomijana.
+ *
+ * @param io Kanał sesji.
  * @param prompt Komunikat do wyświetlenia użytkownikowi.
- * @param line Referencja do zmiennej, w której zostanie zapisana wczytana linia.
- * @return true Zawsze zwraca true (brak walidacji na tym etapie).
+ * @return Wczytana linia (bez walidacji na tym etapie).
  */
-bool readLine(const std::string& prompt, std::string& line) {
-    std::cout << prompt;
-    if (std::cin.peek() == '\n') {
-        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    }
-    std::getline(std::cin, line);
-    return true;
+Task<std::string> readLine(SessionIO& io, const std::string& prompt) {
+    io.out() << prompt;
+    std::string line = co_await io.nextLine();
+    if (line.empty()) line = co_await io.nextLine();
+    co_return line;
 }
 
 /**
@@ -88,39 +134,30 @@ bool validateName(const std::string& input) {
 }
 
 /**
- * @brief Waliduje, czy podany tekst jest poprawnym formatem czasu (cyfry i znak ':').
+ * @brief Waliduje, czy podany tekst jest poprawną godziną w formacie GG:MM (00:00-23:59).
  *
  * @param input Tekst do walidacji.
- * @return true Jeśli tekst zawiera tylko cyfry i dwukropki.
+ * @return true Jeśli tekst jest poprawną godziną.
  * @return false W przeciwnym wypadku.
  */
 bool validateTime(const std::string& input) {
-    if (input.empty()) return false;
-    for (char c : input) {
-        if (!std::isdigit(static_cast<unsigned char>(c)) && c != ':') {
-            return false;
-        }
-    }
-    return true;
+    uint16_t minutes;
+    return Train::parseTime(input, minutes);
 }
 
 /**
  * @brief Wczytuje linię tekstu i waliduje ją za pomocą podanej funkcji walidującej.
  * Powtarza wczytywanie aż do momentu, gdy walidacja przejdzie pomyślnie.
  *
+ * @param io Kanał sesji.
  * @param prompt Komunikat do wyświetlenia użytkownikowi.
- * @param line Referencja do zmiennej, w której zostanie zapisana wczytana linia.
  * @param validator Wskaźnik na funkcję walidującą tekst.
- * @return true Po pomyślnej walidacji.
+ * @return Pierwsza poprawna linia.
  */
-bool readValidatedLine(const std::string& prompt, std::string& line, bool (*validator)(const std::string&)) {
-    do {
-        readLine(prompt, line);
-        if (!validator(line)) {
-            std::cout << "Niepoprawny format. Sprobuj ponownie.\n";
-        }
-        else {
-            return true;
-        }
-    } while (true);
+Task<std::string> readValidatedLine(SessionIO& io, const std::string& prompt, bool (*validator)(const std::string&)) {
+    while (true) {
+        std::string line = co_await readLine(io, prompt);
+        if (validator(line)) co_return line;
+        io.out() << "Niepoprawny format. Sprobuj ponownie.\n";
+    }
 }
@@ -5,37 +5,38 @@
 
 
 #pragma once
+#include "Task.h"
+#include "SessionIO.h"
 #include <string>
 
  /**
-  * @brief Wczytuje liczbę całkowitą od użytkownika po wyświetleniu podanego komunikatu.
+  * @brief Wczytuje liczbę całkowitą od użytkownika sesji po wyświetleniu podanego komunikatu.
   *
+  * Korutyna zawiesza się do nadejścia linii; przy niepoprawnym formacie pyta ponownie.
+  *
+  * @param io Kanał sesji.
   * @param prompt Komunikat do wyświetlenia użytkownikowi.
-  * @param value Zmienna, do której zostanie zapisana wczytana liczba całkowita.
-  * @return true Jeśli wczytanie powiodło się.
-  * @return false Jeśli wczytanie nie powiodło się (np. niepoprawny format).
+  * @return Wczytana liczba całkowita.
   */
-bool readInt(const std::string& prompt, int& value);
+Task<int> readInt(SessionIO& io, const std::string& prompt);
 
 /**
- * @brief Wczytuje liczbę zmiennoprzecinkową (double) od użytkownika po wyświetleniu podanego komunikatu.
+ * @brief Wczytuje liczbę zmiennoprzecinkową (double) od użytkownika sesji po wyświetleniu podanego komunikatu.
  *
+ * @param io Kanał sesji.
  * @param prompt Komunikat do wyświetlenia użytkownikowi.
- * @param value Zmienna, do której zostanie zapisana wczytana liczba zmiennoprzecinkowa.
- * @return true Jeśli wczytanie powiodło się.
- * @return false Jeśli wczytanie nie powiodło się.
+ * @return Wczytana liczba zmiennoprzecinkowa.
  */
-bool readDouble(const std::string& prompt, double& value);
+Task<double> readDouble(SessionIO& io, const std::string& prompt);
 
 /**
- * @brief Wczytuje linię tekstu od użytkownika po wyświetleniu podanego komunikatu.
+ * @brief Wczytuje linię tekstu od użytkownika sesji po wyświetleniu podanego komunikatu.
  *
+ * @param io Kanał sesji.
  * @param prompt Komunikat do wyświetlenia użytkownikowi.
- * @param line Zmienna, do której zostanie zapisana wczytana linia tekstu.
- * @return true Jeśli wczytanie powiodło się.
- * @return false Jeśli wczytanie nie powiodło się.
+ * @return Wczytana linia tekstu.
  */
-bool readLine(const std::string& prompt, std::string& line);
+Task<std::string> readLine(SessionIO& io, const std::string& prompt);
 
 /**
  * @brief Sprawdza, czy podany tekst reprezentuje poprawny czas (format i zakres).
@@ -56,12 +57,11 @@ bool validateTime(const std::string& input);
 bool validateName(const std::string& input);
 
 /**
- * @brief Wczytuje linię tekstu od użytkownika po wyświetleniu podanego komunikatu i waliduje ją podaną funkcją walidującą.
+ * @brief Wczytuje linię tekstu od użytkownika sesji po wyświetleniu podanego komunikatu i waliduje ją podaną funkcją walidującą.
  *
+ * @param io Kanał sesji.
  * @param prompt Komunikat do wyświetlenia użytkownikowi.
- * @param line Zmienna, do której zostanie zapisana wczytana linia tekstu.
  * @param validator Wskaźnik na funkcję walidującą, która sprawdza poprawność wczytanego tekstu.
- * @return true Jeśli wczytanie i walidacja powiodły się.
- * @return false W przeciwnym razie.
+ * @return Pierwsza linia, która przeszła walidację.
  */
-bool readValidatedLine(const std::string& prompt, std::string& line, bool (*validator)(const std::string&));
+Task<std::string> readValidatedLine(SessionIO& io, const std::string& prompt, bool (*validator)(const std::string&));
@@ -0,0 +1,284 @@
+/**
+ * @file Journal.cpp
+ * @brief Implementacja klasy Journal - dopisywanie z fsync i odtwarzanie ogona
+ */
+
+#include "Journal.h"
+#include "DurableFile.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/**
+ * @brief Konstruktor klasy Journal
+ * @param path Ścieżka do pliku dziennika
+ */
+Journal::Journal(std::string path) : Fpath(std::move(path)), Ffile(nullptr), Fsequence(0), Frecords(0), Fbytes(0) {}
+
+/**
+ * @brief Destruktor - zamyka plik dziennika
+ */
+Journal::~Journal() {
+	if (Ffile != nullptr) std::fclose(Ffile);
+}
+
+/**
+ * @brief Parsuje linię dziennika i sprawdza jej sumę kontrolną
+ * @param line Linia bez znaku końca linii
+ * @param record Zmienna, do której zostanie zapisana operacja
+ * @param continued Zmienna, do której zostanie zapisane, czy transakcja ma kolejne linie
+ * @return false jeśli linia jest uszkodzona
+ */
+bool Journal::parse(const std::string& line, Record& record, bool& continued) {
+	// Suma kontrolna obejmuje wszystko za pierwszą spacją
+	if (line.size() < 10 || line[8] != ' ') return false;
+	std::string_view body = std::string_view(line).substr(9);
+	if (DurableFile::formatCrc(DurableFile::crc32(body)) != std::string_view(line).substr(0, 8)) return false;
+
+	std::istringstream fields{ std::string(body) };
+	char operation = 0;
+	std::string price;
+	fields >> record.Fsequence >> operation >> record.FticketId >> record.FtrainId >> record.Fseat >> record.FnewSeat >> price;
+	if (!fields) return false;
+	fields.get();
+	std::getline(fields, record.Fpassenger);
+
+	auto result = std::from_chars(price.data(), price.data() + price.size(), record.Fprice);
+	if (result.ec != std::errc()) return false;
+
+	continued = std::islower(static_cast<unsigned char>(operation)) != 0;
+	record.Foperation = static_cast<Operation>(std::toupper(static_cast<unsigned char>(operation)));
+	return record.Foperation == Operation::BOOK || record.Foperation == Operation::CANCEL ||
+		record.Foperation == Operation::MOVE || record.Foperation == Operation::RELOAD;
+}
+
+/**
+ * @brief Przegląda plik dziennika - tylko kompletne, poprawne transakcje
+ * @param records Zmienna, do której zostaną dopisane operacje o numerach większych niż after
+ * @param lines Zmienna, do której zostaną dopisane surowe linie tych operacji (nullptr - bez linii)
+ * @param after Numer operacji, od którego zbierane są wyniki
+ * @return Liczba bajtów poprawnej części pliku
+ */
+size_t Journal::scan(std::vector<Record>& records, std::string* lines, uint64_t after) const {
+	std::vector<Record> group;
+	std::string groupLines;
+	uint64_t previous = 0;
+	size_t validBytes = 0, groupBytes = 0;
+
+	std::ifstream file(Fpath, std::ios::binary);
+	std::string line;
+	while (file.is_open() && std::getline(file, line)) {
+		Record record;
+		bool continued = false;
+		if (file.eof() || !parse(line, record, continued) || record.Fsequence <= previous) break;
+		previous = record.Fsequence;
+		groupBytes += line.size() + 1;
+		if (record.Fsequence > after) {
+			group.push_back(std::move(record));
+			if (lines != nullptr) groupLines += line + '\n';
+		}
+		if (continued) continue;
+
+		// Ostatnia linia transakcji - cała grupa jest kompletna
+		validBytes += groupBytes;
+		groupBytes = 0;
+		for (Record& complete : group) records.push_back(std::move(complete));
+		group.clear();
+		if (lines != nullptr) *lines += groupLines;
+		groupLines.clear();
+	}
+	return validBytes;
+}
+
+/**
+ * @brief Odczytuje dziennik i otwiera go do dopisywania
+ *
+ * Odczyt kończy się na pierwszej uszkodzonej linii lub linii bez znaku
+ * końca (zapis przerwany w trakcie) - od tego miejsca plik jest obcinany.
+ * Niedokończona transakcja (brak jej ostatniej linii) jest obcinana w całości.
+ *
+ * @param checkpoint Najwyższy numer operacji objęty migawkami
+ * @return Poprawne operacje z pliku
+ */
+std::vector<Journal::Record> Journal::recover(uint64_t checkpoint) {
+	std::lock_guard<std::mutex> lock(Fmutex);
+	std::vector<Record> records;
+	size_t validBytes = scan(records, nullptr, 0);
+
+	std::error_code error;
+	if (std::filesystem::exists(Fpath, error) && std::filesystem::file_size(Fpath, error) > validBytes) {
+		std::cout << "Dziennik " << Fpath << ": obcieto uszkodzony ogon (przerwany zapis).\n";
+		std::filesystem::resize_file(Fpath, validBytes, error);
+	}
+
+	if (Ffile != nullptr) std::fclose(Ffile);
+	Ffile = std::fopen(Fpath.c_str(), "ab");
+	if (Ffile == nullptr) std::cerr << "Blad: Nie mozna otworzyc dziennika " << Fpath << std::endl;
+	Fsequence = records.empty() ? checkpoint : std::max(checkpoint, records.back().Fsequence);
+	Frecords = records.size();
+	Fbytes = validBytes;
+	return records;
+}
+
+/**
+ * @brief Odczytuje dziennik bez modyfikowania pliku (proces tylko do odczytu)
+ * @return Poprawne operacje z pliku
+ */
+std::vector<Journal::Record> Journal::read() const {
+	std::lock_guard<std::mutex> lock(Fmutex);
+	std::vector<Record> records;
+	scan(records, nullptr, 0);
+	return records;
+}
+
+/**
+ * @brief Przekazuje operacje nowsze niż since i dalsze zapisy nowemu odbiorcy
+ *
+ * Odczyt pliku i wywołanie deliver odbywają się pod blokadą dziennika,
+ * więc żaden zapis nie trafi pomiędzy zaległe operacje a kolejne
+ * powiadomienia słuchacza.
+ *
+ * @param since Ostatnia operacja znana odbiorcy
+ * @param deliver Wywoływane jako deliver(linie, numer ostatniej operacji)
+ * @return false jeśli dziennik nie zawiera już wszystkich operacji po since
+ */
+bool Journal::follow(uint64_t since, const Listener& deliver) const {
+	std::lock_guard<std::mutex> lock(Fmutex);
+	std::vector<Record> records;
+	std::string lines;
+	scan(records, &lines, since);
+
+	// Operacje po since muszą zaczynać się dokładnie od since + 1
+	if (since < Fsequence && (records.empty() || records.front().Fsequence != since + 1)) return false;
+	deliver(lines, Fsequence);
+	return true;
+}
+
+/**
+ * @brief Ustawia słuchacza zapisów
+ * @param listener Wywoływany jako listener(linie, numer ostatniej operacji) po każdym zapisie
+ */
+void Journal::setListener(Listener listener) {
+	std::lock_guard<std::mutex> lock(Fmutex);
+	Flistener = std::move(listener);
+}
+
+/**
+ * @brief Zapisuje linie operacji i utrwala je jednym fsync
+ * @param records Operacje
+ * @return Numer ostatniej operacji lub 0
+ */
+uint64_t Journal::write(std::vector<Record>& records) {
+	if (Ffile == nullptr || records.empty()) return 0;
+
+	std::string lines;
+	uint64_t sequence = Fsequence;
+	for (size_t i = 0; i < records.size(); i++) {
+		Record& record = records[i];
+		record.Fsequence = ++sequence;
+
+		// Wszystkie linie transakcji poza ostatnią - mała litera operacji
+		char operation = static_cast<char>(record.Foperation);
+		if (i + 1 < records.size()) operation = static_cast<char>(std::tolower(static_cast<unsigned char>(operation)));
+
+		char price[32];
+		auto result = std::to_chars(price, price + sizeof(price), record.Fprice);
+		std::string body = std::to_string(record.Fsequence) + ' ' + operation + ' ' +
+			std::to_string(record.FticketId) + ' ' + std::to_string(record.FtrainId) + ' ' +
+			std::to_string(record.Fseat) + ' ' + std::to_string(record.FnewSeat) + ' ' +
+			std::string(price, result.ptr) + ' ' + record.Fpassenger;
+		lines += DurableFile::formatCrc(DurableFile::crc32(body));
+		lines += ' ';
+		lines += body;
+		lines += '\n';
+	}
+
+	if (std::fwrite(lines.data(), 1, lines.size(), Ffile) != lines.size() || !DurableFile::sync(Ffile)) {
+		std::cerr << "Blad: Zapis do dziennika " << Fpath << " nie powiodl sie" << std::endl;
+		discardFailedWrite();
+		return 0;
+	}
+	Fsequence = sequence;
+	Frecords += records.size();
+	Fbytes += lines.size();
+	if (Flistener) Flistener(lines, Fsequence);
+	return Fsequence;
+}
+
+/**
+ * @brief Obcina nieudany zapis i otwiera plik ponownie
+ *
+ * Część linii mogła trafić do pliku (krótki fwrite) albo zostać w buforze
+ * strumienia - plik jest zamykany (reszta bufora ląduje w pliku), a potem
+ * obcinany do ostatniego utrwalonego zapisu. Bez tego kolejne operacje
+ * trafiłyby za uszkodzoną linię i zostałyby obcięte przy odtwarzaniu.
+ */
+void Journal::discardFailedWrite() {
+	std::fclose(Ffile);
+	Ffile = nullptr;
+
+	std::error_code error;
+	std::filesystem::resize_file(Fpath, Fbytes, error);
+	if (error) {
+		std::cerr << "Blad: Nie mozna obciac dziennika " << Fpath << " - kolejne operacje beda odrzucane" << std::endl;
+		return;
+	}
+	Ffile = std::fopen(Fpath.c_str(), "ab");
+	if (Ffile == nullptr) std::cerr << "Blad: Nie mozna otworzyc dziennika " << Fpath << std::endl;
+}
+
+/**
+ * @brief Dopisuje operację i utrwala ją na dysku
+ * @param record Operacja
+ * @return Nadany numer sekwencyjny lub 0
+ */
+uint64_t Journal::append(Record record) {
+	std::vector<Record> records{ std::move(record) };
+	std::lock_guard<std::mutex> lock(Fmutex);
+	return write(records);
+}
+
+/**
+ * @brief Dopisuje operacje jednej transakcji
+ * @param records Operacje w kolejności wykonania
+ * @return Numer ostatniej operacji lub 0
+ */
+uint64_t Journal::appendGroup(std::vector<Record> records) {
+	std::lock_guard<std::mutex> lock(Fmutex);
+	return write(records);
+}
+
+/**
+ * @brief Czyści dziennik (numeracja operacji jest zachowana)
+ */
+void Journal::reset() {
+	std::lock_guard<std::mutex> lock(Fmutex);
+	if (Ffile == nullptr || Frecords == 0) return;
+	std::fclose(Ffile);
+	Ffile = std::fopen(Fpath.c_str(), "wb");
+	if (Ffile != nullptr) DurableFile::sync(Ffile);
+	Frecords = 0;
+	Fbytes = 0;
+}
+
+/**
+ * @brief Zwraca numer ostatniej zapisanej operacji
+ * @return Numer sekwencyjny
+ */
+uint64_t Journal::sequence() const {
+	std::lock_guard<std::mutex> lock(Fmutex);
+	return Fsequence;
+}
+
+/**
+ * @brief Zwraca liczbę operacji w pliku dziennika
+ * @return Liczba operacji
+ */
+size_t Journal::size() const {
+	std::lock_guard<std::mutex> lock(Fmutex);
+	return Frecords;
+}
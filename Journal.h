@@ -0,0 +1,192 @@
+/**
+ * @file Journal.h
+ * @brief Deklaracja klasy Journal - dziennik operacji rezerwacji (write-ahead log)
+ */
+
+#pragma once
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class Journal
+ * @brief Dopisywany dziennik rezerwacji, anulowań i zmian miejsc
+ *
+ * Każda operacja to jedna linia z kolejnym numerem sekwencyjnym i sumą CRC-32:
+ *
+ *     <crc> <nr> <operacja> <ID biletu> <ID pociągu> <miejsce> <nowe miejsce> <cena> <login>
+ *
+ * Linia jest utrwalana na dysku (fsync) przed zgłoszeniem wyniku operacji.
+ * Migawki (trains.yaml, tickets.yaml) zapisują numer ostatniej operacji,
+ * którą obejmują - po restarcie odtwarzany jest tylko nowszy ogon dziennika,
+ * a dziennik jest czyszczony, gdy obie migawki obejmują wszystkie operacje.
+ *
+ * Operacje jednej transakcji (appendGroup) zapisywane są razem, a wszystkie
+ * poza ostatnią mają literę operacji zapisaną małą literą ("ciąg dalszy").
+ * Transakcja bez ostatniej linii jest przy odtwarzaniu pomijana w całości.
+ *
+ * Zmiany zapisywane tylko w migawkach (pociągi, import, archiwizacja, konta)
+ * zostawiają w dzienniku znacznik RELOAD - repliki wczytują wtedy migawki od nowa.
+ *
+ * Linia z błędną sumą kontrolną lub ucięta (przerwany zapis) kończy dziennik -
+ * zostaje obcięta przy odtwarzaniu. Zapis, który się nie powiódł (błąd fwrite
+ * lub fsync), jest od razu obcinany z pliku, a operacja zgłaszana jako
+ * nieutrwalona - kolejne zapisy nie trafiają za uszkodzony fragment.
+ */
+class Journal
+{
+public:
+	/**
+	 * @enum Operation
+	 * @brief Rodzaj zapisanej operacji
+	 */
+	enum class Operation : char {
+		BOOK = 'B',      ///< Rezerwacja miejsca (nowy bilet)
+		CANCEL = 'C',    ///< Anulowanie biletu
+		MOVE = 'M',      ///< Zmiana miejsca w tym samym pociągu
+		RELOAD = 'R'     ///< Zmiana zapisana tylko w migawkach (bez pól - replika wczytuje migawki od nowa)
+	};
+
+	/**
+	 * @struct Record
+	 * @brief Jedna operacja dziennika
+	 */
+	struct Record {
+		uint64_t Fsequence = 0;            ///< Numer sekwencyjny (nadawany przy dopisaniu)
+		Operation Foperation = Operation::BOOK; ///< Rodzaj operacji
+		int FticketId = 0;                 ///< ID biletu
+		int FtrainId = 0;                  ///< ID pociągu
+		int Fseat = 0;                     ///< Miejsce (przy zmianie - dotychczasowe)
+		int FnewSeat = 0;                  ///< Nowe miejsce (tylko MOVE)
+		double Fprice = 0.0;               ///< Cena (tylko BOOK)
+		std::string Fpassenger;            ///< Login pasażera
+	};
+
+	/// Słuchacz zapisów: (linie w formacie pliku, numer ostatniej operacji)
+	using Listener = std::function<void(std::string_view, uint64_t)>;
+
+private:
+	std::string Fpath;          ///< Ścieżka do pliku dziennika
+	std::FILE* Ffile;           ///< Plik otwarty do dopisywania (nullptr przed recover)
+	uint64_t Fsequence;         ///< Numer ostatniej zapisanej operacji
+	size_t Frecords;            ///< Liczba operacji w pliku
+	uint64_t Fbytes;            ///< Długość utrwalonej części pliku (bajty)
+	mutable std::mutex Fmutex;  ///< Chroni dopisywanie z wielu wątków
+	Listener Flistener;         ///< Słuchacz zapisów (np. replikacja)
+
+	/**
+	 * @brief Przegląda plik dziennika - tylko kompletne, poprawne transakcje
+	 * @param records Zmienna, do której zostaną dopisane operacje o numerach większych niż after
+	 * @param lines Zmienna, do której zostaną dopisane surowe linie tych operacji (nullptr - bez linii)
+	 * @param after Numer operacji, od którego zbierane są wyniki
+	 * @return Liczba bajtów poprawnej części pliku
+	 */
+	size_t scan(std::vector<Record>& records, std::string* lines, uint64_t after) const;
+
+	/**
+	 * @brief Zapisuje linie operacji i utrwala je jednym fsync (wywoływane pod blokadą)
+	 * @param records Operacje (numery sekwencyjne nadawane są tutaj)
+	 * @return Numer ostatniej operacji (0 przy błędzie)
+	 */
+	uint64_t write(std::vector<Record>& records);
+
+	/**
+	 * @brief Obcina nieudany zapis i otwiera plik ponownie (wywoływane pod blokadą)
+	 *
+	 * Jeśli obcięcie się nie powiedzie, dziennik zostaje zamknięty - kolejne zapisy są odrzucane.
+	 */
+	void discardFailedWrite();
+
+public:
+	/**
+	 * @brief Konstruktor klasy Journal
+	 * @param path Ścieżka do pliku dziennika
+	 */
+	explicit Journal(std::string path);
+
+	/**
+	 * @brief Parsuje linię dziennika i sprawdza jej sumę kontrolną
+	 * @param line Linia bez znaku końca linii
+	 * @param record Zmienna, do której zostanie zapisana operacja
+	 * @param continued Zmienna, do której zostanie zapisane, czy transakcja ma kolejne linie
+	 * @return false jeśli linia jest uszkodzona
+	 */
+	static bool parse(const std::string& line, Record& record, bool& continued);
+
+	~Journal();
+
+	Journal(const Journal&) = delete;
+	Journal& operator=(const Journal&) = delete;
+
+	/**
+	 * @brief Odczytuje dziennik po uruchomieniu i otwiera go do dopisywania
+	 *
+	 * Uszkodzony ogon pliku jest obcinany. Numeracja kolejnych operacji
+	 * zaczyna się za większą z wartości: ostatnią operacją w pliku lub
+	 * numerem objętym przez migawki.
+	 *
+	 * @param checkpoint Najwyższy numer operacji objęty migawkami
+	 * @return Wszystkie poprawne operacje z pliku (rosnąco)
+	 */
+	std::vector<Record> recover(uint64_t checkpoint);
+
+	/**
+	 * @brief Odczytuje dziennik bez obcinania i bez otwierania do zapisu (replika)
+	 * @return Wszystkie poprawne operacje z pliku (rosnąco)
+	 */
+	std::vector<Record> read() const;
+
+	/**
+	 * @brief Przekazuje odbiorcy operacje nowsze niż since (pod blokadą dziennika)
+	 *
+	 * Wywołujący zwykle w deliver rejestruje odbiorcę u słuchacza, dzięki czemu
+	 * odbiorca dostaje każdą operację dokładnie raz.
+	 *
+	 * @param since Ostatnia operacja znana odbiorcy
+	 * @param deliver Wywoływane jako deliver(linie, numer ostatniej operacji)
+	 * @return false jeśli część operacji po since została już usunięta z dziennika (migawka)
+	 */
+	bool follow(uint64_t since, const Listener& deliver) const;
+
+	/**
+	 * @brief Ustawia słuchacza wywoływanego po każdym zapisie (pod blokadą dziennika)
+	 * @param listener Słuchacz (pusty - brak)
+	 */
+	void setListener(Listener listener);
+
+	/**
+	 * @brief Dopisuje operację i utrwala ją na dysku
+	 * @param record Operacja (numer sekwencyjny nadawany jest tutaj)
+	 * @return Nadany numer sekwencyjny (0 jeśli dziennik nie jest otwarty lub zapis się nie powiódł)
+	 */
+	uint64_t append(Record record);
+
+	/**
+	 * @brief Dopisuje operacje jednej transakcji - po awarii odtwarzane są wszystkie albo żadna
+	 * @param records Operacje w kolejności wykonania
+	 * @return Numer ostatniej operacji (0 jeśli dziennik nie jest otwarty lub zapis się nie powiódł)
+	 */
+	uint64_t appendGroup(std::vector<Record> records);
+
+	/**
+	 * @brief Czyści dziennik po zapisaniu migawek obejmujących wszystkie operacje
+	 */
+	void reset();
+
+	/**
+	 * @brief Zwraca numer ostatniej zapisanej operacji
+	 * @return Numer sekwencyjny
+	 */
+	uint64_t sequence() const;
+
+	/**
+	 * @brief Zwraca liczbę operacji w pliku dziennika
+	 * @return Liczba operacji od ostatniego czyszczenia
+	 */
+	size_t size() const;
+};
@@ -0,0 +1,115 @@
+/**
+ * @file LineReader.cpp
+ * @brief Implementacja klasy LineReader - odczyt blokami przez read i podział na linie przez memchr
+ */
+
+#include "LineReader.h"
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Konstruktor klasy LineReader
+ * @param descriptor Deskryptor wejścia
+ */
+LineReader::LineReader(int descriptor)
+	: Fdescriptor(descriptor), Fbuffer(BLOCK_SIZE), Fstart(0), Fscanned(0), Fend(0), Fclosed(false), Ftie(nullptr) {}
+
+/**
+ * @brief Ustawia strumień opróżniany przed oczekiwaniem na wejście
+ * @param out Strumień lub nullptr
+ */
+void LineReader::tie(std::ostream* out) {
+	Ftie = out;
+}
+
+/**
+ * @brief Dołącza do bufora kolejny blok danych
+ *
+ * Niepełna linia przesuwana jest na początek bufora; bufor rośnie tylko wtedy,
+ * gdy pojedyncza linia nie mieści się w wolnym miejscu.
+ *
+ * @return false przy końcu wejścia lub błędzie odczytu
+ */
+bool LineReader::fill() {
+	if (Fstart > 0) {
+		std::memmove(Fbuffer.data(), Fbuffer.data() + Fstart, Fend - Fstart);
+		Fscanned -= Fstart;
+		Fend -= Fstart;
+		Fstart = 0;
+	}
+	if (Fbuffer.size() - Fend < BLOCK_SIZE) Fbuffer.resize(Fend + BLOCK_SIZE);
+	if (Ftie != nullptr) Ftie->flush();
+
+	while (true) {
+#ifdef _WIN32
+		int received = _read(Fdescriptor, Fbuffer.data() + Fend, static_cast<unsigned int>(BLOCK_SIZE));
+#else
+		ssize_t received = read(Fdescriptor, Fbuffer.data() + Fend, BLOCK_SIZE);
+		if (received < 0 && errno == EINTR) continue;
+#endif
+		if (received <= 0) {
+			Fclosed = true;
+			return false;
+		}
+		Fend += static_cast<size_t>(received);
+		return true;
+	}
+}
+
+/**
+ * @brief Pobiera kolejną linię
+ *
+ * Ostatnia linia bez końcowego '\n' jest zwracana jak przez std::getline.
+ * Przeszukana część niepełnej linii nie jest przeszukiwana ponownie po odczycie kolejnego bloku.
+ *
+ * @param line Zmienna, do której zostanie zapisany widok na linię
+ * @return false jeśli wejście się skończyło
+ */
+bool LineReader::next(std::string_view& line) {
+	while (true) {
+		const char* data = Fbuffer.data();
+		const char* newline = static_cast<const char*>(std::memchr(data + Fscanned, '\n', Fend - Fscanned));
+		size_t stop = Fend;
+		if (newline != nullptr) {
+			stop = static_cast<size_t>(newline - data);
+		}
+		else {
+			Fscanned = Fend;
+			if (!Fclosed && fill()) continue;
+			if (Fstart == Fend) return false;
+			data = Fbuffer.data();   // fill() mogło przesunąć dane przed nieudanym odczytem
+			stop = Fend;
+		}
+
+		line = std::string_view(data + Fstart, stop - Fstart);
+		if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+		Fstart = Fscanned = newline != nullptr ? stop + 1 : Fend;
+		return true;
+	}
+}
+
+/**
+ * @brief Sprawdza bez blokowania, czy na wejściu czekają kolejne dane
+ *
+ * Poza buforem sprawdzany jest sam deskryptor (poll z zerowym czasem oczekiwania);
+ * koniec wejścia też jest zgłaszany jako gotowość, bo next() zwróci wtedy false od razu.
+ *
+ * @return true jeśli w buforze lub na deskryptorze są nieprzeczytane bajty
+ */
+bool LineReader::ready() const {
+	if (Fstart < Fend) return true;
+	if (Fclosed) return false;
+#ifdef _WIN32
+	return false;
+#else
+	pollfd descriptor{ Fdescriptor, POLLIN, 0 };
+	return poll(&descriptor, 1, 0) > 0;
+#endif
+}
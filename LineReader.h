@@ -0,0 +1,69 @@
+/**
+ * @file LineReader.h
+ * @brief Deklaracja klasy LineReader - wejście poleceń czytane dużymi blokami i dzielone na linie
+ */
+
+#pragma once
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class LineReader
+ * @brief Czytnik linii z deskryptora pliku (standardowe wejście, potok, plik)
+ *
+ * Dane pobierane są wywołaniem read po BLOCK_SIZE bajtów naraz - bez
+ * synchronizacji ze stdio i bez lokalizacji - a linie wyszukiwane w bloku
+ * przez memchr. next() zwraca widok na linię wewnątrz bufora, więc linia nie
+ * jest kopiowana; przed kolejnym odczytem z bufora przesuwana jest tylko
+ * niepełna linia z końca bloku.
+ *
+ * read zwraca tyle danych, ile jest dostępne, więc czytnik nie czeka na pełny
+ * blok - polecenia wpisywane w konsoli albo wysyłane pojedynczo przez potok
+ * są przekazywane od razu.
+ */
+class LineReader
+{
+	int Fdescriptor;             ///< Deskryptor wejścia
+	std::vector<char> Fbuffer;   ///< Odczytane dane
+	size_t Fstart;               ///< Początek nieprzeczytanej części bufora
+	size_t Fscanned;             ///< Koniec części bufora przeszukanej bez znalezienia '\n'
+	size_t Fend;                 ///< Koniec odczytanych danych
+	bool Fclosed;                ///< Osiągnięto koniec wejścia lub wystąpił błąd odczytu
+	std::ostream* Ftie;          ///< Strumień opróżniany przed oczekiwaniem na dane (jak std::cin.tie)
+
+	/**
+	 * @brief Dołącza do bufora kolejny blok danych
+	 * @return false przy końcu wejścia lub błędzie odczytu
+	 */
+	bool fill();
+
+public:
+	static constexpr size_t BLOCK_SIZE = 64 * 1024;   ///< Rozmiar pojedynczego odczytu (bajty)
+
+	/**
+	 * @brief Konstruktor klasy LineReader
+	 * @param descriptor Deskryptor wejścia (0 - standardowe wejście)
+	 */
+	explicit LineReader(int descriptor);
+
+	/**
+	 * @brief Ustawia strumień opróżniany przed oczekiwaniem na wejście (np. pytanie menu)
+	 * @param out Strumień lub nullptr
+	 */
+	void tie(std::ostream* out);
+
+	/**
+	 * @brief Pobiera kolejną linię (bez "\n" i "\r\n")
+	 * @param line Zmienna, do której zostanie zapisany widok na linię (ważny do kolejnego wywołania)
+	 * @return false jeśli wejście się skończyło
+	 */
+	bool next(std::string_view& line);
+
+	/**
+	 * @brief Sprawdza bez blokowania, czy na wejściu czekają kolejne dane
+	 * @return true jeśli w buforze lub na deskryptorze są nieprzeczytane bajty
+	 */
+	bool ready() const;
+};
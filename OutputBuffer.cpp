@@ -0,0 +1,87 @@
+/**
+ * @file OutputBuffer.cpp
+ * @brief Implementacja klasy OutputBuffer - formatowanie przez std::to_chars i zapis jednym wywołaniem
+ */
+
+#include "OutputBuffer.h"
+
+/**
+ * @brief Dopisuje liczbę ze stałą liczbą miejsc po przecinku
+ *
+ * Zaokrąglenie jest takie samo jak przy std::fixed i std::setprecision.
+ *
+ * @param number Liczba i liczba miejsc po przecinku
+ * @return Bufor
+ */
+OutputBuffer& OutputBuffer::operator<<(Fixed number) {
+	char text[352];   // największy double w zapisie stałoprzecinkowym z zapasem na ułamek
+	auto result = std::to_chars(text, text + sizeof(text), number.Fvalue, std::chars_format::fixed, number.Fprecision);
+	if (result.ec == std::errc()) Fdata.append(text, result.ptr);
+	return *this;
+}
+
+/**
+ * @brief Dopisuje tekst wyrównany do lewej, dopełniony spacjami do szerokości pola
+ * @param field Tekst i szerokość pola
+ * @return Bufor
+ */
+OutputBuffer& OutputBuffer::operator<<(Left field) {
+	Fdata.append(field.Ftext);
+	if (field.Ftext.size() < field.Fwidth) Fdata.append(field.Fwidth - field.Ftext.size(), ' ');
+	return *this;
+}
+
+/**
+ * @brief Dopisuje liczbę całkowitą wyrównaną do lewej w polu o stałej szerokości
+ * @param value Liczba
+ * @param width Szerokość pola
+ * @return Bufor
+ */
+OutputBuffer& OutputBuffer::left(long long value, size_t width) {
+	char text[24];
+	auto result = std::to_chars(text, text + sizeof(text), value);
+	return *this << Left{ std::string_view(text, static_cast<size_t>(result.ptr - text)), width };
+}
+
+/**
+ * @brief Dopisuje znak powtórzony podaną liczbę razy
+ * @param c Znak
+ * @param count Liczba powtórzeń
+ * @return Bufor
+ */
+OutputBuffer& OutputBuffer::repeat(char c, size_t count) {
+	Fdata.append(count, c);
+	return *this;
+}
+
+/**
+ * @brief Zwraca sformatowany tekst
+ * @return Widok na zawartość bufora
+ */
+std::string_view OutputBuffer::view() const { return Fdata; }
+
+/**
+ * @brief Zwraca długość sformatowanego tekstu
+ * @return Liczba bajtów
+ */
+size_t OutputBuffer::size() const { return Fdata.size(); }
+
+/**
+ * @brief Sprawdza czy bufor jest pusty
+ * @return true jeśli bufor jest pusty
+ */
+bool OutputBuffer::empty() const { return Fdata.empty(); }
+
+/**
+ * @brief Czyści bufor - pojemność zostaje na kolejny ekran
+ */
+void OutputBuffer::clear() { Fdata.clear(); }
+
+/**
+ * @brief Wypisuje zawartość jednym wywołaniem write i czyści bufor
+ * @param out Strumień docelowy
+ */
+void OutputBuffer::writeTo(std::ostream& out) {
+	out.write(Fdata.data(), static_cast<std::streamsize>(Fdata.size()));
+	Fdata.clear();
+}
@@ -0,0 +1,118 @@
+/**
+ * @file OutputBuffer.h
+ * @brief Deklaracja klasy OutputBuffer - formatowanie ekranów i odpowiedzi do jednego bufora
+ */
+
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @class OutputBuffer
+ * @brief Bufor tekstu wielokrotnego użytku wypisywany jednym zapisem
+ *
+ * Ekran (mapa miejsc, tabela wyników, raport) lub porcja odpowiedzi trybu
+ * wsadowego składana jest w buforze - liczby formatowane przez std::to_chars,
+ * bez lokalizacji i bez opróżniania strumienia po każdej linii - a potem
+ * przekazywana do strumienia jednym wywołaniem write (writeTo).
+ * Bufor zachowuje zaalokowaną pamięć między kolejnymi ekranami.
+ */
+class OutputBuffer
+{
+	std::string Fdata;   ///< Sformatowany tekst
+
+public:
+	/**
+	 * @struct Fixed
+	 * @brief Liczba zmiennoprzecinkowa ze stałą liczbą miejsc po przecinku (jak std::fixed)
+	 */
+	struct Fixed {
+		double Fvalue;       ///< Wartość
+		int Fprecision;      ///< Liczba miejsc po przecinku
+	};
+
+	/**
+	 * @struct Left
+	 * @brief Tekst wyrównany do lewej w polu o stałej szerokości (jak std::left i std::setw)
+	 */
+	struct Left {
+		std::string_view Ftext;   ///< Tekst (dłuższy od pola nie jest obcinany)
+		size_t Fwidth;            ///< Szerokość pola
+	};
+
+	OutputBuffer& operator<<(std::string_view text) {
+		Fdata.append(text);
+		return *this;
+	}
+	OutputBuffer& operator<<(const char* text) { return *this << std::string_view(text); }
+	OutputBuffer& operator<<(const std::string& text) { return *this << std::string_view(text); }
+	OutputBuffer& operator<<(char c) {
+		Fdata.push_back(c);
+		return *this;
+	}
+
+	/**
+	 * @brief Dopisuje liczbę całkowitą
+	 * @param value Liczba
+	 * @return Bufor
+	 */
+	template <typename Integer, std::enable_if_t<std::is_integral_v<Integer> && !std::is_same_v<Integer, char> && !std::is_same_v<Integer, bool>, int> = 0>
+	OutputBuffer& operator<<(Integer value) {
+		char text[24];
+		auto result = std::to_chars(text, text + sizeof(text), value);
+		Fdata.append(text, result.ptr);
+		return *this;
+	}
+
+	OutputBuffer& operator<<(Fixed number);
+	OutputBuffer& operator<<(Left field);
+
+	/**
+	 * @brief Dopisuje liczbę całkowitą wyrównaną do lewej w polu o stałej szerokości
+	 * @param value Liczba
+	 * @param width Szerokość pola
+	 * @return Bufor
+	 */
+	OutputBuffer& left(long long value, size_t width);
+
+	/**
+	 * @brief Dopisuje znak powtórzony podaną liczbę razy
+	 * @param c Znak
+	 * @param count Liczba powtórzeń
+	 * @return Bufor
+	 */
+	OutputBuffer& repeat(char c, size_t count);
+
+	/**
+	 * @brief Zwraca sformatowany tekst
+	 * @return Widok na zawartość bufora (ważny do kolejnej zmiany)
+	 */
+	std::string_view view() const;
+
+	/**
+	 * @brief Zwraca długość sformatowanego tekstu
+	 * @return Liczba bajtów
+	 */
+	size_t size() const;
+
+	/**
+	 * @brief Sprawdza czy bufor jest pusty
+	 * @return true jeśli nic nie dopisano od ostatniego wypisania
+	 */
+	bool empty() const;
+
+	/**
+	 * @brief Czyści bufor bez zwalniania pamięci
+	 */
+	void clear();
+
+	/**
+	 * @brief Wypisuje zawartość jednym wywołaniem write i czyści bufor
+	 * @param out Strumień docelowy
+	 */
+	void writeTo(std::ostream& out);
+};
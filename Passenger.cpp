@@ -5,22 +5,29 @@
 
 #include "Passenger.h"
 #include "InputValidation.h"
-#include <iostream>
+#include "OutputBuffer.h"
+#include <ostream>
 #include <algorithm> 
 #include <iterator>  
-#include <iomanip>   
 #include <string>
+#include <string_view>
 #include <limits>    
 #include <cctype>    
 
+/// Liczba wyników wyszukiwania wyświetlanych na jednej stronie
+static constexpr size_t RESULTS_PER_PAGE = 10;
+
+/// Linia oddzielająca nagłówek i wiersze tabeli wyników
+static constexpr std::string_view TABLE_RULE = "------------------------------------------------------------------------------------------\n";
+
 /**
  * @brief Konstruktor klasy Passenger - inicjalizuje pasażera
  * @param login Login pasażera
- * @param password Hasło pasażera
+ * @param password Skrót hasła pasażera
  * @param id Unikalny identyfikator pasażera
  */
 Passenger::Passenger(std::string login, std::string password, int id)
-	: User(login, password, id) {
+	: User(std::move(login), std::move(password), id) {
 }
 
 /**
@@ -31,222 +38,273 @@ std::string Passenger::getType() const { return "PASSENGER"; }
 
 /**
  * @brief Wyświetla menu pasażera z dostępnymi opcjami
+ * @param out Strumień wyjścia sesji
  */
-void Passenger::showMenu() {
-	std::cout << "\n=== PANEL PASAZERA: " << get_Flogin() << " ===" << std::endl;
-	std::cout << "1. Wyszukaj i zarezerwuj bilet" << std::endl;
-	std::cout << "2. Moje rezerwacje" << std::endl;
-	std::cout << "3. Anuluj rezerwacje" << std::endl;  
-	std::cout << "4. Modyfikuj rezerwacje" << std::endl; 
-	std::cout << "5. Wyloguj" << std::endl;
-	std::cout << "Wybierz opcje: ";
-}
-
-/**
- * @brief Konwertuje tekst na małe litery
- * @param str Tekst do konwersji
- * @return Tekst zapisany małymi literami
- */
-std::string toLowerCase(std::string str) {
-	std::transform(str.begin(), str.end(), str.begin(),
-		[](unsigned char c) { return std::tolower(c); });
-	return str;
-}
-
-/**
- * @brief Sprawdza czy tekst zawiera podany fragment (bez rozróżniania wielkości liter)
- * @param text Przeszukiwany tekst
- * @param term Szukany fragment
- * @return true jeśli fragment został znaleziony, false w przeciwnym razie
- */
-bool containsString(const std::string& text, const std::string& term) {
-	if (term.empty()) return true;
-	return toLowerCase(text).find(toLowerCase(term)) != std::string::npos;
+void Passenger::showMenu(std::ostream& out) {
+	out << "\n=== PANEL PASAZERA: " << get_Flogin() << " ===\n";
+	out << "1. Wyszukaj i zarezerwuj bilet\n";
+	out << "2. Moje rezerwacje\n";
+	out << "3. Anuluj rezerwacje\n";  
+	out << "4. Modyfikuj rezerwacje\n"; 
+	out << "5. Wyloguj\n";
+	out << "Wybierz opcje: ";
 }
 
 /**
- * @brief Wyszukuje i rezerwuje bilet na wybrany pociąg
+ * @brief Prowadzi pasażera przez wyszukiwanie i wybór miejsca
  * 
  * Funkcja oferuje różne tryby wyszukiwania:
  * 1. Wyświetlenie wszystkich pociągów
  * 2. Filtrowanie po stacji początkowej
  * 3. Filtrowanie po stacji końcowej
  * 4. Zaawansowane wyszukiwanie z wieloma kryteriami
+ *
+ * Wyniki można posortować według daty, liczby wolnych miejsc lub ceny
+ * i są wyświetlane stronami po RESULTS_PER_PAGE pociągów.
+ * 
+ * Po wyborze pociągu wyświetla mapę miejsc, pozwala wybrać klasę podróży
+ * spośród klas z układu wagonów oraz miejsce (lub pierwsze wolne w klasie),
+ * pokazuje podsumowanie i prosi o potwierdzenie zakupu.
  * 
- * Po wyborze pociągu wyświetla mapę miejsc, pozwala wybrać klasę podróży,
- * pokazuje podsumowanie i przeprowadza proces płatności i rezerwacji.
+ * Odpowiedzi pasażera odbierane są przez co_await - w tym czasie inne sesje
+ * działają dalej, więc wybrany pociąg wyszukiwany jest ponownie po każdej odpowiedzi.
  * 
- * @param trains Wektor pociągów dostępnych w systemie
- * @param tickets Wektor biletów - nowy bilet zostanie do niego dodany po pomyślnej rezerwacji
+ * @param io Kanał sesji
+ * @param engine Silnik rezerwacji (pociągi, bilety, generator ID)
+ * @param request Zmienna, do której zostanie zapisana wybrana rezerwacja
+ * @return true jeśli pasażer potwierdził zakup
  */
-void Passenger::bookTicket(std::vector<Train>& trains, std::vector<Ticket>& tickets) {
+Task<bool> Passenger::chooseSeat(SessionIO& io, BookingEngine& engine, BookingRequest& request) {
+	std::ostream& out = io.out();
+	TrainCatalog& trains = engine.trains();
 	if (trains.empty()) {
-		std::cout << "\n[INFO] Aktualnie brak pociagow w bazie.\n";
-		return;
+		out << "\n[INFO] Aktualnie brak pociagow w bazie.\n";
+		co_return false;
 	}
 
-	std::cout << "\n--- WYSZUKIWARKA POLACZEN ---\n";
-	std::cout << "1. Pokaz wszystkie pociagi\n";
-	std::cout << "2. Szukaj po stacji poczatkowej (Skad)\n";
-	std::cout << "3. Szukaj po stacji koncowej (Dokad)\n";
-	std::cout << "4. Wyszukiwanie zaawansowane (Filtruj dowolne pola)\n";
+	out << "\n--- WYSZUKIWARKA POLACZEN ---\n";
+	out << "1. Pokaz wszystkie pociagi\n";
+	out << "2. Szukaj po stacji poczatkowej (Skad)\n";
+	out << "3. Szukaj po stacji koncowej (Dokad)\n";
+	out << "4. Wyszukiwanie zaawansowane (Filtruj dowolne pola)\n";
 
-	int searchOption;
-	readInt("Wybierz opcje filtrowania: ", searchOption);
+	int searchOption = co_await readInt(io, "Wybierz opcje filtrowania: ");
 
-	std::vector<Train> displayList;
-
-	// Wybór trybu wyszukiwania
+	// Wybór trybu wyszukiwania - kryteria trafiają do znormalizowanego zapytania
+	SearchQuery query;
 	if (searchOption == 1) {
-		displayList = trains;
+		query = SearchQuery::make("", "", "", BookingEngine::ANY_CLASS);
 	}
 	else if (searchOption == 2 || searchOption == 3) {
-		std::string searchTerm;
-		readLine("Wpisz nazwe stacji: ", searchTerm);
+		std::string searchTerm = co_await readLine(io, "Wpisz nazwe stacji: ");
 
-		if (searchOption == 2) {
-			// Filtrowanie po stacji początkowej
-			std::copy_if(trains.begin(), trains.end(), std::back_inserter(displayList),
-				[&searchTerm](const Train& t) { return containsString(t.getOrigin(), searchTerm); });
-		}
-		else {
-			// Filtrowanie po stacji końcowej
-			std::copy_if(trains.begin(), trains.end(), std::back_inserter(displayList),
-				[&searchTerm](const Train& t) { return containsString(t.getDestination(), searchTerm); });
-		}
+		// Filtrowanie po stacji początkowej lub końcowej
+		if (searchOption == 2) query = SearchQuery::make(searchTerm, "", "", BookingEngine::ANY_CLASS);
+		else query = SearchQuery::make("", searchTerm, "", BookingEngine::ANY_CLASS);
 	}
 	else if (searchOption == 4) {
 		// Wyszukiwanie zaawansowane - wiele kryteriów
-		std::string from, to, date;
+		out << "\n--- Planowanie Podrozy ---\n";
+		out << "(Wcisnij ENTER aby pominac dany filtr)\n";
 
-		std::cout << "\n--- Planowanie Podrozy ---\n";
-		std::cout << "(Wcisnij ENTER aby pominac dany filtr)\n";
+		out << "Skad: ";
+		std::string from = co_await io.nextLine();
 
-		std::cout << "Skad: ";
-		std::getline(std::cin, from);
+		out << "Dokad: ";
+		std::string to = co_await io.nextLine();
 
-		std::cout << "Dokad: ";
-		std::getline(std::cin, to);
+		out << "Data (RRRR, RRRR-MM lub RRRR-MM-DD): ";
+		std::string date = co_await io.nextLine();
 
-		std::cout << "Data (RRRR-MM-DD): ";
-		std::getline(std::cin, date);
+		// Najwcześniejsza godzina odjazdu (pusta lub niepoprawna - bez filtra)
+		uint16_t departureFrom = 0;
+		out << "Odjazd od (GG:MM): ";
+		std::string time = co_await io.nextLine();
+		if (!time.empty() && !Train::parseTime(time, departureFrom)) {
+			out << "Niepoprawna godzina - filtr pominiety.\n";
+		}
 
-		// Filtrowanie z wieloma kryteriami
-		std::copy_if(trains.begin(), trains.end(), std::back_inserter(displayList),
-			[&from, &to, &date](const Train& t) {
-				bool matchOrigin = containsString(t.getOrigin(), from);
-				bool matchDest = containsString(t.getDestination(), to);
-				bool matchDate = containsString(t.getDate(), date);
-				return matchOrigin && matchDest && matchDate;
-			});
+		query = SearchQuery::make(from, to, date, BookingEngine::ANY_CLASS, departureFrom);
 	}
 	else {
-		std::cout << "Niepoprawna opcja wyszukiwania.\n";
-		return;
+		out << "Niepoprawna opcja wyszukiwania.\n";
+		co_return false;
 	}
 
-	// Sprawdzenie czy znaleziono jakiekolwiek połączenia
-	if (displayList.empty()) {
-		std::cout << "\n[INFO] Nie znaleziono polaczen spelniajacych kryteria.\n";
-		return;
+	// Kolejność wyników
+	out << "\nSortuj wedlug: 1. Daty  2. Liczby wolnych miejsc  3. Ceny\n";
+	int sortOption = co_await readInt(io, "Wybierz: ");
+	SearchSort sort = sortOption == 2 ? SearchSort::FREE_SEATS : sortOption == 3 ? SearchSort::PRICE : SearchSort::DATE;
+
+	// Wyniki wyświetlane stronami - sortowana jest tylko część potrzebna do bieżącej strony
+	size_t offset = 0;
+	int tId;
+	while (true) {
+		SearchPage page = engine.searchPage(query, sort, offset, RESULTS_PER_PAGE);
+
+		// Sprawdzenie czy znaleziono jakiekolwiek połączenia
+		if (page.Ftotal == 0) {
+			out << "\n[INFO] Nie znaleziono polaczen spelniajacych kryteria.\n";
+			co_return false;
+		}
+
+		// Wyświetlenie strony wyników w formacie tabeli (składana w buforze, wypisywana jednym zapisem)
+		thread_local OutputBuffer table;
+		table << "\nZnaleziono " << page.Ftotal << " pasujacych polaczen (wyniki " << offset + 1
+			<< "-" << offset + page.Ftrains.size() << "):\n";
+		table << TABLE_RULE;
+		table << OutputBuffer::Left{ "ID", 6 }
+			<< OutputBuffer::Left{ "Odjazd", 20 }
+			<< OutputBuffer::Left{ "Przyjazd", 20 }
+			<< OutputBuffer::Left{ "Data", 12 }
+			<< OutputBuffer::Left{ "Godziny", 13 }
+			<< OutputBuffer::Left{ "Wolne", 7 }
+			<< "Cena od" << "\n";
+		table << TABLE_RULE;
+
+		for (size_t i = 0; i < page.Ftrains.size(); i++) {
+			const Train* t = page.Ftrains[i];
+			table.left(t->getID(), 6)
+				<< OutputBuffer::Left{ t->getOrigin(), 20 }
+				<< OutputBuffer::Left{ t->getDestination(), 20 }
+				<< OutputBuffer::Left{ t->getDate(), 12 }
+				<< OutputBuffer::Left{ Train::formatTime(t->getDeparture()) + "-" + Train::formatTime(t->getArrival()), 13 };
+			table.left(t->getCapacity() - t->getOccupiedSeatsCount(), 7)
+				<< OutputBuffer::Fixed{ page.Fprices[i], 2 } << " PLN"
+				<< "\n";
+		}
+		table << TABLE_RULE;
+		table.writeTo(out);
+
+		// Wybór pociągu do rezerwacji lub przejście do innej strony
+		bool hasNext = offset + page.Ftrains.size() < page.Ftotal;
+		bool hasPrevious = offset > 0;
+		if (hasNext) out << "(-1 = nastepna strona)\n";
+		if (hasPrevious) out << "(-2 = poprzednia strona)\n";
+		tId = co_await readInt(io, "\nPodaj ID pociagu, aby zarezerwowac (0 aby anulowac): ");
+
+		if (tId == -1 && hasNext) offset += RESULTS_PER_PAGE;
+		else if (tId == -2 && hasPrevious) offset -= RESULTS_PER_PAGE;
+		else break;
 	}
 
-	// Wyświetlenie wyników wyszukiwania w formacie tabeli
-	std::cout << "\nZnaleziono " << displayList.size() << " pasujacych polaczen:\n";
-	std::cout << "-----------------------------------------------------------------------\n";
-	std::cout << std::left << std::setw(6) << "ID"
-		<< std::setw(20) << "Odjazd"
-		<< std::setw(20) << "Przyjazd"
-		<< std::setw(12) << "Data"
-		<< "Wolne" << "\n";
-	std::cout << "-----------------------------------------------------------------------\n";
-
-	for (const auto& t : displayList) {
-		std::cout << std::left << std::setw(6) << t.getID()
-			<< std::setw(20) << t.getOrigin()
-			<< std::setw(20) << t.getDestination()
-			<< std::setw(12) << t.getDate()
-			<< (t.getCapacity() - t.getOccupiedSeatsCount())
-			<< "\n";
+	if (tId <= 0) co_return false;
+
+	// Wyszukanie wybranego pociągu
+	Train* it = trains.find(tId);
+	if (it == nullptr) {
+		out << "\n[BLAD] Pociag o ID " << tId << " nie istnieje.\n";
+		co_return false;
 	}
-	std::cout << "-----------------------------------------------------------------------\n";
 
-	// Wybór pociągu do rezerwacji
-	int tId;
-	readInt("\nPodaj ID pociagu, aby zarezerwowac (0 aby anulowac): ", tId);
+	// Wyświetlenie mapy miejsc
+	it->displaySeats(out);
 
-	if (tId == 0) return;
+	// Klasy dostępne w pociągu (z układu wagonów) wraz z cenami i wolnymi miejscami
+	int first, last;
+	bool hasSecond = it->getLayout().classRange(BookingEngine::SECOND_CLASS, first, last);
+	bool hasFirst = it->getLayout().classRange(BookingEngine::FIRST_CLASS, first, last);
 
-	// Wyszukanie wybranego pociągu
-	auto it = std::find_if(trains.begin(), trains.end(), [tId](const Train& t) {
-		return t.getID() == tId;
-		});
-
-	if (it != trains.end()) {
-		// Wyświetlenie mapy miejsc
-		it->displaySeats();
-
-		// Wybór numeru miejsca
-		int seatNum;
-		readInt("Wybierz numer miejsca: ", seatNum);
-
-		if (it->isSeatFree(seatNum)) {
-
-			// Obliczenie ceny bazowej
-			double basePrice = 40.0 + (it->getDestination().length() * 5.0);
-
-			// Wybór klasy podróży
-			std::cout << "\n--- WYBOR KLASY PODROZY ---\n";
-			std::cout << "1. Druga Klasa (Standard) - Cena: " << std::fixed << std::setprecision(2) << basePrice << " PLN\n";
-			std::cout << "2. Pierwsza Klasa (Komfort) - Cena: " << (basePrice * 1.5) << " PLN (+50%)\n";
-
-			int classChoice;
-			readInt("Wybierz klase (1/2): ", classChoice);
-
-			// Obliczenie ceny końcowej w zależności od klasy
-			double finalPrice = basePrice;
-			if (classChoice == 2) {
-				finalPrice = basePrice * 1.5;
-			}
-
-			// Wyświetlenie podsumowania rezerwacji
-			std::cout << "\n--- PODSUMOWANIE REZERWACJI ---\n";
-			std::cout << "Pociag:  " << it->getOrigin() << " -> " << it->getDestination() << "\n";
-			std::cout << "Data:    " << it->getDate() << "\n";
-			std::cout << "Miejsce: " << seatNum << "\n";
-			std::cout << "Klasa:   " << (classChoice == 2 ? "Pierwsza" : "Druga") << "\n";
-			std::cout << "DO ZAPLATY: " << finalPrice << " PLN\n";
-			std::cout << "-------------------------------\n";
-
-			// Potwierdzenie zakupu
-			std::string confirm;
-			readLine("Czy potwierdzasz zakup? (t/n): ", confirm);
-
-			if (confirm == "t" || confirm == "T") {
-				// Rezerwacja miejsca w pociągu
-				if (it->reserveSeat(seatNum)) { 
-					// Generowanie nowego ID biletu
-					int newTicketId = (tickets.empty() ? 1 : tickets.back().getTicketId() + 1);
-
-					// Utworzenie nowego biletu
-					tickets.emplace_back(newTicketId, tId, get_Flogin(), seatNum, finalPrice);
-
-					std::cout << "\n[SUKCES] Platnosc przyjeta. Bilet zostal wygenerowany!\n";
-				}
-				else {
-					std::cout << "\n[BLAD] Ktos wlasnie zajal to miejsce. Sprobuj ponownie.\n";
-				}
-			}
-			else {
-				std::cout << "\nAnulowano rezerwacje.\n";
-			}
-		}
-		else {
-			std::cout << "\n[BLAD] Miejsce nr " << seatNum << " jest juz zajete.\n";
+	thread_local OutputBuffer screen;
+	screen << "\n--- WYBOR KLASY PODROZY ---\n";
+	if (hasSecond) {
+		screen << "1. Druga Klasa (Standard) - Cena: " << OutputBuffer::Fixed{ engine.quote(*it, BookingEngine::SECOND_CLASS), 2 }
+			<< " PLN, wolne miejsca: " << it->getFreeSeatsCount(BookingEngine::SECOND_CLASS) << "\n";
+	}
+	if (hasFirst) {
+		screen << "2. Pierwsza Klasa (Komfort) - Cena: " << OutputBuffer::Fixed{ engine.quote(*it, BookingEngine::FIRST_CLASS), 2 }
+			<< " PLN, wolne miejsca: " << it->getFreeSeatsCount(BookingEngine::FIRST_CLASS) << "\n";
+	}
+	screen.writeTo(out);
+
+	int classChoice = hasFirst ? BookingEngine::FIRST_CLASS : BookingEngine::SECOND_CLASS;
+	if (hasFirst && hasSecond) {
+		classChoice = co_await readInt(io, "Wybierz klase (1/2): ");
+		if (classChoice != BookingEngine::FIRST_CLASS) classChoice = BookingEngine::SECOND_CLASS;
+	}
+
+	// Wybór numeru miejsca (0 - pierwsze wolne miejsce w wybranej klasie)
+	int seatNum = co_await readInt(io, "Wybierz numer miejsca (0 = dowolne wolne): ");
+
+	// Pociąg mógł zostać usunięty przez inną sesję w czasie oczekiwania
+	it = trains.find(tId);
+	if (it == nullptr) {
+		out << "\n[BLAD] Pociag o ID " << tId << " nie istnieje.\n";
+		co_return false;
+	}
+	if (seatNum == 0) {
+		seatNum = it->findFreeSeat(classChoice);
+		if (seatNum == 0) {
+			out << "\n[BLAD] Brak wolnych miejsc w wybranej klasie.\n";
+			co_return false;
 		}
+		out << "Przydzielono miejsce nr " << seatNum << ".\n";
+	}
+	if (seatNum < 1 || seatNum > it->getCapacity()) {
+		out << "\n[BLAD] Nieprawidlowy numer miejsca (1-" << it->getCapacity() << ").\n";
+		co_return false;
+	}
+
+	if (it->getSeatClass(seatNum) != 0 && it->getSeatClass(seatNum) != classChoice) {
+		out << "\n[BLAD] Miejsce nr " << seatNum << " nalezy do innej klasy.\n";
+		co_return false;
+	}
+	if (!it->isSeatFree(seatNum)) {
+		out << "\n[BLAD] Miejsce nr " << seatNum << " jest juz zajete.\n";
+		co_return false;
+	}
+
+	double finalPrice = engine.quote(*it, classChoice);
+
+	// Wyświetlenie podsumowania rezerwacji
+	screen << "\n--- PODSUMOWANIE REZERWACJI ---\n";
+	screen << "Pociag:  " << it->getOrigin() << " -> " << it->getDestination() << "\n";
+	screen << "Data:    " << it->getDate() << "\n";
+	screen << "Miejsce: " << seatNum << "\n";
+	screen << "Klasa:   " << (classChoice == 2 ? "Pierwsza" : "Druga") << "\n";
+	screen << "DO ZAPLATY: " << OutputBuffer::Fixed{ finalPrice, 2 } << " PLN\n";
+	screen << "-------------------------------\n";
+	screen.writeTo(out);
+
+	// Potwierdzenie zakupu (rezerwację wykonuje silnik - miejsce mogło zostać zajęte w międzyczasie)
+	std::string confirm = co_await readLine(io, "Czy potwierdzasz zakup? (t/n): ");
+
+	if (confirm == "t" || confirm == "T") {
+		request.FtrainId = tId;
+		request.Fseat = seatNum;
+		request.FtravelClass = classChoice;
+		co_return true;
+	}
+	out << "\nAnulowano rezerwacje.\n";
+	co_return false;
+}
+
+/**
+ * @brief Wyszukuje i rezerwuje bilet na wybrany pociąg
+ * 
+ * Wybór pociągu i miejsca prowadzi chooseSeat, rezerwację wykonuje silnik
+ * (miejsce mogło zostać zajęte w międzyczasie).
+ * 
+ * @param io Kanał sesji
+ * @param engine Silnik rezerwacji (pociągi, bilety, generator ID)
+ */
+Task<void> Passenger::bookTicket(SessionIO& io, BookingEngine& engine) {
+	BookingRequest request;
+	if (!co_await chooseSeat(io, engine, request)) co_return;
+
+	// Rezerwacja miejsca i wystawienie biletu
+	BookingResult result = engine.book(get_FloginId(), request.FtrainId, request.Fseat, request.FtravelClass);
+	if (result.Fstatus == BookingStatus::OK) {
+		io.out() << "\n[SUKCES] Platnosc przyjeta. Bilet zostal wygenerowany!\n";
+	}
+	else if (result.Fstatus == BookingStatus::NOT_DURABLE) {
+		io.out() << "\n[BLAD] Nie udalo sie zapisac rezerwacji. Sprobuj ponownie pozniej.\n";
+	}
+	else if (result.Fstatus == BookingStatus::INVALID_SEAT) {
+		io.out() << "\n[BLAD] Nieprawidlowy numer miejsca.\n";
 	}
 	else {
-		std::cout << "\n[BLAD] Pociag o ID " << tId << " nie istnieje.\n";
+		io.out() << "\n[BLAD] Ktos wlasnie zajal to miejsce. Sprobuj ponownie.\n";
 	}
 }
 
@@ -256,18 +314,20 @@ void Passenger::bookTicket(std::vector<Train>& trains, std::vector<Ticket>& tick
  * Przeszukuje wszystkie bilety w systemie i wyświetla tylko te,
  * które należą do zalogowanego pasażera
  * 
- * @param tickets Wektor wszystkich biletów w systemie
+ * @param out Strumień wyjścia sesji
+ * @param tickets Magazyn wszystkich biletów w systemie
  */
-void Passenger::listMyTickets(const std::vector<Ticket>& tickets) const {
-	std::cout << "\n--- TWOJE AKTYWNE REZERWACJE ---\n";
+void Passenger::listMyTickets(std::ostream& out, const TicketStore& tickets) const {
+	thread_local OutputBuffer list;
+	list << "\n--- TWOJE AKTYWNE REZERWACJE ---\n";
 	bool found = false;
-	for (const auto& t : tickets) {
-		if (t.getPassengerLogin() == get_Flogin()) {
-			std::cout << t.toString() << "\n";
-			found = true;
-		}
-	}
-	if (!found) std::cout << "Nie posiadasz zadnych biletow.\n";
+	tickets.forEachOfPassenger(get_FloginId(), [&tickets, &found](size_t row) {
+		tickets.at(row).appendTo(list);
+		list << '\n';
+		found = true;
+	});
+	if (!found) list << "Nie posiadasz zadnych biletow.\n";
+	list.writeTo(out);
 }
 
 /**
@@ -279,46 +339,34 @@ void Passenger::listMyTickets(const std::vector<Ticket>& tickets) const {
  * - Usuwa bilet z systemu
  * - Zwalnia miejsce w pociągu
  * 
- * @param trains Wektor pociągów - miejsce zostanie zwolnione
- * @param tickets Wektor biletów - bilet zostanie usunięty
+ * @param io Kanał sesji
+ * @param engine Silnik rezerwacji - zwalnia miejsce i usuwa bilet
  */
-void Passenger::cancelBooking(std::vector<Train>& trains, std::vector<Ticket>& tickets) {
-	std::cout << "\n--- ANULOWANIE REZERWACJI ---\n";
+Task<void> Passenger::cancelBooking(SessionIO& io, BookingEngine& engine) {
+	std::ostream& out = io.out();
+	out << "\n--- ANULOWANIE REZERWACJI ---\n";
 
 	// Wyświetlenie aktywnych rezerwacji
-	listMyTickets(tickets);
+	listMyTickets(out, engine.tickets());
 
 	// Wybór biletu do anulowania
-	int ticketId;
-	readInt("\nPodaj ID biletu do anulowania (0 aby wrocic): ", ticketId);
-	if (ticketId == 0) return;
+	int ticketId = co_await readInt(io, "\nPodaj ID biletu do anulowania (0 aby wrocic): ");
+	if (ticketId == 0) co_return;
 
-	// Wyszukanie biletu należącego do pasażera
-	auto itTicket = std::find_if(tickets.begin(), tickets.end(),
-		[ticketId, this](const Ticket& t) {
-			return t.getTicketId() == ticketId && t.getPassengerLogin() == this->get_Flogin();
-		});
-
-	if (itTicket != tickets.end()) {
-		// Pobierz dane o pociągu i miejscu
-		int trainId = itTicket->getTrainId();
-		int seatNum = itTicket->getSeatNumber();
-
-		// Znajdź pociąg i zwolnij miejsce
-		auto itTrain = std::find_if(trains.begin(), trains.end(),
-			[trainId](const Train& t) { return t.getID() == trainId; });
-
-		if (itTrain != trains.end()) {
-			itTrain->cancelSeat(seatNum);
-			std::cout << "[INFO] Zwolniono miejsce nr " << seatNum << " w pociagu ID " << trainId << ".\n";
-		}
+	// Anulowanie biletu należącego do pasażera
+	BookingResult result = engine.cancel(get_FloginId(), ticketId);
 
-		// Usuń bilet z systemu
-		tickets.erase(itTicket);
-		std::cout << "[SUKCES] Rezerwacja zostala anulowana.\n";
+	if (result.Fstatus == BookingStatus::OK) {
+		if (engine.trains().find(result.FtrainId) != nullptr) {
+			out << "[INFO] Zwolniono miejsce nr " << result.Fseat << " w pociagu ID " << result.FtrainId << ".\n";
+		}
+		out << "[SUKCES] Rezerwacja zostala anulowana.\n";
+	}
+	else if (result.Fstatus == BookingStatus::NOT_DURABLE) {
+		out << "[BLAD] Nie udalo sie zapisac anulowania. Bilet pozostaje aktywny.\n";
 	}
 	else {
-		std::cout << "[BLAD] Nie znaleziono biletu o takim ID przypisanego do Ciebie.\n";
+		out << "[BLAD] Nie znaleziono biletu o takim ID przypisanego do Ciebie.\n";
 	}
 }
 
@@ -327,91 +375,110 @@ void Passenger::cancelBooking(std::vector<Train>& trains, std::vector<Ticket>& t
  * 
  * Funkcja oferuje dwie opcje modyfikacji:
  * 1. Zmiana numeru miejsca w tym samym pociągu
- * 2. Całkowite przebookowanie na inny pociąg (wymaga anulowania starej rezerwacji)
+ * 2. Przebookowanie na inny pociąg - nowa rezerwacja i anulowanie starej
+ *    wykonywane są jedną transakcją, więc przy niepowodzeniu stary bilet zostaje
  * 
- * @param trains Wektor pociągów w systemie
- * @param tickets Wektor biletów w systemie
+ * @param io Kanał sesji
+ * @param engine Silnik rezerwacji
  */
-void Passenger::modifyBooking(std::vector<Train>& trains, std::vector<Ticket>& tickets) {
-	std::cout << "\n--- MODYFIKACJA REZERWACJI ---\n";
-	listMyTickets(tickets);
+Task<void> Passenger::modifyBooking(SessionIO& io, BookingEngine& engine) {
+	std::ostream& out = io.out();
+	TrainCatalog& trains = engine.trains();
+	TicketStore& tickets = engine.tickets();
+
+	out << "\n--- MODYFIKACJA REZERWACJI ---\n";
+	listMyTickets(out, tickets);
 
 	// Wybór biletu do modyfikacji
-	int ticketId;
-	readInt("\nPodaj ID biletu do zmiany (0 aby wrocic): ", ticketId);
-	if (ticketId == 0) return;
+	int ticketId = co_await readInt(io, "\nPodaj ID biletu do zmiany (0 aby wrocic): ");
+	if (ticketId == 0) co_return;
 
 	// Wyszukanie biletu należącego do pasażera
-	auto itTicket = std::find_if(tickets.begin(), tickets.end(),
-		[ticketId, this](const Ticket& t) {
-			return t.getTicketId() == ticketId && t.getPassengerLogin() == this->get_Flogin();
-		});
-
-	if (itTicket == tickets.end()) {
-		std::cout << "[BLAD] Nieprawidlowe ID biletu.\n";
-		return;
+	size_t row = tickets.findRow(ticketId, get_FloginId());
+
+	if (row == TicketStore::NPOS) {
+		out << "[BLAD] Nieprawidlowe ID biletu.\n";
+		co_return;
 	}
 
 	// Znajdź pociąg powiązany z biletem
-	auto itTrain = std::find_if(trains.begin(), trains.end(),
-		[id = itTicket->getTrainId()](const Train& t) { return t.getID() == id; });
-
-	if (itTrain == trains.end()) {
-		std::cout << "[BLAD] Pociag z tej rezerwacji juz nie istnieje.\n";
-		return;
+	int trainId = tickets.trainId(row);
+	if (trains.find(trainId) == nullptr) {
+		out << "[BLAD] Pociag z tej rezerwacji juz nie istnieje.\n";
+		co_return;
 	}
 
 	// Wybór typu modyfikacji
-	std::cout << "\nCo chcesz zmienic?\n";
-	std::cout << "1. Zmien tylko miejsce (ten sam pociag)\n";
-	std::cout << "2. Zmien date/pociag (wymaga przebookowania)\n";
-	int choice;
-	readInt("Wybierz: ", choice);
+	out << "\nCo chcesz zmienic?\n";
+	out << "1. Zmien tylko miejsce (ten sam pociag)\n";
+	out << "2. Zmien date/pociag (wymaga przebookowania)\n";
+	int choice = co_await readInt(io, "Wybierz: ");
 
 	if (choice == 1) {
-		// Opcja 1: Zmiana miejsca w tym samym pociągu
-		std::cout << "Obecne miejsce: " << itTicket->getSeatNumber() << "\n";
-		itTrain->displaySeats(); 
+		// Opcja 1: Zmiana miejsca w tym samym pociągu (bilet i pociąg wyszukiwane ponownie po odpowiedzi)
+		row = tickets.findRow(ticketId, get_FloginId());
+		Train* itTrain = trains.find(trainId);
+		if (row == TicketStore::NPOS || itTrain == nullptr) {
+			out << "[BLAD] Nieprawidlowe ID biletu.\n";
+			co_return;
+		}
+		int currentSeat = tickets.seat(row);
+		out << "Obecne miejsce: " << currentSeat << "\n";
+		itTrain->displaySeats(out);
 
-		int newSeat;
-		readInt("Wybierz nowe miejsce: ", newSeat);
+		int newSeat = co_await readInt(io, "Wybierz nowe miejsce: ");
 
-		if (newSeat == itTicket->getSeatNumber()) {
-			std::cout << "To to samo miejsce. Anulowano zmiane.\n";
-			return;
+		if (newSeat == currentSeat) {
+			out << "To to samo miejsce. Anulowano zmiane.\n";
+			co_return;
 		}
 
-		if (itTrain->isSeatFree(newSeat)) {
-			// Zwolnij stare miejsce i zarezerwuj nowe
-			itTrain->cancelSeat(itTicket->getSeatNumber());
-			itTrain->reserveSeat(newSeat);
-			itTicket->setSeatNumber(newSeat);
-			std::cout << "[SUKCES] Zmieniono miejsce na " << newSeat << ".\n";
+		// Zmiana miejsca przez silnik (zapis w dzienniku operacji)
+		BookingResult result = engine.changeSeat(get_FloginId(), ticketId, newSeat);
+		if (result.Fstatus == BookingStatus::INVALID_SEAT) {
+			out << "[BLAD] Nieprawidlowy numer miejsca.\n";
+		}
+		else if (result.Fstatus == BookingStatus::CLASS_MISMATCH) {
+			out << "[BLAD] Nowe miejsce musi byc w tej samej klasie.\n";
+		}
+		else if (result.Fstatus == BookingStatus::OK) {
+			out << "[SUKCES] Zmieniono miejsce na " << newSeat << ".\n";
+		}
+		else if (result.Fstatus == BookingStatus::SEAT_TAKEN) {
+			out << "[BLAD] Wybrane miejsce jest zajete.\n";
+		}
+		else if (result.Fstatus == BookingStatus::NOT_DURABLE) {
+			out << "[BLAD] Nie udalo sie zapisac zmiany. Miejsce pozostaje bez zmian.\n";
 		}
 		else {
-			std::cout << "[BLAD] Wybrane miejsce jest zajete.\n";
+			out << "[BLAD] Nieprawidlowe ID biletu.\n";
 		}
 	}
 	else if (choice == 2) {
 		// Opcja 2: Przebookowanie na inny pociąg
-		std::cout << "Aby zmienic pociag, musimy anulowac obecny bilet i utworzyc nowy.\n";
-		std::string confirm;
-		readLine("Czy kontynuowac? (t/n): ", confirm);
-
-		if (confirm == "t" || confirm == "T") {
-			// Anuluj starą rezerwację
-			itTrain->cancelSeat(itTicket->getSeatNumber());
-			tickets.erase(itTicket);
-
-			// Przejdź do wyszukiwarki połączeń
-			std::cout << "Stara rezerwacja usunieta. Przechodzimy do wyszukiwarki...\n";
-			bookTicket(trains, tickets);
+		out << "Wybierz nowe polaczenie. Obecny bilet zostanie anulowany dopiero po udanej rezerwacji.\n";
+		BookingRequest request;
+		if (!co_await chooseSeat(io, engine, request)) co_return;
+
+		// Nowa rezerwacja i anulowanie starej - obie albo żadna
+		TransactionResult result = engine.transact(get_FloginId(), std::span<const int>(&ticketId, 1), std::span<const BookingRequest>(&request, 1));
+		if (result.Fstatus == BookingStatus::OK) {
+			out << "\n[SUKCES] Bilet " << ticketId << " zamieniono na bilet " << result.Fbookings.front().FticketId << ".\n";
+		}
+		else if (result.Fstatus == BookingStatus::TICKET_NOT_FOUND) {
+			out << "\n[BLAD] Bilet " << ticketId << " nie jest juz aktywny.\n";
+		}
+		else if (result.Fstatus == BookingStatus::NOT_DURABLE) {
+			out << "\n[BLAD] Nie udalo sie zapisac zmiany. Obecny bilet pozostaje bez zmian.\n";
+		}
+		else if (result.Fstatus == BookingStatus::INVALID_SEAT) {
+			out << "\n[BLAD] Nieprawidlowy numer miejsca. Obecny bilet pozostaje bez zmian.\n";
 		}
 		else {
-			std::cout << "Anulowano operacje.\n";
+			out << "\n[BLAD] Ktos wlasnie zajal to miejsce. Obecny bilet pozostaje bez zmian.\n";
 		}
 	}
 	else {
-		std::cout << "Niepoprawna opcja.\n";
+		out << "Niepoprawna opcja.\n";
 	}
-}
\ No newline at end of file
+}
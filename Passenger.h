@@ -6,7 +6,12 @@
 #pragma once
 #include "User.h"
 #include "Train.h"
+#include "TrainCatalog.h"
 #include "Ticket.h"
+#include "TicketStore.h"
+#include "BookingEngine.h"
+#include "SessionIO.h"
+#include "Task.h"
 #include <vector>
 #include <string>
 
@@ -17,22 +22,37 @@
  * Pasażer może przeglądać dostępne pociągi, rezerwować bilety,
  * przeglądać swoje rezerwacje, anulować je oraz modyfikować.
  * Dziedziczy po klasie User.
+ *
+ * Pozycje menu są korutynami - zawieszają się w oczekiwaniu na odpowiedź
+ * użytkownika (SessionIO), więc wiele sesji może działać w jednym wątku.
+ * Po każdej odpowiedzi pociąg i bilet wyszukiwane są ponownie, bo w czasie
+ * oczekiwania inna sesja mogła je zmienić.
  */
 class Passenger : public User
 {
+	/**
+	 * @brief Prowadzi pasażera przez wyszukiwanie połączenia, wybór klasy i miejsca
+	 * @param io Kanał sesji
+	 * @param engine Silnik rezerwacji
+	 * @param request Zmienna, do której zostanie zapisana wybrana rezerwacja
+	 * @return true jeśli pasażer potwierdził zakup
+	 */
+	Task<bool> chooseSeat(SessionIO& io, BookingEngine& engine, BookingRequest& request);
+
 public:
 	/**
 	 * @brief Konstruktor klasy Passenger
 	 * @param login Login pasażera
-	 * @param password Hasło pasażera
+	 * @param password Skrót hasła pasażera
 	 * @param id Unikalny identyfikator pasażera
 	 */
 	Passenger(std::string login, std::string password, int id);
 
 	/**
 	 * @brief Wyświetla menu dostępne dla pasażera
+	 * @param out Strumień wyjścia sesji
 	 */
-	void showMenu() override;
+	void showMenu(std::ostream& out) override;
 	
 	/**
 	 * @brief Zwraca typ użytkownika
@@ -46,34 +66,36 @@ public:
 	 * Funkcja oferuje różne opcje wyszukiwania pociągów (po stacji, dacie),
 	 * wyświetla dostępne miejsca i przeprowadza przez proces rezerwacji
 	 * 
-	 * @param trains Wektor pociągów dostępnych w systemie
-	 * @param tickets Wektor biletów - nowy bilet zostanie do niego dodany
+	 * @param io Kanał sesji
+	 * @param engine Silnik rezerwacji (pociągi, bilety, generator ID)
 	 */
-	void bookTicket(std::vector<Train>& trains, std::vector<Ticket>& tickets);
+	Task<void> bookTicket(SessionIO& io, BookingEngine& engine);
 	
 	/**
 	 * @brief Wyświetla wszystkie aktywne rezerwacje pasażera
-	 * @param tickets Wektor wszystkich biletów w systemie
+	 * @param out Strumień wyjścia sesji
+	 * @param tickets Magazyn wszystkich biletów w systemie
 	 */
-	void listMyTickets(const std::vector<Ticket>& tickets) const;
+	void listMyTickets(std::ostream& out, const TicketStore& tickets) const;
 
 	/**
 	 * @brief Anuluje wybraną rezerwację pasażera
 	 * 
 	 * Funkcja usuwa bilet z systemu i zwalnia miejsce w pociągu
 	 * 
-	 * @param trains Wektor pociągów - miejsce zostanie zwolnione
-	 * @param tickets Wektor biletów - bilet zostanie usunięty
+	 * @param io Kanał sesji
+	 * @param engine Silnik rezerwacji - zwalnia miejsce i usuwa bilet
 	 */
-	void cancelBooking(std::vector<Train>& trains, std::vector<Ticket>& tickets);
+	Task<void> cancelBooking(SessionIO& io, BookingEngine& engine);
 	
 	/**
 	 * @brief Modyfikuje wybraną rezerwację pasażera
 	 * 
-	 * Pasażer może zmienić numer miejsca lub całkowicie przebookować na inny pociąg
+	 * Pasażer może zmienić numer miejsca lub przebookować na inny pociąg
+	 * (stary bilet anulowany jest tylko wtedy, gdy nowa rezerwacja się uda)
 	 * 
-	 * @param trains Wektor pociągów
-	 * @param tickets Wektor biletów
+	 * @param io Kanał sesji
+	 * @param engine Silnik rezerwacji
 	 */
-	void modifyBooking(std::vector<Train>& trains, std::vector<Ticket>& tickets);
+	Task<void> modifyBooking(SessionIO& io, BookingEngine& engine);
 };
\ No newline at end of file
@@ -0,0 +1,266 @@
+/**
+ * @file PasswordHasher.cpp
+ * @brief Implementacja klasy PasswordHasher - SHA-256, HMAC i PBKDF2
+ */
+
+#include "PasswordHasher.h"
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <mutex>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <sys/random.h>
+#endif
+
+namespace {
+
+	using Digest = std::array<uint8_t, 32>;
+
+	const char* PREFIX = "pbkdf2-sha256$";
+	std::atomic<int> currentIterations{ PasswordHasher::DEFAULT_ITERATIONS };
+
+	/**
+	 * @brief Minimalna implementacja SHA-256 (FIPS 180-4)
+	 */
+	class Sha256 {
+	private:
+		static constexpr uint32_t K[64] = {
+			0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+			0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+			0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+			0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+			0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+			0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+			0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+			0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+		};
+
+		uint32_t Fstate[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+		uint8_t Fblock[64] = {};
+		size_t FblockLen = 0;
+		uint64_t FtotalLen = 0;
+
+		static uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+		void compress(const uint8_t* p) {
+			uint32_t w[64];
+			for (int i = 0; i < 16; i++) {
+				w[i] = (uint32_t(p[4 * i]) << 24) | (uint32_t(p[4 * i + 1]) << 16) | (uint32_t(p[4 * i + 2]) << 8) | uint32_t(p[4 * i + 3]);
+			}
+			for (int i = 16; i < 64; i++) {
+				uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+				uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+				w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+			}
+			uint32_t a = Fstate[0], b = Fstate[1], c = Fstate[2], d = Fstate[3];
+			uint32_t e = Fstate[4], f = Fstate[5], g = Fstate[6], h = Fstate[7];
+			for (int i = 0; i < 64; i++) {
+				uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+				uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+				h = g; g = f; f = e; e = d + t1;
+				d = c; c = b; b = a; a = t1 + t2;
+			}
+			Fstate[0] += a; Fstate[1] += b; Fstate[2] += c; Fstate[3] += d;
+			Fstate[4] += e; Fstate[5] += f; Fstate[6] += g; Fstate[7] += h;
+		}
+
+	public:
+		void update(const uint8_t* data, size_t len) {
+			FtotalLen += len;
+			while (len > 0) {
+				size_t take = std::min(len, 64 - FblockLen);
+				std::memcpy(Fblock + FblockLen, data, take);
+				FblockLen += take; data += take; len -= take;
+				if (FblockLen == 64) { compress(Fblock); FblockLen = 0; }
+			}
+		}
+
+		Digest finish() {
+			uint64_t bits = FtotalLen * 8;
+			uint8_t pad = 0x80;
+			update(&pad, 1);
+			uint8_t zero = 0;
+			while (FblockLen != 56) update(&zero, 1);
+			uint8_t lenBytes[8];
+			for (int i = 0; i < 8; i++) lenBytes[i] = uint8_t(bits >> (56 - 8 * i));
+			update(lenBytes, 8);
+
+			Digest out;
+			for (int i = 0; i < 8; i++) {
+				out[4 * i] = uint8_t(Fstate[i] >> 24); out[4 * i + 1] = uint8_t(Fstate[i] >> 16);
+				out[4 * i + 2] = uint8_t(Fstate[i] >> 8); out[4 * i + 3] = uint8_t(Fstate[i]);
+			}
+			return out;
+		}
+	};
+
+	/**
+	 * @brief HMAC-SHA256 z kluczem przygotowanym raz dla wielu wywołań (PBKDF2 liczy tysiące HMAC)
+	 */
+	class HmacSha256 {
+	private:
+		uint8_t Finner[64];
+		uint8_t Fouter[64];
+
+	public:
+		explicit HmacSha256(std::string_view key) {
+			uint8_t k[64] = {};
+			if (key.size() > 64) {
+				Sha256 h;
+				h.update(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+				Digest d = h.finish();
+				std::memcpy(k, d.data(), d.size());
+			}
+			else {
+				std::memcpy(k, key.data(), key.size());
+			}
+			for (int i = 0; i < 64; i++) { Finner[i] = k[i] ^ 0x36; Fouter[i] = k[i] ^ 0x5c; }
+		}
+
+		Digest mac(const uint8_t* data, size_t len) const {
+			Sha256 inner;
+			inner.update(Finner, 64);
+			inner.update(data, len);
+			Digest innerDigest = inner.finish();
+			Sha256 outer;
+			outer.update(Fouter, 64);
+			outer.update(innerDigest.data(), innerDigest.size());
+			return outer.finish();
+		}
+	};
+
+	/**
+	 * @brief PBKDF2-HMAC-SHA256 z jednym blokiem wyjścia (32 bajty)
+	 */
+	Digest pbkdf2(std::string_view password, const std::string& salt, int iterations) {
+		HmacSha256 prf(password);
+		std::string first = salt;
+		first.append("\x00\x00\x00\x01", 4);
+		Digest u = prf.mac(reinterpret_cast<const uint8_t*>(first.data()), first.size());
+		Digest result = u;
+		for (int i = 1; i < iterations; i++) {
+			u = prf.mac(u.data(), u.size());
+			for (size_t j = 0; j < result.size(); j++) result[j] ^= u[j];
+		}
+		return result;
+	}
+
+	std::string toHex(const uint8_t* data, size_t len) {
+		static const char digits[] = "0123456789abcdef";
+		std::string out(len * 2, '0');
+		for (size_t i = 0; i < len; i++) {
+			out[2 * i] = digits[data[i] >> 4];
+			out[2 * i + 1] = digits[data[i] & 0x0f];
+		}
+		return out;
+	}
+}
+
+/**
+ * @brief Wypełnia bufor bajtami z kryptograficznego źródła systemu
+ *
+ * Linux: getrandom(2), a gdy jest niedostępne - /dev/urandom. W pozostałych
+ * przypadkach std::random_device (na Windows oparte na systemowym CSPRNG),
+ * osobne losowanie dla każdego bajtu.
+ *
+ * @param out Bufor
+ * @param size Liczba bajtów
+ */
+static void systemRandom(uint8_t* out, size_t size) {
+#ifdef __linux__
+	size_t filled = 0;
+	while (filled < size) {
+		ssize_t got = getrandom(out + filled, size - filled, 0);
+		if (got < 0 && errno == EINTR) continue;
+		if (got <= 0) break;
+		filled += static_cast<size_t>(got);
+	}
+	if (filled < size) {
+		std::ifstream urandom("/dev/urandom", std::ios::binary);
+		if (urandom.read(reinterpret_cast<char*>(out + filled), static_cast<std::streamsize>(size - filled))) return;
+	}
+	else {
+		return;
+	}
+#endif
+	static std::mutex deviceMutex;
+	static std::random_device device;
+	std::lock_guard<std::mutex> lock(deviceMutex);
+	for (size_t i = 0; i < size; i++) out[i] = static_cast<uint8_t>(device() & 0xff);
+}
+
+/**
+ * @brief Generuje losowy napis szesnastkowy
+ *
+ * Bajty pochodzą z kryptograficznego źródła systemu, więc tokenów sesji
+ * i soli nie da się przewidzieć na podstawie wcześniej zaobserwowanych wartości.
+ *
+ * @param bytes Liczba losowych bajtów
+ * @return Napis szesnastkowy
+ */
+std::string PasswordHasher::randomHex(size_t bytes) {
+	std::vector<uint8_t> raw(bytes);
+	systemRandom(raw.data(), raw.size());
+	return toHex(raw.data(), raw.size());
+}
+
+/**
+ * @brief Tworzy solony skrót hasła z bieżącym kosztem
+ * @param password Hasło jawnym tekstem
+ * @return Zakodowany skrót
+ */
+std::string PasswordHasher::hash(std::string_view password) {
+	int iterations = currentIterations.load();
+	std::string salt = randomHex(16);
+	Digest d = pbkdf2(password, salt, iterations);
+	return PREFIX + std::to_string(iterations) + "$" + salt + "$" + toHex(d.data(), d.size());
+}
+
+/**
+ * @brief Sprawdza hasło względem zapisanego skrótu
+ *
+ * Koszt i sól odczytywane są z zapisanego napisu. Porównanie skrótów
+ * wykonywane jest w stałym czasie.
+ *
+ * @param password Hasło jawnym tekstem
+ * @param stored Zapisany skrót
+ * @return true jeśli hasło jest poprawne
+ */
+bool PasswordHasher::verify(std::string_view password, std::string_view stored) {
+	if (!isHashed(stored)) return false;
+
+	std::string_view rest = stored.substr(std::strlen(PREFIX));
+	size_t p1 = rest.find('$');
+	if (p1 == std::string_view::npos) return false;
+	size_t p2 = rest.find('$', p1 + 1);
+	if (p2 == std::string_view::npos) return false;
+
+	int iterations = 0;
+	for (char c : rest.substr(0, p1)) {
+		if (c < '0' || c > '9' || iterations > 100000000) return false;
+		iterations = iterations * 10 + (c - '0');
+	}
+	if (iterations < 1) return false;
+
+	std::string salt(rest.substr(p1 + 1, p2 - p1 - 1));
+	std::string_view expected = rest.substr(p2 + 1);
+
+	Digest d = pbkdf2(password, salt, iterations);
+	std::string actual = toHex(d.data(), d.size());
+	if (actual.size() != expected.size()) return false;
+
+	unsigned char diff = 0;
+	for (size_t i = 0; i < actual.size(); i++) diff |= static_cast<unsigned char>(actual[i] ^ expected[i]);
+	return diff == 0;
+}
+
+// Rozpoznawanie formatu i konfiguracja kosztu
+bool PasswordHasher::isHashed(std::string_view stored) { return stored.rfind(PREFIX, 0) == 0; }
+void PasswordHasher::setIterations(int iterations) { currentIterations.store(iterations < 1 ? 1 : iterations); }
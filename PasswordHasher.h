@@ -0,0 +1,59 @@
+/**
+ * @file PasswordHasher.h
+ * @brief Deklaracja klasy PasswordHasher - solone skróty haseł (PBKDF2-HMAC-SHA256)
+ */
+
+#pragma once
+#include <string>
+#include <string_view>
+
+/**
+ * @class PasswordHasher
+ * @brief Tworzy i weryfikuje solone skróty haseł
+ *
+ * Hasła nie są przechowywane jawnym tekstem. Zapisywany jest napis postaci:
+ * pbkdf2-sha256$<iteracje>$<sól hex>$<skrót hex>
+ *
+ * Liczba iteracji (koszt) zapisywana jest razem ze skrótem, więc zmiana kosztu
+ * dotyczy tylko nowo tworzonych skrótów, a stare nadal dają się zweryfikować.
+ */
+class PasswordHasher
+{
+public:
+	static constexpr int DEFAULT_ITERATIONS = 10000;   ///< Domyślny koszt (liczba iteracji PBKDF2)
+
+	/**
+	 * @brief Tworzy solony skrót hasła
+	 * @param password Hasło jawnym tekstem
+	 * @return Zakodowany skrót gotowy do zapisania
+	 */
+	static std::string hash(std::string_view password);
+
+	/**
+	 * @brief Sprawdza hasło względem zapisanego skrótu
+	 * @param password Hasło jawnym tekstem
+	 * @param stored Zapisany skrót (wynik hash())
+	 * @return true jeśli hasło jest poprawne
+	 */
+	static bool verify(std::string_view password, std::string_view stored);
+
+	/**
+	 * @brief Sprawdza czy napis jest skrótem w formacie PasswordHasher
+	 * @param stored Sprawdzany napis
+	 * @return true jeśli to skrót, false jeśli np. stare hasło jawnym tekstem
+	 */
+	static bool isHashed(std::string_view stored);
+
+	/**
+	 * @brief Ustawia koszt (liczbę iteracji) dla nowo tworzonych skrótów
+	 * @param iterations Liczba iteracji (minimum 1)
+	 */
+	static void setIterations(int iterations);
+
+	/**
+	 * @brief Generuje losowy napis szesnastkowy z kryptograficznego źródła systemu (np. sól lub token sesji)
+	 * @param bytes Liczba losowych bajtów
+	 * @return Napis o długości 2 * bytes
+	 */
+	static std::string randomHex(size_t bytes);
+};
@@ -0,0 +1,250 @@
+/**
+ * @file PricingEngine.cpp
+ * @brief Implementacja klasy PricingEngine - tabele cen i wycena biletów
+ */
+
+#include "PricingEngine.h"
+#include "StringPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+	/**
+	 * @brief Mnożnik klasy podróży
+	 * @param travelClass Klasa (1 lub 2)
+	 * @return Mnożnik ceny
+	 */
+	double classFactor(int travelClass) {
+		return travelClass == 2 ? 1.5 : 1.0;
+	}
+
+	/**
+	 * @brief Mnożnik zapełnienia - do połowy miejsc cena bazowa, potem liniowo do +35%
+	 * @param bucket Przedział zapełnienia (co 5%)
+	 * @return Mnożnik ceny
+	 */
+	double loadFactor(int bucket) {
+		double load = bucket * 0.05;
+		return 1.0 + std::max(0.0, load - 0.5) * 0.7;
+	}
+
+	/**
+	 * @brief Mnożnik dni do odjazdu - drożej w ostatniej chwili, taniej z wyprzedzeniem
+	 * @param days Liczba dni do odjazdu
+	 * @return Mnożnik ceny
+	 */
+	double dayFactor(int days) {
+		if (days <= 1) return 1.30;
+		if (days <= 3) return 1.20;
+		if (days <= 7) return 1.10;
+		if (days <= 30) return 1.00;
+		return 0.90;
+	}
+
+	/// Liczba dni przyjmowana, gdy data pociągu jest nieczytelna (mnożnik 1.0)
+	constexpr int UNKNOWN_DAYS = 30;
+
+	/// Liczba cen liczonych w jednym przebiegu quoteBatch (bufory na stosie)
+	constexpr size_t BATCH_CHUNK = 64;
+}
+
+/**
+ * @brief Konstruktor klasy PricingEngine
+ *
+ * Buduje płaską tablicę mnożników [klasa][zapełnienie][dni].
+ */
+PricingEngine::PricingEngine()
+	: Fmultipliers(static_cast<size_t>(CLASS_COUNT) * LOAD_BUCKETS * DAY_BUCKETS) {
+	for (int travelClass = 0; travelClass < CLASS_COUNT; travelClass++) {
+		for (int load = 0; load < LOAD_BUCKETS; load++) {
+			for (int days = 0; days < DAY_BUCKETS; days++) {
+				size_t index = (static_cast<size_t>(travelClass) * LOAD_BUCKETS + load) * DAY_BUCKETS + days;
+				Fmultipliers[index] = classFactor(travelClass) * loadFactor(load) * dayFactor(days);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Dodaje lub zmienia odległość między stacjami (w obu kierunkach)
+ * @param origin Stacja początkowa
+ * @param destination Stacja docelowa
+ * @param distance Odległość w kilometrach
+ */
+void PricingEngine::setDistance(std::string_view origin, std::string_view destination, double distance) {
+	uint32_t originId = StringPool::stations().intern(origin);
+	uint32_t destinationId = StringPool::stations().intern(destination);
+
+	for (Route route : { Route{ originId, destinationId, distance }, Route{ destinationId, originId, distance } }) {
+		auto it = std::find_if(Froutes.begin(), Froutes.end(), [&route](const Route& r) {
+			return r.ForiginId == route.ForiginId && r.FdestinationId == route.FdestinationId;
+		});
+		if (it != Froutes.end()) it->Fdistance = distance;
+		else Froutes.push_back(route);
+	}
+}
+
+/**
+ * @brief Kompiluje tabelę odległości do płaskiej macierzy opłat
+ *
+ * Macierz obejmuje tylko stacje występujące w tabeli odległości, więc jej
+ * rozmiar nie zależy od liczby stacji w rozkładzie. Pozostałe stacje
+ * wyceniane są według dotychczasowego wzoru.
+ */
+void PricingEngine::compile() {
+	uint32_t maxStation = 0;
+	for (const Route& route : Froutes) maxStation = std::max({ maxStation, route.ForiginId, route.FdestinationId });
+
+	FfareRows.assign(Froutes.empty() ? 0 : static_cast<size_t>(maxStation) + 1, NO_ROW);
+	FfareStations = 0;
+	for (const Route& route : Froutes) {
+		for (uint32_t station : { route.ForiginId, route.FdestinationId }) {
+			if (FfareRows[station] == NO_ROW) FfareRows[station] = FfareStations++;
+		}
+	}
+
+	FrouteFares.assign(static_cast<size_t>(FfareStations) * FfareStations, 0.0);
+	for (const Route& route : Froutes) {
+		FrouteFares[static_cast<size_t>(FfareRows[route.ForiginId]) * FfareStations + FfareRows[route.FdestinationId]] =
+			BASE_FARE + RATE_PER_KM * route.Fdistance;
+	}
+}
+
+/**
+ * @brief Ustala datę, względem której liczone są dni do odjazdu
+ * @param date Data w formacie RRRR-MM-DD
+ * @return true jeśli data ma poprawny format
+ */
+bool PricingEngine::setToday(std::string_view date) {
+	return dayNumber(date, FfixedToday);
+}
+
+/**
+ * @brief Zwraca datę, względem której liczone są dni do odjazdu
+ *
+ * Bez ustalonej daty odczytuje zegar systemowy przy każdym wywołaniu -
+ * nie przechowuje stanu, więc jest bezpieczna przy wycenach z wielu wątków.
+ *
+ * @return Numer dnia od 1970-01-01
+ */
+int PricingEngine::today() const {
+	if (FfixedToday != CLOCK_TODAY) return FfixedToday;
+	return static_cast<int>(std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now()).time_since_epoch().count());
+}
+
+/**
+ * @brief Zwraca opłatę za trasę pociągu
+ * @param train Pociąg
+ * @return Opłata w PLN przed zastosowaniem mnożników
+ */
+double PricingEngine::routeFare(const Train& train) const {
+	uint32_t origin = train.getOriginId();
+	uint32_t destination = train.getDestinationId();
+	if (origin < FfareRows.size() && destination < FfareRows.size()) {
+		uint32_t row = FfareRows[origin];
+		uint32_t column = FfareRows[destination];
+		if (row != NO_ROW && column != NO_ROW) {
+			double fare = FrouteFares[static_cast<size_t>(row) * FfareStations + column];
+			if (fare > 0.0) return fare;
+		}
+	}
+	// Trasa bez znanej odległości - dotychczasowa cena bazowa
+	return 40.0 + (train.getDestination().length() * 5.0);
+}
+
+/**
+ * @brief Zwraca indeks mnożnika dla pociągu i klasy
+ * @param train Pociąg
+ * @param travelClass Klasa podróży
+ * @param today Dzisiejsza data jako numer dnia od 1970-01-01
+ * @return Indeks w tablicy Fmultipliers
+ */
+size_t PricingEngine::multiplierIndex(const Train& train, int travelClass, int today) const {
+	size_t classIndex = travelClass == 2 ? 2 : 1;
+
+	// Zapełnienie w przedziałach co 5% (licznik utrzymywany razem z mapą bitową)
+	size_t load = static_cast<size_t>(train.getOccupiedSeatsCount()) * (LOAD_BUCKETS - 1) / train.getCapacity();
+
+	int departure;
+	int days = dayNumber(train.getDate(), departure) ? departure - today : UNKNOWN_DAYS;
+	days = std::clamp(days, 0, DAY_BUCKETS - 1);
+
+	return (classIndex * LOAD_BUCKETS + load) * DAY_BUCKETS + static_cast<size_t>(days);
+}
+
+/**
+ * @brief Wylicza cenę biletu
+ * @param train Pociąg
+ * @param travelClass Klasa podróży
+ * @return Cena w PLN zaokrąglona do grosza
+ */
+double PricingEngine::quote(const Train& train, int travelClass) const {
+	return std::round(routeFare(train) * Fmultipliers[multiplierIndex(train, travelClass, today())] * 100.0) / 100.0;
+}
+
+/**
+ * @brief Wylicza ceny dla całej strony wyników wyszukiwania
+ * @param trains Pociągi na stronie wyników
+ * @param travelClass Klasa podróży
+ * @param prices Tablica na ceny
+ */
+void PricingEngine::quoteBatch(std::span<const Train* const> trains, int travelClass, std::span<double> prices) const {
+	double fares[BATCH_CHUNK];
+	double factors[BATCH_CHUNK];
+	int day = today();   // jedna data dla całej strony wyników
+
+	for (size_t start = 0; start < trains.size(); start += BATCH_CHUNK) {
+		size_t count = std::min(BATCH_CHUNK, trains.size() - start);
+
+		// Zebranie opłat i mnożników z tablic
+		for (size_t i = 0; i < count; i++) {
+			const Train& train = *trains[start + i];
+			fares[i] = routeFare(train);
+			factors[i] = Fmultipliers[multiplierIndex(train, travelClass, day)];
+		}
+
+		// Ceny końcowe - pętla bez rozgałęzień
+		for (size_t i = 0; i < count; i++) {
+			prices[start + i] = std::round(fares[i] * factors[i] * 100.0) / 100.0;
+		}
+	}
+}
+
+/**
+ * @brief Zwraca liczbę tras w tabeli odległości
+ * @return Liczba tras
+ */
+size_t PricingEngine::routeCount() const {
+	return Froutes.size();
+}
+
+/**
+ * @brief Zamienia datę na numer dnia od 1970-01-01
+ * @param date Data w formacie RRRR-MM-DD
+ * @param day Zmienna, do której zostanie zapisany numer dnia
+ * @return true jeśli data ma poprawny format
+ */
+bool PricingEngine::dayNumber(std::string_view date, int& day) {
+	if (date.size() != 10 || date[4] != '-' || date[7] != '-') return false;
+
+	int parts[3] = { 0, 0, 0 };
+	const int starts[3] = { 0, 5, 8 };
+	const int lengths[3] = { 4, 2, 2 };
+	for (int p = 0; p < 3; p++) {
+		for (int i = 0; i < lengths[p]; i++) {
+			char c = date[starts[p] + i];
+			if (c < '0' || c > '9') return false;
+			parts[p] = parts[p] * 10 + (c - '0');
+		}
+	}
+
+	std::chrono::year_month_day ymd{ std::chrono::year(parts[0]),
+		std::chrono::month(static_cast<unsigned>(parts[1])),
+		std::chrono::day(static_cast<unsigned>(parts[2])) };
+	if (!ymd.ok()) return false;
+
+	day = static_cast<int>(std::chrono::sys_days(ymd).time_since_epoch().count());
+	return true;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file PricingEngine.h
+ * @brief Deklaracja klasy PricingEngine - dynamiczne ceny biletów
+ */
+
+#pragma once
+#include "Train.h"
+#include <vector>
+#include <string_view>
+#include <span>
+#include <cstdint>
+#include <climits>
+
+/**
+ * @class PricingEngine
+ * @brief Wylicza ceny biletów z tabel odległości i mnożników
+ *
+ * Cena = opłata za trasę * mnożnik(klasa, zapełnienie pociągu, dni do odjazdu).
+ *
+ * - Opłata za trasę: BASE_FARE + RATE_PER_KM * odległość z tabeli tras.
+ *   Dla tras bez znanej odległości stosowana jest dotychczasowa cena
+ *   (40 PLN + 5 PLN za znak nazwy stacji docelowej).
+ * - Zapełnienie liczone jest z licznika zajętych miejsc mapy bitowej pociągu.
+ *
+ * Tabele kompilowane są (compile()) do płaskich tablic: macierzy opłat
+ * [stacja początkowa][stacja docelowa] obejmującej tylko stacje z tabeli
+ * odległości (identyfikatory z puli stacji przekładane są na wiersze macierzy
+ * tablicą FfareRows) oraz jednej tablicy mnożników [klasa][zapełnienie][dni].
+ * Wycena to kilka odczytów z tablic i jedno mnożenie - bez alokacji i bez
+ * rozgałęzień zależnych od danych poza sprawdzeniem zakresu.
+ *
+ * Dni do odjazdu liczone są względem daty odczytywanej z zegara systemowego
+ * przy każdej wycenie (chyba że datę ustalono przez setToday()), więc
+ * długo działający serwer po północy wycenia już według nowego dnia.
+ */
+class PricingEngine
+{
+public:
+	static constexpr double BASE_FARE = 10.0;         ///< Opłata stała za bilet (PLN)
+	static constexpr double RATE_PER_KM = 0.22;       ///< Stawka za kilometr (PLN)
+	static constexpr int CLASS_COUNT = 3;             ///< Klasy 0 (nieużywana), 1 i 2
+	static constexpr int LOAD_BUCKETS = 21;           ///< Przedziały zapełnienia co 5%
+	static constexpr int DAY_BUCKETS = 91;            ///< Dni do odjazdu 0..90 (dalsze liczone jak 90)
+
+private:
+	/**
+	 * @struct Route
+	 * @brief Odległość między dwiema stacjami (wpis tabeli źródłowej)
+	 */
+	struct Route {
+		uint32_t ForiginId;
+		uint32_t FdestinationId;
+		double Fdistance;
+	};
+
+	static constexpr uint32_t NO_ROW = UINT32_MAX;       ///< Stacja spoza tabeli odległości
+	static constexpr int CLOCK_TODAY = INT32_MIN;       ///< Data bieżąca z zegara systemowego
+
+	std::vector<Route> Froutes;              ///< Tabela odległości (źródło kompilacji)
+	std::vector<uint32_t> FfareRows;         ///< Identyfikator stacji z puli -> wiersz macierzy (NO_ROW = brak tras)
+	std::vector<double> FrouteFares;         ///< Macierz opłat za trasę (0 = brak odległości)
+	uint32_t FfareStations = 0;              ///< Wymiar macierzy (liczba stacji z tabeli odległości)
+	std::vector<double> Fmultipliers;        ///< Mnożniki [klasa][zapełnienie][dni]
+	int FfixedToday = CLOCK_TODAY;           ///< Data ustalona przez setToday() jako numer dnia od 1970-01-01
+
+	/**
+	 * @brief Zwraca datę, względem której liczone są dni do odjazdu
+	 * @return Numer dnia od 1970-01-01 (ustalony lub bieżący z zegara)
+	 */
+	int today() const;
+
+	/**
+	 * @brief Zwraca opłatę za trasę pociągu
+	 * @param train Pociąg
+	 * @return Opłata w PLN przed zastosowaniem mnożników
+	 */
+	double routeFare(const Train& train) const;
+
+	/**
+	 * @brief Zwraca indeks mnożnika dla pociągu i klasy
+	 * @param train Pociąg
+	 * @param travelClass Klasa podróży
+	 * @param today Dzisiejsza data jako numer dnia od 1970-01-01
+	 * @return Indeks w tablicy Fmultipliers
+	 */
+	size_t multiplierIndex(const Train& train, int travelClass, int today) const;
+
+public:
+	/**
+	 * @brief Konstruktor klasy PricingEngine - buduje tablicę mnożników
+	 */
+	PricingEngine();
+
+	/**
+	 * @brief Dodaje lub zmienia odległość między stacjami (w obu kierunkach)
+	 *
+	 * Zmiana zaczyna obowiązywać po wywołaniu compile().
+	 *
+	 * @param origin Stacja początkowa
+	 * @param destination Stacja docelowa
+	 * @param distance Odległość w kilometrach
+	 */
+	void setDistance(std::string_view origin, std::string_view destination, double distance);
+
+	/**
+	 * @brief Kompiluje tabelę odległości do płaskiej macierzy opłat
+	 */
+	void compile();
+
+	/**
+	 * @brief Ustala datę, względem której liczone są dni do odjazdu (zamiast zegara systemowego)
+	 * @param date Data w formacie RRRR-MM-DD
+	 * @return true jeśli data ma poprawny format
+	 */
+	bool setToday(std::string_view date);
+
+	/**
+	 * @brief Wylicza cenę biletu
+	 * @param train Pociąg
+	 * @param travelClass Klasa podróży (1 lub 2)
+	 * @return Cena w PLN zaokrąglona do grosza
+	 */
+	double quote(const Train& train, int travelClass) const;
+
+	/**
+	 * @brief Wylicza ceny dla całej strony wyników wyszukiwania
+	 *
+	 * Najpierw zbierane są opłaty i indeksy mnożników, a potem ceny liczone
+	 * są jedną pętlą bez rozgałęzień, którą kompilator może zwektoryzować.
+	 *
+	 * @param trains Pociągi na stronie wyników
+	 * @param travelClass Klasa podróży
+	 * @param prices Tablica na ceny (co najmniej trains.size() elementów)
+	 */
+	void quoteBatch(std::span<const Train* const> trains, int travelClass, std::span<double> prices) const;
+
+	/**
+	 * @brief Zwraca liczbę tras w tabeli odległości
+	 * @return Liczba tras (każdy kierunek osobno)
+	 */
+	size_t routeCount() const;
+
+	/**
+	 * @brief Zamienia datę na numer dnia od 1970-01-01
+	 * @param date Data w formacie RRRR-MM-DD
+	 * @param day Zmienna, do której zostanie zapisany numer dnia
+	 * @return true jeśli data ma poprawny format
+	 */
+	static bool dayNumber(std::string_view date, int& day);
+};
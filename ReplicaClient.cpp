@@ -0,0 +1,191 @@
+/**
+ * @file ReplicaClient.cpp
+ * @brief Implementacja klasy ReplicaClient - odbiór i stosowanie strumienia dziennika
+ */
+
+#include "ReplicaClient.h"
+#include "ReplicationServer.h"
+#include "DataManager.h"
+#include <charconv>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Konstruktor klasy ReplicaClient
+ * @param path Ścieżka gniazda procesu głównego
+ * @param trains Katalog pociągów
+ * @param tickets Magazyn biletów
+ * @param users Konta użytkowników
+ * @param applied Ostatnia operacja odzwierciedlona w danych
+ */
+ReplicaClient::ReplicaClient(std::string path, TrainCatalog& trains, TicketStore& tickets, UserDirectory& users, uint64_t applied)
+	: Fpath(std::move(path)), Ftrains(trains), Ftickets(tickets), Fusers(users), Fstopping(false) {
+	Fstatus.Fapplied = applied;
+	Fstatus.FprimarySequence = applied;
+}
+
+/**
+ * @brief Destruktor - kończy wątek odbierający
+ */
+ReplicaClient::~ReplicaClient() {
+	Fstopping = true;
+	if (Freader.joinable()) Freader.join();
+}
+
+/**
+ * @brief Uruchamia wątek odbierający strumień dziennika
+ */
+void ReplicaClient::start() {
+#ifdef _WIN32
+	std::cerr << "Blad: Replikacja wymaga gniazd domeny uniksowej (Linux)." << std::endl;
+#else
+	Freader = std::thread(&ReplicaClient::readLoop, this);
+#endif
+}
+
+/**
+ * @brief Zwraca blokadę danych repliki
+ * @return Blokada
+ */
+std::mutex& ReplicaClient::stateMutex() const { return Fmutex; }
+
+/**
+ * @brief Zwraca stan replikacji
+ * @return Stan
+ */
+ReplicationStatus ReplicaClient::status() const { return Fstatus; }
+
+/**
+ * @brief Przetwarza jedną linię strumienia (pod blokadą danych repliki)
+ *
+ * Linie dziennika gromadzone są do końca transakcji, znacznik "@" aktualizuje
+ * numer operacji procesu głównego i opóźnienie.
+ *
+ * @param line Linia bez znaku końca linii
+ * @return false jeśli linia jest uszkodzona lub replika musi wczytać dane od nowa
+ */
+bool ReplicaClient::handle(const std::string& line) {
+	// Brakujących operacji nie ma już w dzienniku - stan z migawek, potem ponowne połączenie
+	if (line == "ERR resync") {
+		reload();
+		return false;
+	}
+
+	if (line.starts_with("@ ")) {
+		std::istringstream fields(line.substr(2));
+		uint64_t sequence = 0;
+		int64_t written = 0;
+		if (!(fields >> sequence >> written)) return false;
+		Fstatus.FprimarySequence = sequence;
+		if (Fstatus.Fapplied >= sequence) {
+			Fstatus.FlagMicros = ReplicationServer::nowMicros() - written;
+			Fstatus.FmaxLagMicros = std::max(Fstatus.FmaxLagMicros, Fstatus.FlagMicros);
+		}
+		return true;
+	}
+
+	Journal::Record record;
+	bool continued = false;
+	if (!Journal::parse(line, record, continued)) return false;
+	Fgroup.push_back(std::move(record));
+	if (continued) return true;
+
+	// Ostatnia linia transakcji - stosowana jest cała grupa
+	for (const Journal::Record& complete : Fgroup) {
+		if (complete.Fsequence <= Fstatus.Fapplied) continue;
+		if (complete.Foperation == Journal::Operation::RELOAD) {
+			reload();
+			continue;
+		}
+		Train* train = DataManager::apply(complete, &Ftrains, &Ftickets, std::cerr);
+		// Zmiana dostępności - wyniki wyszukiwania tej trasy są nieaktualne
+		if (train != nullptr) Ftrains.touchRoute(*train);
+		Fstatus.Fapplied = complete.Fsequence;
+	}
+	Fgroup.clear();
+	return true;
+}
+
+/**
+ * @brief Wczytuje migawki i dziennik procesu głównego od nowa
+ *
+ * Pociągi i bilety wczytywane są do tych samych obiektów (silnik i sesje
+ * repliki trzymają do nich referencje); konta tylko dopisywane - istniejące
+ * loginy są pomijane. Komunikaty trafiają na std::cerr, bo std::cout
+ * to odpowiedzi repliki.
+ */
+void ReplicaClient::reload() {
+	DataManager dm(std::cerr);
+	Ftrains.clear();
+	Ftickets.clear();
+	dm.loadUsers(Fusers);
+	dm.loadTrains(Ftrains);
+	dm.loadTickets(Ftickets);
+	Fstatus.Fapplied = dm.recover(Ftrains, Ftickets, true);
+	std::cerr << "Replika: wczytano migawki procesu glownego (operacja " << Fstatus.Fapplied << ")" << std::endl;
+}
+
+/**
+ * @brief Pętla wątku: połączenie, odbiór linii, ponowne połączenie po zerwaniu
+ */
+void ReplicaClient::readLoop() {
+#ifndef _WIN32
+	while (!Fstopping) {
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		Fpath.copy(address.sun_path, std::min(Fpath.size(), sizeof(address.sun_path) - 1));
+
+		int primary = socket(AF_UNIX, SOCK_STREAM, 0);
+		uint64_t since;
+		{
+			std::lock_guard<std::mutex> lock(Fmutex);
+			since = Fstatus.Fapplied;
+			Fgroup.clear();
+		}
+		std::string hello = "SINCE " + std::to_string(since) + "\n";
+		if (primary < 0 || connect(primary, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+			send(primary, hello.data(), hello.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(hello.size())) {
+			if (primary >= 0) close(primary);
+			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+			continue;
+		}
+		{
+			std::lock_guard<std::mutex> lock(Fmutex);
+			Fstatus.Fconnected = true;
+		}
+
+		// Odbiór do zerwania połączenia lub uszkodzonej linii
+		std::string buffer;
+		char chunk[65536];
+		bool healthy = true;
+		while (healthy && !Fstopping) {
+			pollfd readable{ primary, POLLIN, 0 };
+			if (poll(&readable, 1, 200) <= 0) continue;
+			ssize_t received = recv(primary, chunk, sizeof(chunk), 0);
+			if (received < 0 && errno == EINTR) continue;
+			if (received <= 0) break;
+			buffer.append(chunk, static_cast<size_t>(received));
+
+			std::lock_guard<std::mutex> lock(Fmutex);
+			size_t start = 0;
+			for (size_t end; healthy && (end = buffer.find('\n', start)) != std::string::npos; start = end + 1) {
+				healthy = handle(buffer.substr(start, end - start));
+			}
+			buffer.erase(0, start);
+		}
+
+		close(primary);
+		std::lock_guard<std::mutex> lock(Fmutex);
+		Fstatus.Fconnected = false;
+	}
+#endif
+}
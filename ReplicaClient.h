@@ -0,0 +1,116 @@
+/**
+ * @file ReplicaClient.h
+ * @brief Deklaracja klasy ReplicaClient - replika odtwarzająca dziennik głównego procesu
+ */
+
+#pragma once
+#include "TrainCatalog.h"
+#include "TicketStore.h"
+#include "UserDirectory.h"
+#include "Journal.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct ReplicationStatus
+ * @brief Stan repliki: postęp i opóźnienie względem procesu głównego
+ */
+struct ReplicationStatus {
+	uint64_t Fapplied = 0;          ///< Ostatnia zastosowana operacja
+	uint64_t FprimarySequence = 0;  ///< Ostatnia operacja znana procesowi głównemu (ze znacznika)
+	int64_t FlagMicros = 0;         ///< Opóźnienie ostatniej porcji (zapis w głównym -> zastosowanie w replice)
+	int64_t FmaxLagMicros = 0;      ///< Największe zmierzone opóźnienie
+	bool Fconnected = false;        ///< Czy replika jest połączona
+};
+
+/**
+ * @class ReplicaClient
+ * @brief Strona repliki - odbiera strumień dziennika i stosuje go do własnych danych w pamięci
+ *
+ * Replika wczytuje migawki i dziennik z dysku (bez zapisu), łączy się z gniazdem
+ * procesu głównego, wysyła "SINCE <nr>" i w osobnym wątku stosuje kolejne
+ * operacje. Transakcja stosowana jest dopiero po odebraniu jej ostatniej linii.
+ * Po zerwaniu połączenia (np. restart procesu głównego) replika łączy się
+ * ponownie od ostatniej zastosowanej operacji.
+ *
+ * Zmiany zapisywane przez proces główny tylko w migawkach (pociągi dodane,
+ * usunięte, zaimportowane lub zarchiwizowane, nowe konta) nie mają
+ * odpowiednika w operacjach dziennika. Proces główny dopisuje po nich znacznik
+ * RELOAD; po jego odebraniu - albo po "ERR resync", gdy brakujących operacji
+ * nie ma już w dzienniku - replika wczytuje migawki i dziennik od nowa
+ * (reload) i wznawia strumień od wczytanego stanu. Konta są tylko dopisywane,
+ * więc otwarte sesje pozostają ważne.
+ *
+ * Dane repliki chroni stateMutex() - odczyty (wyszukiwanie, lista biletów,
+ * raport) wykonywane są pod tą samą blokadą.
+ */
+class ReplicaClient
+{
+	std::string Fpath;                  ///< Ścieżka gniazda procesu głównego
+	TrainCatalog& Ftrains;              ///< Katalog pociągów repliki
+	TicketStore& Ftickets;              ///< Magazyn biletów repliki
+	UserDirectory& Fusers;              ///< Konta użytkowników repliki
+	mutable std::mutex Fmutex;          ///< Chroni dane repliki i stan replikacji
+	ReplicationStatus Fstatus;          ///< Stan replikacji
+	std::vector<Journal::Record> Fgroup;   ///< Odebrane linie niedokończonej transakcji
+	std::thread Freader;                ///< Wątek odbierający strumień
+	std::atomic<bool> Fstopping;        ///< Czy replika jest zamykana
+
+	/**
+	 * @brief Pętla wątku: połączenie, odbiór linii, ponowne połączenie po zerwaniu
+	 */
+	void readLoop();
+
+	/**
+	 * @brief Przetwarza jedną linię strumienia
+	 * @param line Linia bez znaku końca linii
+	 * @return false jeśli linia jest uszkodzona lub replika musi wczytać dane od nowa
+	 */
+	bool handle(const std::string& line);
+
+	/**
+	 * @brief Wczytuje migawki i dziennik procesu głównego od nowa (pod blokadą danych repliki)
+	 */
+	void reload();
+
+public:
+	/**
+	 * @brief Konstruktor klasy ReplicaClient
+	 * @param path Ścieżka gniazda procesu głównego
+	 * @param trains Katalog pociągów (wczytany z migawki)
+	 * @param tickets Magazyn biletów (wczytany z migawki)
+	 * @param users Konta użytkowników (wczytane z migawki)
+	 * @param applied Ostatnia operacja odzwierciedlona w danych
+	 */
+	ReplicaClient(std::string path, TrainCatalog& trains, TicketStore& tickets, UserDirectory& users, uint64_t applied);
+
+	/**
+	 * @brief Destruktor - kończy wątek odbierający
+	 */
+	~ReplicaClient();
+
+	ReplicaClient(const ReplicaClient&) = delete;
+	ReplicaClient& operator=(const ReplicaClient&) = delete;
+
+	/**
+	 * @brief Uruchamia wątek odbierający strumień dziennika
+	 */
+	void start();
+
+	/**
+	 * @brief Zwraca blokadę danych repliki (odczyty muszą ją trzymać)
+	 * @return Blokada
+	 */
+	std::mutex& stateMutex() const;
+
+	/**
+	 * @brief Zwraca stan replikacji (wywołujący trzyma stateMutex())
+	 * @return Stan
+	 */
+	ReplicationStatus status() const;
+};
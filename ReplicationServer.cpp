@@ -0,0 +1,202 @@
+/**
+ * @file ReplicationServer.cpp
+ * @brief Implementacja klasy ReplicationServer - gniazdo domeny uniksowej i strumień dziennika
+ */
+
+#include "ReplicationServer.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <iostream>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+/**
+ * @brief Wysyła całe dane do gniazda
+ * @param socket Gniazdo
+ * @param data Dane
+ * @return false jeśli połączenie zerwano lub bufor gniazda jest pełny (gniazdo nieblokujące)
+ */
+static bool sendAll(int socket, std::string_view data) {
+	while (!data.empty()) {
+		ssize_t sent = send(socket, data.data(), data.size(), MSG_NOSIGNAL);
+		if (sent < 0 && errno == EINTR) continue;
+		if (sent <= 0) return false;
+		data.remove_prefix(static_cast<size_t>(sent));
+	}
+	return true;
+}
+#endif
+
+/**
+ * @brief Tworzy znacznik porcji: "@ <nr> <czas>"
+ * @param sequence Numer ostatniej operacji
+ * @return Linia znacznika
+ */
+static std::string stamp(uint64_t sequence) {
+	return "@ " + std::to_string(sequence) + " " + std::to_string(ReplicationServer::nowMicros()) + "\n";
+}
+
+/**
+ * @brief Konstruktor klasy ReplicationServer
+ * @param path Ścieżka gniazda domeny uniksowej
+ * @param journal Dziennik głównego procesu
+ */
+ReplicationServer::ReplicationServer(std::string path, Journal& journal)
+	: Fpath(std::move(path)), Fjournal(journal), Fsocket(-1), Fstopping(false) {}
+
+/**
+ * @brief Destruktor - odłącza się od dziennika, kończy wątek i zamyka gniazda
+ */
+ReplicationServer::~ReplicationServer() {
+	if (Fsocket < 0) return;
+	Fjournal.setListener(nullptr);
+	Fstopping = true;
+	if (Facceptor.joinable()) Facceptor.join();
+#ifndef _WIN32
+	for (int replica : Freplicas) close(replica);
+	close(Fsocket);
+	unlink(Fpath.c_str());
+#endif
+}
+
+/**
+ * @brief Zwraca bieżący czas w mikrosekundach
+ * @return Czas od epoki Uniksa
+ */
+int64_t ReplicationServer::nowMicros() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Otwiera gniazdo i uruchamia wątek przyjmujący repliki
+ * @return true jeśli gniazdo zostało otwarte
+ */
+bool ReplicationServer::start() {
+#ifdef _WIN32
+	std::cerr << "Blad: Replikacja wymaga gniazd domeny uniksowej (Linux)." << std::endl;
+	return false;
+#else
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	if (Fpath.size() >= sizeof(address.sun_path)) {
+		std::cerr << "Blad: Zbyt dluga sciezka gniazda " << Fpath << std::endl;
+		return false;
+	}
+	Fpath.copy(address.sun_path, Fpath.size());
+
+	Fsocket = socket(AF_UNIX, SOCK_STREAM, 0);
+	unlink(Fpath.c_str());
+	if (Fsocket < 0 || bind(Fsocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(Fsocket, 16) != 0) {
+		std::cerr << "Blad: Nie mozna otworzyc gniazda replikacji " << Fpath << std::endl;
+		if (Fsocket >= 0) close(Fsocket);
+		Fsocket = -1;
+		return false;
+	}
+
+	Fjournal.setListener([this](std::string_view lines, uint64_t sequence) { publish(lines, sequence); });
+	Facceptor = std::thread(&ReplicationServer::acceptLoop, this);
+	std::cout << "Replikacja: gniazdo " << Fpath << std::endl;
+	return true;
+#endif
+}
+
+/**
+ * @brief Pętla wątku przyjmującego połączenia (sprawdza zamknięcie co 200 ms)
+ */
+void ReplicationServer::acceptLoop() {
+#ifndef _WIN32
+	while (!Fstopping) {
+		pollfd listening{ Fsocket, POLLIN, 0 };
+		if (poll(&listening, 1, 200) <= 0) continue;
+		int replica = accept(Fsocket, nullptr, nullptr);
+		if (replica >= 0) attach(replica);
+	}
+#endif
+}
+
+/**
+ * @brief Obsługuje nowe połączenie repliki
+ *
+ * Zaległe operacje wysyłane są w trybie blokującym (z limitem czasu),
+ * potem gniazdo przechodzi w tryb nieblokujący i trafia na listę replik -
+ * wszystko pod blokadą dziennika, więc żaden zapis nie zostanie pominięty.
+ *
+ * @param replica Gniazdo repliki
+ */
+void ReplicationServer::attach(int replica) {
+#ifndef _WIN32
+	timeval timeout{ 2, 0 };
+	setsockopt(replica, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	setsockopt(replica, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+	// Powitanie: "SINCE <nr>\n"
+	std::string hello;
+	char c;
+	while (hello.size() < 64 && recv(replica, &c, 1, 0) == 1 && c != '\n') hello += c;
+	uint64_t since = 0;
+	std::string_view number = std::string_view(hello).substr(std::min<size_t>(hello.size(), 6));
+	if (!hello.starts_with("SINCE ") || std::from_chars(number.data(), number.data() + number.size(), since).ec != std::errc()) {
+		close(replica);
+		return;
+	}
+
+	bool attached = Fjournal.follow(since, [this, replica](std::string_view lines, uint64_t sequence) {
+		if (!sendAll(replica, lines) || !sendAll(replica, stamp(sequence))) return;
+		fcntl(replica, F_SETFL, fcntl(replica, F_GETFL) | O_NONBLOCK);
+		std::lock_guard<std::mutex> lock(Fmutex);
+		Freplicas.push_back(replica);
+	});
+	if (!attached) {
+		sendAll(replica, "ERR resync\n");
+		close(replica);
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(Fmutex);
+	if (std::find(Freplicas.begin(), Freplicas.end(), replica) == Freplicas.end()) close(replica);
+	else std::cout << "Replikacja: polaczono replike od operacji " << since << std::endl;
+#else
+	(void)replica;
+#endif
+}
+
+/**
+ * @brief Wysyła nowy zapis do replik; replika z pełnym buforem jest rozłączana
+ * @param lines Linie dziennika
+ * @param sequence Numer ostatniej operacji
+ */
+void ReplicationServer::publish(std::string_view lines, uint64_t sequence) {
+#ifndef _WIN32
+	std::lock_guard<std::mutex> lock(Fmutex);
+	if (Freplicas.empty()) return;
+
+	std::string message(lines);
+	message += stamp(sequence);
+	std::erase_if(Freplicas, [&message](int replica) {
+		if (sendAll(replica, message)) return false;
+		close(replica);
+		return true;
+	});
+#else
+	(void)lines;
+	(void)sequence;
+#endif
+}
+
+/**
+ * @brief Zwraca liczbę połączonych replik
+ * @return Liczba replik
+ */
+size_t ReplicationServer::replicas() const {
+	std::lock_guard<std::mutex> lock(Fmutex);
+	return Freplicas.size();
+}
@@ -0,0 +1,95 @@
+/**
+ * @file ReplicationServer.h
+ * @brief Deklaracja klasy ReplicationServer - wysyłanie dziennika do replik przez gniazdo lokalne
+ */
+
+#pragma once
+#include "Journal.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ReplicationServer
+ * @brief Strona główna replikacji - przesyła zapisy dziennika do procesów replik
+ *
+ * Serwer nasłuchuje na gnieździe domeny uniksowej. Replika po połączeniu
+ * wysyła "SINCE <nr>" - numer ostatniej operacji, którą już ma. Serwer
+ * odsyła zaległe linie z pliku dziennika, a potem każdy kolejny zapis
+ * (linie w formacie journal.log). Po każdej porcji wysyłany jest znacznik
+ * "@ <nr> <czas w mikrosekundach>", z którego replika wylicza opóźnienie.
+ *
+ * Gdy zaległych operacji nie ma już w dzienniku (migawka go wyczyściła),
+ * replika dostaje "ERR resync" i musi wczytać migawki od nowa. Zmiany zapisane
+ * tylko w migawkach (pociągi, konta) przychodzą w strumieniu jako znacznik
+ * RELOAD (DataManager::announceSnapshots) - z tym samym skutkiem.
+ * Replika, która nie nadąża odbierać, jest rozłączana (połączy się ponownie
+ * od swojego numeru) - zapis dziennika nigdy nie czeka na replikę.
+ */
+class ReplicationServer
+{
+	std::string Fpath;              ///< Ścieżka gniazda
+	Journal& Fjournal;              ///< Dziennik głównego procesu
+	int Fsocket;                    ///< Gniazdo nasłuchujące (-1 - nieaktywne)
+	std::vector<int> Freplicas;     ///< Połączone repliki
+	mutable std::mutex Fmutex;      ///< Chroni listę replik
+	std::thread Facceptor;          ///< Wątek przyjmujący połączenia
+	std::atomic<bool> Fstopping;    ///< Czy serwer jest zamykany
+
+	/**
+	 * @brief Pętla wątku przyjmującego połączenia replik
+	 */
+	void acceptLoop();
+
+	/**
+	 * @brief Obsługuje nowe połączenie: odczyt "SINCE", zaległe operacje, rejestracja
+	 * @param replica Gniazdo repliki
+	 */
+	void attach(int replica);
+
+	/**
+	 * @brief Wysyła nowy zapis dziennika do wszystkich replik (wywoływane pod blokadą dziennika)
+	 * @param lines Linie dziennika
+	 * @param sequence Numer ostatniej operacji
+	 */
+	void publish(std::string_view lines, uint64_t sequence);
+
+public:
+	/**
+	 * @brief Konstruktor klasy ReplicationServer
+	 * @param path Ścieżka gniazda domeny uniksowej
+	 * @param journal Dziennik głównego procesu
+	 */
+	ReplicationServer(std::string path, Journal& journal);
+
+	/**
+	 * @brief Destruktor - odłącza się od dziennika i zamyka połączenia
+	 */
+	~ReplicationServer();
+
+	ReplicationServer(const ReplicationServer&) = delete;
+	ReplicationServer& operator=(const ReplicationServer&) = delete;
+
+	/**
+	 * @brief Otwiera gniazdo i zaczyna przyjmować repliki
+	 * @return true jeśli gniazdo zostało otwarte
+	 */
+	bool start();
+
+	/**
+	 * @brief Zwraca liczbę połączonych replik
+	 * @return Liczba replik
+	 */
+	size_t replicas() const;
+
+	/**
+	 * @brief Zwraca bieżący czas w mikrosekundach (zegar wspólny dla procesów na jednej maszynie)
+	 * @return Czas od epoki Uniksa
+	 */
+	static int64_t nowMicros();
+};
@@ -0,0 +1,265 @@
+/**
+ * @file SearchCache.cpp
+ * @brief Implementacja klasy SearchCache - wyszukiwanie pociągów z pamięcią podręczną LRU
+ */
+
+#include "SearchCache.h"
+#include "StringPool.h"
+#include <algorithm>
+#include <cctype>
+#include <unordered_set>
+
+/**
+ * @brief Porównuje dwa znaki bez rozróżniania wielkości liter
+ * @param a Pierwszy znak
+ * @param b Drugi znak
+ * @return true jeśli znaki są równe po sprowadzeniu do małych liter
+ */
+static bool equalsIgnoreCase(char a, char b) {
+	return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+}
+
+/**
+ * @brief Sprawdza czy tekst zawiera podany fragment (bez rozróżniania wielkości liter)
+ *
+ * Porównanie odbywa się znak po znaku, bez tworzenia kopii napisów.
+ *
+ * @param text Przeszukiwany tekst
+ * @param term Szukany fragment
+ * @return true jeśli fragment został znaleziony, false w przeciwnym razie
+ */
+static bool containsString(std::string_view text, std::string_view term) {
+	if (term.empty()) return true;
+	return std::search(text.begin(), text.end(), term.begin(), term.end(), equalsIgnoreCase) != text.end();
+}
+
+/**
+ * @brief Usuwa białe znaki z początku i końca tekstu
+ * @param text Tekst
+ * @return Tekst bez białych znaków na końcach
+ */
+static std::string_view trimView(std::string_view text) {
+	size_t first = text.find_first_not_of(" \t\r\n");
+	if (first == std::string_view::npos) return {};
+	size_t last = text.find_last_not_of(" \t\r\n");
+	return text.substr(first, last - first + 1);
+}
+
+/**
+ * @brief Tworzy znormalizowane zapytanie
+ * @param origin Fragment stacji początkowej
+ * @param destination Fragment stacji końcowej
+ * @param datePrefix Prefiks daty
+ * @param travelClass Klasa (0 = bez filtra dostępności)
+ * @param departureFrom Najwcześniejszy odjazd w minutach od północy
+ * @return Zapytanie
+ */
+SearchQuery SearchQuery::make(std::string_view origin, std::string_view destination, std::string_view datePrefix, int travelClass,
+	uint16_t departureFrom) {
+	auto lower = [](std::string_view text) {
+		std::string result(trimView(text));
+		std::transform(result.begin(), result.end(), result.begin(),
+			[](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		return result;
+	};
+
+	SearchQuery query;
+	query.Forigin = lower(origin);
+	query.Fdestination = lower(destination);
+
+	// Prefiks daty -> przedział wszystkich dat o tym prefiksie (cyfry uzupełniane zerami i dziewiątkami)
+	std::string_view date = trimView(datePrefix);
+	if (!date.empty()) {
+		uint32_t from = 0, to = 0;
+		int digits = 0;
+		for (char c : date) {
+			if (c == '-') continue;
+			if (c < '0' || c > '9' || digits == 8) {
+				// Niepoprawny prefiks - pusty przedział
+				query.FdateFrom = 1;
+				query.FdateTo = 0;
+				return query;
+			}
+			from = from * 10 + static_cast<uint32_t>(c - '0');
+			digits++;
+		}
+		to = from;
+		for (; digits < 8; digits++) {
+			from = from * 10;
+			to = to * 10 + 9;
+		}
+		query.FdateFrom = from;
+		query.FdateTo = to;
+	}
+	query.FdepartureFrom = departureFrom;
+	query.FtravelClass = travelClass;
+	return query;
+}
+
+/**
+ * @brief Sprawdza czy trasa spełnia kryteria stacji
+ * @param originId Identyfikator stacji początkowej
+ * @param destinationId Identyfikator stacji końcowej
+ * @return true jeśli trasa pasuje
+ */
+bool SearchQuery::matchesRoute(uint32_t originId, uint32_t destinationId) const {
+	return containsString(StringPool::stations().get(originId), Forigin) &&
+		containsString(StringPool::stations().get(destinationId), Fdestination);
+}
+
+/**
+ * @brief Sprawdza czy pociąg spełnia kryteria zapytania
+ * @param train Pociąg
+ * @return true jeśli pociąg pasuje
+ */
+bool SearchQuery::matches(const Train& train) const {
+	return matchesSchedule(train) && matchesRoute(train.getOriginId(), train.getDestinationId());
+}
+
+/**
+ * @brief Sprawdza kryteria daty i dostępności klasy
+ * @param train Pociąg
+ * @return true jeśli pociąg pasuje
+ */
+bool SearchQuery::matchesSchedule(const Train& train) const {
+	uint32_t date = Train::dateKey(train.getDate());
+	if (date < FdateFrom || date > FdateTo) return false;
+	if (FdepartureFrom > 0 && (train.getDeparture() == Train::NO_TIME || train.getDeparture() < FdepartureFrom)) return false;
+	return FtravelClass == 0 || train.findFreeSeat(FtravelClass) != 0;
+}
+
+/**
+ * @brief Zwraca klucz zapytania w pamięci podręcznej
+ * @return Klucz
+ */
+std::string SearchQuery::key() const {
+	std::string key;
+	key.reserve(Forigin.size() + Fdestination.size() + 32);
+	key += Forigin; key += '\x1f';
+	key += Fdestination; key += '\x1f';
+	key += std::to_string(FdateFrom); key += '\x1f';
+	key += std::to_string(FdateTo); key += '\x1f';
+	key += std::to_string(FdepartureFrom); key += '\x1f';
+	key += std::to_string(FtravelClass);
+	return key;
+}
+
+/**
+ * @brief Konstruktor klasy SearchCache
+ * @param capacity Maksymalna liczba wpisów
+ */
+SearchCache::SearchCache(size_t capacity) : Fcapacity(std::max<size_t>(capacity, 1)) {}
+
+/**
+ * @brief Sprawdza czy wpis jest nadal aktualny
+ * @param entry Wpis
+ * @param trains Katalog pociągów
+ * @return true jeśli żadna z tras wpisu się nie zmieniła
+ */
+bool SearchCache::isFresh(const Entry& entry, const TrainCatalog& trains) {
+	if (entry.FrouteSetVersion != trains.routeSetVersion()) return false;
+	for (const auto& route : entry.Froutes) {
+		if (trains.routeVersion(route.first) != route.second) return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Zwraca pociągi pasujące do zapytania
+ *
+ * Przy chybieniu wyznaczane są najpierw trasy pasujące do kryteriów stacji
+ * (zależności wpisu), a potem tylko pociągi tych tras są sprawdzane pod kątem
+ * daty i dostępności klasy. Przy ograniczeniu daty przeglądany jest tylko
+ * przedział indeksu odjazdów (od pierwszego dnia i godziny do końca ostatniego dnia).
+ * Pełny przegląd dużego katalogu rozdzielany jest między partycje puli.
+ *
+ * @param trains Katalog pociągów
+ * @param query Zapytanie
+ * @param shards Pula partycji (nullptr - przegląd w wątku wywołującym)
+ * @return Pasujące pociągi
+ */
+const std::vector<const Train*>& SearchCache::search(const TrainCatalog& trains, const SearchQuery& query, ShardPool* shards) {
+	std::string key = query.key();
+
+	auto it = Findex.find(key);
+	if (it != Findex.end() && isFresh(*it->second, trains)) {
+		Fhits++;
+		Fentries.splice(Fentries.begin(), Fentries, it->second);
+		return it->second->Fresults;
+	}
+	Fmisses++;
+
+	// Nieaktualny wpis jest przeliczany w miejscu, nowy trafia na początek listy
+	if (it == Findex.end()) {
+		Fentries.push_front(Entry{ key, {}, {}, 0 });
+		it = Findex.emplace(std::move(key), Fentries.begin()).first;
+		if (Fentries.size() > Fcapacity) {
+			Findex.erase(Fentries.back().Fkey);
+			Fentries.pop_back();
+		}
+	}
+	else {
+		Fentries.splice(Fentries.begin(), Fentries, it->second);
+	}
+
+	Entry& entry = *it->second;
+	entry.Fresults.clear();
+	entry.Froutes.clear();
+	entry.FrouteSetVersion = trains.routeSetVersion();
+
+	// Trasy pasujące do kryteriów stacji - od nich zależy wynik
+	std::unordered_set<uint64_t> matchingRoutes;
+	trains.forEachRoute([&query, &entry, &matchingRoutes](uint64_t routeKey, uint32_t originId, uint32_t destinationId, uint32_t version) {
+		if (query.matchesRoute(originId, destinationId)) {
+			matchingRoutes.insert(routeKey);
+			entry.Froutes.emplace_back(routeKey, version);
+		}
+	});
+
+	auto consider = [&query, &entry, &matchingRoutes](const Train& train) {
+		if (matchingRoutes.count(TrainCatalog::routeKey(train.getOriginId(), train.getDestinationId())) &&
+			query.matchesSchedule(train)) {
+			entry.Fresults.push_back(&train);
+		}
+	};
+
+	if (query.FdateTo != SearchQuery::NO_DATE_LIMIT) {
+		trains.forEachDeparture(TrainCatalog::departureKey(query.FdateFrom, query.FdepartureFrom),
+			TrainCatalog::departureKey(query.FdateTo, Train::NO_TIME), consider);
+	}
+	else if (shards != nullptr && shards->size() > 1 && trains.size() >= PARALLEL_SCAN) {
+		// Pełny przegląd - każda partycja przegląda swój ciągły fragment katalogu,
+		// wyniki łączone są w kolejności fragmentów (jak przy przeglądzie w jednym wątku)
+		std::vector<const Train*> dense(trains.begin(), trains.end());
+		std::vector<std::vector<const Train*>> partial(shards->size());
+		size_t chunk = (dense.size() + partial.size() - 1) / partial.size();
+		shards->scatter([&](size_t shard) {
+			size_t from = std::min(dense.size(), shard * chunk), to = std::min(dense.size(), from + chunk);
+			for (size_t i = from; i < to; i++) {
+				const Train& train = *dense[i];
+				if (matchingRoutes.count(TrainCatalog::routeKey(train.getOriginId(), train.getDestinationId())) &&
+					query.matchesSchedule(train)) {
+					partial[shard].push_back(&train);
+				}
+			}
+		});
+		for (const auto& found : partial) entry.Fresults.insert(entry.Fresults.end(), found.begin(), found.end());
+	}
+	else {
+		for (const Train* train : trains) consider(*train);
+	}
+	return entry.Fresults;
+}
+
+/**
+ * @brief Usuwa wszystkie wpisy
+ */
+void SearchCache::clear() {
+	Fentries.clear();
+	Findex.clear();
+}
+
+// Statystyki pamięci podręcznej
+size_t SearchCache::size() const { return Fentries.size(); }
+size_t SearchCache::hits() const { return Fhits; }
+size_t SearchCache::misses() const { return Fmisses; }
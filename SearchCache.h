@@ -0,0 +1,155 @@
+/**
+ * @file SearchCache.h
+ * @brief Deklaracja klasy SearchCache - pamięć podręczna wyników wyszukiwania pociągów
+ */
+
+#pragma once
+#include "Train.h"
+#include "TrainCatalog.h"
+#include "ShardPool.h"
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @struct SearchQuery
+ * @brief Znormalizowane zapytanie wyszukiwania
+ *
+ * Nazwy stacji są fragmentami (bez rozróżniania wielkości liter, puste = dowolna),
+ * daty tworzą przedział domknięty liczb RRRRMMDD (Train::dateKey).
+ */
+struct SearchQuery {
+	std::string Forigin;          ///< Fragment nazwy stacji początkowej (małe litery)
+	std::string Fdestination;     ///< Fragment nazwy stacji końcowej (małe litery)
+	uint32_t FdateFrom = 0;                 ///< Początek przedziału dat (RRRRMMDD)
+	uint32_t FdateTo = NO_DATE_LIMIT;       ///< Koniec przedziału dat (NO_DATE_LIMIT = bez ograniczenia)
+	uint16_t FdepartureFrom = 0;            ///< Najwcześniejsza godzina odjazdu w minutach (0 = bez filtra)
+	int FtravelClass = 0;                   ///< Wymagana klasa z wolnymi miejscami (0 = bez filtra)
+
+	static constexpr uint32_t NO_DATE_LIMIT = 0xFFFFFFFFu;   ///< Brak ograniczenia daty
+
+	/**
+	 * @brief Tworzy znormalizowane zapytanie
+	 *
+	 * Białe znaki na końcach są usuwane, nazwy stacji sprowadzane do małych liter.
+	 * Data może być prefiksem (RRRR, RRRR-MM lub RRRR-MM-DD) - zamieniana jest
+	 * na przedział wszystkich dat o tym prefiksie.
+	 *
+	 * @param origin Fragment stacji początkowej
+	 * @param destination Fragment stacji końcowej
+	 * @param datePrefix Prefiks daty
+	 * @param travelClass Klasa (0 = bez filtra dostępności)
+	 * @param departureFrom Najwcześniejszy odjazd w minutach od północy (0 = bez filtra)
+	 * @return Zapytanie
+	 */
+	static SearchQuery make(std::string_view origin, std::string_view destination, std::string_view datePrefix, int travelClass,
+		uint16_t departureFrom = 0);
+
+	/**
+	 * @brief Sprawdza czy pociąg spełnia kryteria zapytania
+	 * @param train Pociąg
+	 * @return true jeśli pociąg pasuje
+	 */
+	bool matches(const Train& train) const;
+
+	/**
+	 * @brief Sprawdza kryteria daty i dostępności klasy (bez stacji)
+	 * @param train Pociąg
+	 * @return true jeśli pociąg pasuje
+	 */
+	bool matchesSchedule(const Train& train) const;
+
+	/**
+	 * @brief Sprawdza czy trasa spełnia kryteria stacji
+	 * @param originId Identyfikator stacji początkowej
+	 * @param destinationId Identyfikator stacji końcowej
+	 * @return true jeśli trasa pasuje
+	 */
+	bool matchesRoute(uint32_t originId, uint32_t destinationId) const;
+
+	/**
+	 * @brief Zwraca klucz zapytania w pamięci podręcznej
+	 * @return Klucz (pola oddzielone znakiem \x1f)
+	 */
+	std::string key() const;
+};
+
+/**
+ * @class SearchCache
+ * @brief Ograniczona pamięć podręczna LRU wyników wyszukiwania
+ *
+ * Każdy wpis pamięta wersję zbioru tras oraz wersje tras pasujących do zapytania
+ * w chwili wyszukania. Wpis jest ważny, dopóki żadna z tych wersji się nie zmieni -
+ * dodanie pociągu na innej trasie nie unieważnia wyniku. Popularne zapytanie
+ * kosztuje jedno wyszukanie w tablicy haszującej i sprawdzenie wersji jego tras.
+ *
+ * Zapytania z ograniczeniem daty przeglądają tylko przedział indeksu odjazdów
+ * katalogu zamiast wszystkich pociągów. Pozostałe przeglądają cały katalog -
+ * przy dużym katalogu równolegle we fragmentach (scatter-gather na ShardPool).
+ *
+ * Wynik przechowuje wskaźniki na pociągi; usunięcie pociągu zwiększa wersję jego
+ * trasy, więc nieaktualny wpis nigdy nie zostanie zwrócony.
+ */
+class SearchCache
+{
+public:
+	static constexpr size_t DEFAULT_CAPACITY = 256;   ///< Domyślna liczba wpisów
+	static constexpr size_t PARALLEL_SCAN = 16384;    ///< Najmniejszy katalog przeglądany równolegle przez partycje
+
+private:
+	/**
+	 * @struct Entry
+	 * @brief Wpis pamięci podręcznej
+	 */
+	struct Entry {
+		std::string Fkey;                                        ///< Klucz zapytania
+		std::vector<const Train*> Fresults;                      ///< Pasujące pociągi
+		std::vector<std::pair<uint64_t, uint32_t>> Froutes;      ///< Trasy, od których zależy wynik, z wersjami
+		uint32_t FrouteSetVersion;                               ///< Wersja zbioru tras
+	};
+
+	size_t Fcapacity;                                                        ///< Maksymalna liczba wpisów
+	std::list<Entry> Fentries;                                               ///< Wpisy od najświeższego
+	std::unordered_map<std::string, std::list<Entry>::iterator> Findex;      ///< Klucz -> wpis
+	size_t Fhits = 0;                                                        ///< Liczba trafień
+	size_t Fmisses = 0;                                                      ///< Liczba chybień
+
+	/**
+	 * @brief Sprawdza czy wpis jest nadal aktualny
+	 * @param entry Wpis
+	 * @param trains Katalog pociągów
+	 * @return true jeśli żadna z tras wpisu się nie zmieniła
+	 */
+	static bool isFresh(const Entry& entry, const TrainCatalog& trains);
+
+public:
+	/**
+	 * @brief Konstruktor klasy SearchCache
+	 * @param capacity Maksymalna liczba wpisów
+	 */
+	explicit SearchCache(size_t capacity = DEFAULT_CAPACITY);
+
+	/**
+	 * @brief Zwraca pociągi pasujące do zapytania (z pamięci podręcznej lub wyliczone)
+	 * @param trains Katalog pociągów
+	 * @param query Zapytanie
+	 * @param shards Pula partycji do równoległego pełnego przeglądu (nullptr - bez wątków)
+	 * @return Pasujące pociągi (ważne do następnego wywołania search)
+	 */
+	const std::vector<const Train*>& search(const TrainCatalog& trains, const SearchQuery& query, ShardPool* shards = nullptr);
+
+	/**
+	 * @brief Usuwa wszystkie wpisy
+	 */
+	void clear();
+
+	// Statystyki
+	size_t size() const;
+	size_t hits() const;
+	size_t misses() const;
+};
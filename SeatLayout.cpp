@@ -0,0 +1,175 @@
+/**
+ * @file SeatLayout.cpp
+ * @brief Implementacja klasy SeatLayout - parsowanie i zapytania o układ miejsc
+ */
+
+#include "SeatLayout.h"
+#include <algorithm>
+#include <charconv>
+
+/**
+ * @brief Zamienia fragment tekstu na liczbę całkowitą
+ * @param text Fragment tekstu
+ * @param value Zmienna, do której zostanie zapisana liczba
+ * @return true jeśli cały fragment jest poprawną liczbą
+ */
+static bool parseNumber(std::string_view text, int& value) {
+	auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+	return !text.empty() && result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+/**
+ * @brief Konstruktor domyślny - pusty układ
+ */
+SeatLayout::SeatLayout() : Fsegments{}, FsegmentCount(0), Fcapacity(0) {}
+
+/**
+ * @brief Tworzy układ jednolity (jeden wagon drugiej klasy, 4 miejsca w rzędzie)
+ * @param capacity Liczba miejsc
+ * @return Układ jednolity lub pusty przy nieprawidłowej liczbie miejsc
+ */
+SeatLayout SeatLayout::uniform(int capacity) {
+	SeatLayout layout;
+	if (capacity < 1 || capacity > MAX_CAPACITY) return layout;
+
+	int rows = (capacity + DEFAULT_SEATS_PER_ROW - 1) / DEFAULT_SEATS_PER_ROW;
+	layout.Fsegments[0] = CoachSegment{ static_cast<uint16_t>(capacity), static_cast<uint16_t>(rows),
+		static_cast<uint8_t>(DEFAULT_SEATS_PER_ROW), 1 };
+	layout.FsegmentCount = 1;
+	layout.Fcapacity = static_cast<uint16_t>(capacity);
+	return layout;
+}
+
+/**
+ * @brief Parsuje zapis tekstowy układu
+ *
+ * Po sparsowaniu segmenty są stabilnie sortowane według klasy (pierwsza klasa
+ * na początku), aby miejsca każdej klasy tworzyły jeden ciągły przedział.
+ *
+ * @param text Zapis układu
+ * @param layout Zmienna, do której zostanie zapisany układ
+ * @return true jeśli zapis jest poprawny
+ */
+bool SeatLayout::parse(std::string_view text, SeatLayout& layout) {
+	SeatLayout result;
+	int total = 0;
+
+	while (!text.empty()) {
+		size_t comma = text.find(',');
+		std::string_view part = text.substr(0, comma);
+		text.remove_prefix(comma == std::string_view::npos ? text.size() : comma + 1);
+
+		if (result.FsegmentCount == MAX_SEGMENTS) return false;
+
+		// Klasa przed dwukropkiem
+		size_t colon = part.find(':');
+		int travelClass;
+		if (colon == std::string_view::npos || !parseNumber(part.substr(0, colon), travelClass)) return false;
+		if (travelClass != 1 && travelClass != 2) return false;
+		part.remove_prefix(colon + 1);
+
+		// Wagony x rzędy x miejsca w rzędzie lub sama liczba miejsc
+		int coaches = 1, rows = 0, perRow = DEFAULT_SEATS_PER_ROW, seats = 0;
+		size_t x1 = part.find('x');
+		if (x1 == std::string_view::npos) {
+			if (!parseNumber(part, seats) || seats < 1) return false;
+			rows = (seats + perRow - 1) / perRow;
+		}
+		else {
+			size_t x2 = part.find('x', x1 + 1);
+			if (x2 == std::string_view::npos) return false;
+			if (!parseNumber(part.substr(0, x1), coaches) ||
+				!parseNumber(part.substr(x1 + 1, x2 - x1 - 1), rows) ||
+				!parseNumber(part.substr(x2 + 1), perRow)) return false;
+			if (coaches < 1 || rows < 1 || perRow < 1 || perRow > MAX_SEATS_PER_ROW) return false;
+			if (coaches > MAX_CAPACITY || rows > MAX_CAPACITY) return false;
+			seats = coaches * rows * perRow;
+		}
+
+		total += seats;
+		if (seats > MAX_CAPACITY || total > MAX_CAPACITY) return false;
+
+		result.Fsegments[result.FsegmentCount++] = CoachSegment{ static_cast<uint16_t>(seats), static_cast<uint16_t>(rows),
+			static_cast<uint8_t>(perRow), static_cast<uint8_t>(travelClass) };
+	}
+
+	if (total < 1) return false;
+
+	std::stable_sort(result.Fsegments, result.Fsegments + result.FsegmentCount,
+		[](const CoachSegment& a, const CoachSegment& b) { return a.Fclass > b.Fclass; });
+	result.Fcapacity = static_cast<uint16_t>(total);
+	layout = result;
+	return true;
+}
+
+/**
+ * @brief Zwraca zapis tekstowy układu
+ * @return Zapis w formacie akceptowanym przez parse()
+ */
+std::string SeatLayout::toString() const {
+	std::string text;
+	for (int i = 0; i < FsegmentCount; i++) {
+		const CoachSegment& s = Fsegments[i];
+		if (i > 0) text += ',';
+		text += std::to_string(s.Fclass);
+		text += ':';
+
+		int perCoach = s.Frows * s.FseatsPerRow;
+		if (s.Fseats % perCoach == 0) {
+			text += std::to_string(s.Fseats / perCoach) + "x" + std::to_string(s.Frows) + "x" + std::to_string(s.FseatsPerRow);
+		}
+		else {
+			// Niepełny wagon - wyłącznie układ jednolity (4 miejsca w rzędzie)
+			text += std::to_string(s.Fseats);
+		}
+	}
+	return text;
+}
+
+// Rozmiar układu i dostęp do segmentów
+int SeatLayout::capacity() const { return Fcapacity; }
+int SeatLayout::segmentCount() const { return FsegmentCount; }
+const CoachSegment& SeatLayout::segment(int index) const { return Fsegments[index]; }
+
+/**
+ * @brief Zwraca klasę miejsca
+ * @param seatNumber Numer miejsca
+ * @return Klasa miejsca lub 0 przy nieprawidłowym numerze
+ */
+int SeatLayout::classOf(int seatNumber) const {
+	if (seatNumber < 1) return 0;
+	int last = 0;
+	for (int i = 0; i < FsegmentCount; i++) {
+		last += Fsegments[i].Fseats;
+		if (seatNumber <= last) return Fsegments[i].Fclass;
+	}
+	return 0;
+}
+
+/**
+ * @brief Zwraca przedział numerów miejsc danej klasy
+ * @param travelClass Klasa (0 - dowolna)
+ * @param first Pierwszy numer miejsca
+ * @param last Ostatni numer miejsca
+ * @return true jeśli pociąg ma miejsca tej klasy
+ */
+bool SeatLayout::classRange(int travelClass, int& first, int& last) const {
+	if (travelClass == 0) {
+		first = 1;
+		last = Fcapacity;
+		return Fcapacity > 0;
+	}
+
+	int begin = 1;
+	bool found = false;
+	for (int i = 0; i < FsegmentCount; i++) {
+		int end = begin + Fsegments[i].Fseats - 1;
+		if (Fsegments[i].Fclass == travelClass) {
+			if (!found) first = begin;
+			last = end;
+			found = true;
+		}
+		begin = end + 1;
+	}
+	return found;
+}
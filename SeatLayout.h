@@ -0,0 +1,112 @@
+/**
+ * @file SeatLayout.h
+ * @brief Deklaracja klasy SeatLayout - zwarty opis układu wagonów i klas pociągu
+ */
+
+#pragma once
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+/**
+ * @struct CoachSegment
+ * @brief Grupa jednakowych wagonów jednej klasy
+ *
+ * Ostatni wagon segmentu może być niepełny (liczba miejsc nie musi być
+ * wielokrotnością miejsc w wagonie).
+ */
+struct CoachSegment {
+	uint16_t Fseats;         ///< Łączna liczba miejsc w segmencie
+	uint16_t Frows;          ///< Liczba rzędów w jednym wagonie
+	uint8_t FseatsPerRow;    ///< Liczba miejsc w rzędzie
+	uint8_t Fclass;          ///< Klasa miejsc (1 - druga, 2 - pierwsza)
+};
+
+/**
+ * @class SeatLayout
+ * @brief Układ miejsc pociągu: wagony, rzędy, miejsca w rzędzie i klasy
+ *
+ * Zapis tekstowy: segmenty oddzielone przecinkami, każdy w postaci
+ * "klasa:wagonyxrzędyxmiejsca_w_rzędzie" (np. "2:1x10x3,1:4x20x4")
+ * lub "klasa:liczba_miejsc" (jeden wagon, 4 miejsca w rzędzie).
+ *
+ * Segmenty są porządkowane według klasy (najpierw pierwsza), a miejsca
+ * numerowane kolejno od 1. Dzięki temu miejsca każdej klasy tworzą jeden
+ * ciągły przedział mapy bitowej pociągu - wyszukanie wolnego miejsca
+ * w danej klasie to jedno przejście po słowach tego przedziału.
+ */
+class SeatLayout
+{
+public:
+	static constexpr int MAX_SEGMENTS = 4;          ///< Maksymalna liczba segmentów
+	static constexpr int MAX_CAPACITY = 5000;       ///< Maksymalna liczba miejsc w pociągu
+	static constexpr int MAX_SEATS_PER_ROW = 8;     ///< Maksymalna liczba miejsc w rzędzie
+	static constexpr int DEFAULT_SEATS_PER_ROW = 4; ///< Miejsca w rzędzie dla układu jednolitego
+
+private:
+	CoachSegment Fsegments[MAX_SEGMENTS];   ///< Segmenty w kolejności numeracji miejsc
+	uint8_t FsegmentCount;                  ///< Liczba używanych segmentów
+	uint16_t Fcapacity;                     ///< Łączna liczba miejsc
+
+public:
+	/**
+	 * @brief Konstruktor domyślny - pusty układ (0 miejsc)
+	 */
+	SeatLayout();
+
+	/**
+	 * @brief Tworzy układ jednolity: jeden wagon drugiej klasy, 4 miejsca w rzędzie
+	 * @param capacity Liczba miejsc
+	 * @return Układ (pusty, jeśli liczba miejsc jest spoza zakresu 1..MAX_CAPACITY)
+	 */
+	static SeatLayout uniform(int capacity);
+
+	/**
+	 * @brief Parsuje zapis tekstowy układu
+	 * @param text Zapis układu (np. "2:1x10x3,1:4x20x4")
+	 * @param layout Zmienna, do której zostanie zapisany układ
+	 * @return true jeśli zapis jest poprawny
+	 */
+	static bool parse(std::string_view text, SeatLayout& layout);
+
+	/**
+	 * @brief Zwraca zapis tekstowy układu
+	 * @return Zapis w formacie akceptowanym przez parse()
+	 */
+	std::string toString() const;
+
+	/**
+	 * @brief Zwraca łączną liczbę miejsc
+	 * @return Liczba miejsc
+	 */
+	int capacity() const;
+
+	/**
+	 * @brief Zwraca liczbę segmentów
+	 * @return Liczba segmentów
+	 */
+	int segmentCount() const;
+
+	/**
+	 * @brief Zwraca segment o podanym indeksie
+	 * @param index Indeks segmentu (0..segmentCount()-1)
+	 * @return Segment
+	 */
+	const CoachSegment& segment(int index) const;
+
+	/**
+	 * @brief Zwraca klasę miejsca
+	 * @param seatNumber Numer miejsca
+	 * @return Klasa miejsca lub 0, jeśli numer jest nieprawidłowy
+	 */
+	int classOf(int seatNumber) const;
+
+	/**
+	 * @brief Zwraca przedział numerów miejsc danej klasy
+	 * @param travelClass Klasa (0 oznacza dowolną klasę - cały pociąg)
+	 * @param first Zmienna, do której zostanie zapisany pierwszy numer
+	 * @param last Zmienna, do której zostanie zapisany ostatni numer
+	 * @return true jeśli pociąg ma miejsca tej klasy
+	 */
+	bool classRange(int travelClass, int& first, int& last) const;
+};
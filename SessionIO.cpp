@@ -0,0 +1,56 @@
+/**
+ * @file SessionIO.cpp
+ * @brief Implementacja klasy SessionIO - kolejka linii i wznawianie korutyny sesji
+ */
+
+#include "SessionIO.h"
+#include <utility>
+
+/**
+ * @brief Tworzy kanał z buforowanym wyjściem
+ */
+SessionIO::SessionIO() : Fout(&Fbuffer) {}
+
+/**
+ * @brief Tworzy kanał piszący bezpośrednio do strumienia
+ * @param out Strumień wyjścia
+ */
+SessionIO::SessionIO(std::ostream& out) : Fout(&out) {}
+
+/**
+ * @brief Zwraca oczekiwanie na kolejną linię wejścia
+ * @return Obiekt do co_await
+ */
+SessionIO::LineAwaiter SessionIO::nextLine() { return LineAwaiter{ *this }; }
+
+/**
+ * @brief Zwraca strumień wyjścia sesji
+ * @return Strumień
+ */
+std::ostream& SessionIO::out() { return *Fout; }
+
+/**
+ * @brief Dodaje linię i wznawia czekającą korutynę
+ * @param line Linia bez znaku końca linii
+ */
+void SessionIO::push(std::string line) {
+	Finput.push_back(std::move(line));
+	if (Fwaiting) std::exchange(Fwaiting, {}).resume();
+}
+
+/**
+ * @brief Sprawdza czy sesja czeka na wejście
+ * @return true jeśli korutyna jest zawieszona w nextLine()
+ */
+bool SessionIO::waiting() const { return static_cast<bool>(Fwaiting); }
+
+/**
+ * @brief Odbiera zbuforowane wyjście i czyści bufor
+ * @return Tekst wypisany od poprzedniego wywołania
+ */
+std::string SessionIO::takeOutput() {
+	if (Fout != &Fbuffer) return {};
+	std::string output = Fbuffer.str();
+	Fbuffer.str({});
+	return output;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file SessionIO.h
+ * @brief Deklaracja klasy SessionIO - wejście i wyjście jednej sesji interaktywnej
+ */
+
+#pragma once
+#include <coroutine>
+#include <deque>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+/**
+ * @class SessionIO
+ * @brief Kanał jednej sesji menu - kolejka linii wejścia i strumień wyjścia
+ *
+ * Korutyny sesji (menu pasażera, administratora) czekają na kolejną linię
+ * przez co_await nextLine(). Jeśli linia jest już w kolejce, korutyna
+ * działa dalej bez zawieszenia; w przeciwnym razie zawiesza się, a wznawia
+ * ją dopiero push() - wywoływane przez sterownik sesji (pętla konsoli albo
+ * pętla zdarzeń SessionServer), gdy od klienta nadejdzie linia.
+ *
+ * Wyjście trafia albo bezpośrednio do podanego strumienia (konsola),
+ * albo do wewnętrznego bufora odbieranego przez takeOutput() (klient sieciowy).
+ */
+class SessionIO
+{
+	std::deque<std::string> Finput;          ///< Linie odebrane, jeszcze nieprzeczytane
+	std::coroutine_handle<> Fwaiting;        ///< Korutyna czekająca na linię (pusta - brak)
+	std::ostringstream Fbuffer;              ///< Bufor wyjścia (gdy brak strumienia docelowego)
+	std::ostream* Fout;                      ///< Strumień wyjścia sesji
+
+public:
+	/**
+	 * @struct LineAwaiter
+	 * @brief Oczekiwanie na kolejną linię wejścia (co_await io.nextLine())
+	 */
+	struct LineAwaiter {
+		SessionIO& Fio;   ///< Kanał sesji
+
+		bool await_ready() const noexcept { return !Fio.Finput.empty(); }
+		void await_suspend(std::coroutine_handle<> waiting) noexcept { Fio.Fwaiting = waiting; }
+		std::string await_resume() {
+			std::string line = std::move(Fio.Finput.front());
+			Fio.Finput.pop_front();
+			return line;
+		}
+	};
+
+	/**
+	 * @brief Tworzy kanał z buforowanym wyjściem (odbieranym przez takeOutput)
+	 */
+	SessionIO();
+
+	/**
+	 * @brief Tworzy kanał piszący bezpośrednio do strumienia
+	 * @param out Strumień wyjścia (np. std::cout)
+	 */
+	explicit SessionIO(std::ostream& out);
+
+	SessionIO(const SessionIO&) = delete;
+	SessionIO& operator=(const SessionIO&) = delete;
+
+	/**
+	 * @brief Zwraca oczekiwanie na kolejną linię wejścia
+	 * @return Obiekt do co_await - wynikiem jest linia bez znaku końca linii
+	 */
+	LineAwaiter nextLine();
+
+	/**
+	 * @brief Zwraca strumień wyjścia sesji
+	 * @return Strumień
+	 */
+	std::ostream& out();
+
+	/**
+	 * @brief Dodaje linię od klienta i wznawia czekającą korutynę
+	 *
+	 * Korutyna działa w wątku wywołującym aż do kolejnego zawieszenia
+	 * (brak dalszych linii) albo zakończenia sesji.
+	 *
+	 * @param line Linia bez znaku końca linii
+	 */
+	void push(std::string line);
+
+	/**
+	 * @brief Sprawdza czy sesja czeka na wejście
+	 * @return true jeśli korutyna jest zawieszona w nextLine()
+	 */
+	bool waiting() const;
+
+	/**
+	 * @brief Odbiera zbuforowane wyjście i czyści bufor
+	 * @return Tekst wypisany od poprzedniego wywołania (pusty przy wyjściu bezpośrednim)
+	 */
+	std::string takeOutput();
+};
@@ -0,0 +1,82 @@
+/**
+ * @file SessionManager.cpp
+ * @brief Implementacja klasy SessionManager - tokeny sesji
+ */
+
+#include "SessionManager.h"
+#include "PasswordHasher.h"
+#include <mutex>
+
+/**
+ * @brief Zamienia tekstowy token na postać binarną
+ *
+ * Parsowanie odbywa się bez alokacji, więc rozpoznanie sesji kosztuje
+ * jedno wyszukanie w tablicy haszującej.
+ *
+ * @param token Token (32 znaki szesnastkowe)
+ * @param key Klucz binarny
+ * @return true jeśli token ma poprawny format
+ */
+bool SessionManager::parse(std::string_view token, TokenKey& key) {
+	if (token.size() != 32) return false;
+	uint64_t parts[2] = { 0, 0 };
+	for (size_t i = 0; i < 32; i++) {
+		char c = token[i];
+		uint64_t digit;
+		if (c >= '0' && c <= '9') digit = c - '0';
+		else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+		else return false;
+		parts[i / 16] = (parts[i / 16] << 4) | digit;
+	}
+	key = TokenKey{ parts[0], parts[1] };
+	return true;
+}
+
+/**
+ * @brief Otwiera nową sesję dla zweryfikowanego użytkownika
+ * @param user Zalogowany użytkownik
+ * @return Token sesji
+ */
+std::string SessionManager::open(User* user) {
+	std::unique_lock<std::shared_mutex> lock(Fmutex);
+	while (true) {
+		std::string token = PasswordHasher::randomHex(16);
+		TokenKey key;
+		parse(token, key);
+		if (Fsessions.emplace(key, user).second) return token;
+	}
+}
+
+/**
+ * @brief Rozpoznaje użytkownika na podstawie tokenu
+ * @param token Token sesji
+ * @return Wskaźnik na użytkownika lub nullptr
+ */
+User* SessionManager::resolve(std::string_view token) const {
+	TokenKey key;
+	if (!parse(token, key)) return nullptr;
+	std::shared_lock<std::shared_mutex> lock(Fmutex);
+	auto it = Fsessions.find(key);
+	return it == Fsessions.end() ? nullptr : it->second;
+}
+
+/**
+ * @brief Zamyka sesję
+ * @param token Token sesji
+ * @return true jeśli sesja istniała
+ */
+bool SessionManager::close(std::string_view token) {
+	TokenKey key;
+	if (!parse(token, key)) return false;
+	std::unique_lock<std::shared_mutex> lock(Fmutex);
+	return Fsessions.erase(key) > 0;
+}
+
+/**
+ * @brief Zwraca liczbę aktywnych sesji
+ * @return Liczba sesji
+ */
+size_t SessionManager::size() const {
+	std::shared_lock<std::shared_mutex> lock(Fmutex);
+	return Fsessions.size();
+}
@@ -0,0 +1,83 @@
+/**
+ * @file SessionManager.h
+ * @brief Deklaracja klasy SessionManager - tokeny sesji po zalogowaniu
+ */
+
+#pragma once
+#include "User.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <shared_mutex>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class SessionManager
+ * @brief Wydaje i rozpoznaje nieprzezroczyste tokeny sesji
+ *
+ * Po jednorazowej weryfikacji hasła użytkownik otrzymuje losowy 128-bitowy token
+ * (32 znaki szesnastkowe). Kolejne żądania w trybie wsadowym przedstawiają token,
+ * który rozpoznawany jest jednym wyszukaniem w tablicy haszującej - bez ponownego
+ * liczenia kosztownego skrótu hasła.
+ */
+class SessionManager
+{
+private:
+	/**
+	 * @struct TokenKey
+	 * @brief Token w postaci binarnej (dwa słowa 64-bitowe)
+	 */
+	struct TokenKey {
+		uint64_t Fhigh;
+		uint64_t Flow;
+		bool operator==(const TokenKey& other) const { return Fhigh == other.Fhigh && Flow == other.Flow; }
+	};
+
+	/**
+	 * @struct TokenHash
+	 * @brief Funkcja haszująca dla TokenKey (token jest losowy, więc wystarczy XOR)
+	 */
+	struct TokenHash {
+		size_t operator()(const TokenKey& key) const { return static_cast<size_t>(key.Fhigh ^ key.Flow); }
+	};
+
+	mutable std::shared_mutex Fmutex;                             ///< Chroni mapę sesji
+	std::unordered_map<TokenKey, User*, TokenHash> Fsessions;     ///< Aktywne sesje
+
+	/**
+	 * @brief Zamienia tekstowy token na postać binarną
+	 * @param token Token (32 znaki szesnastkowe)
+	 * @param key Zmienna, do której zostanie zapisany klucz
+	 * @return true jeśli token ma poprawny format
+	 */
+	static bool parse(std::string_view token, TokenKey& key);
+
+public:
+	/**
+	 * @brief Otwiera nową sesję dla zweryfikowanego użytkownika
+	 * @param user Zalogowany użytkownik
+	 * @return Token sesji
+	 */
+	std::string open(User* user);
+
+	/**
+	 * @brief Rozpoznaje użytkownika na podstawie tokenu
+	 * @param token Token sesji
+	 * @return Wskaźnik na użytkownika lub nullptr, jeśli sesja nie istnieje
+	 */
+	User* resolve(std::string_view token) const;
+
+	/**
+	 * @brief Zamyka sesję
+	 * @param token Token sesji
+	 * @return true jeśli sesja istniała
+	 */
+	bool close(std::string_view token);
+
+	/**
+	 * @brief Zwraca liczbę aktywnych sesji
+	 * @return Liczba sesji
+	 */
+	size_t size() const;
+};
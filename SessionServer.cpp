@@ -0,0 +1,237 @@
+/**
+ * @file SessionServer.cpp
+ * @brief Implementacja klasy SessionServer - poll() na gniazdach klientów i wznawianie korutyn sesji
+ */
+
+#include "SessionServer.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Konstruktor klasy SessionServer
+ * @param path Ścieżka gniazda domeny uniksowej
+ * @param factory Tworzy korutynę sesji dla kanału klienta
+ */
+SessionServer::SessionServer(std::string path, SessionFactory factory)
+	: Fpath(std::move(path)), Ffactory(std::move(factory)), Fsocket(-1) {}
+
+/**
+ * @brief Destruktor - niszczy zawieszone sesje i zamyka gniazda
+ */
+SessionServer::~SessionServer() {
+#ifndef _WIN32
+	for (const auto& client : Fclients) {
+		if (client->Fsocket >= 0) close(client->Fsocket);
+	}
+	Fclients.clear();
+	if (Fsocket >= 0) {
+		close(Fsocket);
+		unlink(Fpath.c_str());
+	}
+#endif
+}
+
+/**
+ * @brief Otwiera nieblokujące gniazdo nasłuchujące
+ * @return true jeśli gniazdo zostało otwarte
+ */
+bool SessionServer::start() {
+#ifdef _WIN32
+	std::cerr << "Blad: Sesje przez gniazdo wymagaja gniazd domeny uniksowej (Linux)." << std::endl;
+	return false;
+#else
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	if (Fpath.size() >= sizeof(address.sun_path)) {
+		std::cerr << "Blad: Zbyt dluga sciezka gniazda " << Fpath << std::endl;
+		return false;
+	}
+	Fpath.copy(address.sun_path, Fpath.size());
+
+	Fsocket = socket(AF_UNIX, SOCK_STREAM, 0);
+	unlink(Fpath.c_str());
+	if (Fsocket < 0 || bind(Fsocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(Fsocket, 128) != 0) {
+		std::cerr << "Blad: Nie mozna otworzyc gniazda sesji " << Fpath << std::endl;
+		if (Fsocket >= 0) close(Fsocket);
+		Fsocket = -1;
+		return false;
+	}
+	fcntl(Fsocket, F_SETFL, fcntl(Fsocket, F_GETFL) | O_NONBLOCK);
+	std::cout << "Sesje: gniazdo " << Fpath << std::endl;
+	return true;
+#endif
+}
+
+/**
+ * @brief Pętla zdarzeń: konsola, nowe połączenia i dane klientów
+ *
+ * Jedno wywołanie poll() obejmuje wszystkie gniazda. Dane klienta przekazywane
+ * są jego sesji linia po linii; sesja działa do kolejnego pytania, po czym jej
+ * wyjście jest wysyłane. Klienci rozłączeni lub zakończeni są usuwani po
+ * obsłudze wszystkich zdarzeń, nowe połączenia przyjmowane na końcu obiegu.
+ */
+void SessionServer::run() {
+#ifndef _WIN32
+	auto console = std::make_unique<Client>();
+	console->Fio = std::make_unique<SessionIO>(std::cout);
+	console->Fsession = Ffactory(*console->Fio);
+	console->Fsession.start();
+	std::cout.flush();
+	Fclients.push_back(std::move(console));
+
+	std::vector<pollfd> descriptors;
+	while (!Fclients.front()->Fsession.done()) {
+		descriptors.clear();
+		descriptors.push_back(pollfd{ Fsocket, POLLIN, 0 });
+		for (const auto& client : Fclients) {
+			short events = client->Fclosing ? 0 : POLLIN;
+			if (!client->Fpending.empty()) events |= POLLOUT;
+			descriptors.push_back(pollfd{ client->Fsocket < 0 ? STDIN_FILENO : client->Fsocket, events, 0 });
+		}
+		if (poll(descriptors.data(), descriptors.size(), -1) < 0) {
+			if (errno == EINTR) continue;
+			break;
+		}
+
+		// Obsługa klientów - indeks deskryptora i+1 odpowiada klientowi i
+		std::vector<bool> dropped(Fclients.size(), false);
+		for (size_t i = 0; i < Fclients.size(); i++) {
+			Client& client = *Fclients[i];
+			short revents = descriptors[i + 1].revents;
+			if (revents == 0) continue;
+			bool alive = true;
+			if (revents & (POLLIN | POLLHUP | POLLERR)) alive = receive(client);
+			if (alive) alive = flush(client);
+			dropped[i] = !alive || (client.Fclosing && client.Fpending.empty());
+		}
+
+		// Koniec wejścia konsoli kończy pętlę (sesje klientów niszczy destruktor)
+		if (dropped.front()) break;
+		for (size_t i = Fclients.size(); i-- > 1;) {
+			if (!dropped[i]) continue;
+			close(Fclients[i]->Fsocket);
+			Fclients.erase(Fclients.begin() + static_cast<std::ptrdiff_t>(i));
+		}
+
+		if (descriptors.front().revents & POLLIN) accept();
+	}
+#endif
+}
+
+/**
+ * @brief Przyjmuje oczekujące połączenia i uruchamia ich sesje (menu główne)
+ */
+void SessionServer::accept() {
+#ifndef _WIN32
+	while (true) {
+		int socket = ::accept(Fsocket, nullptr, nullptr);
+		if (socket < 0) return;
+		fcntl(socket, F_SETFL, fcntl(socket, F_GETFL) | O_NONBLOCK);
+
+		auto client = std::make_unique<Client>();
+		client->Fsocket = socket;
+		client->Fio = std::make_unique<SessionIO>();
+		client->Fsession = Ffactory(*client->Fio);
+		client->Fsession.start();
+		if (!flush(*client)) {
+			close(socket);
+			continue;
+		}
+		Fclients.push_back(std::move(client));
+	}
+#endif
+}
+
+/**
+ * @brief Odczytuje dostępne dane klienta (konsola - standardowe wejście)
+ * @param client Klient
+ * @return false przy rozłączeniu, błędzie lub zbyt długiej linii
+ */
+bool SessionServer::receive(Client& client) {
+#ifndef _WIN32
+	char buffer[4096];
+	ssize_t received = read(client.Fsocket < 0 ? STDIN_FILENO : client.Fsocket, buffer, sizeof(buffer));
+	if (received < 0) return errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK;
+	if (received == 0) return false;
+	return feed(client, buffer, static_cast<size_t>(received));
+#else
+	(void)client;
+	return false;
+#endif
+}
+
+/**
+ * @brief Przekazuje pełne linie do sesji (bez "\r\n"), resztę zostawia na kolejny odczyt
+ *
+ * Linie, które nadejdą po zakończeniu sesji, są pomijane.
+ *
+ * @param client Klient
+ * @param data Odebrane bajty
+ * @param size Liczba bajtów
+ * @return false jeśli niepełna linia przekroczyła MAX_LINE
+ */
+bool SessionServer::feed(Client& client, const char* data, size_t size) {
+	const char* end = data + size;
+	while (data < end) {
+		const char* newline = static_cast<const char*>(std::memchr(data, '\n', static_cast<size_t>(end - data)));
+		if (newline == nullptr) {
+			client.Fpartial.append(data, end);
+			break;
+		}
+		client.Fpartial.append(data, newline);
+		data = newline + 1;
+
+		if (!client.Fpartial.empty() && client.Fpartial.back() == '\r') client.Fpartial.pop_back();
+		if (client.Fpartial.size() > MAX_LINE) return false;
+		if (!client.Fsession.done()) client.Fio->push(std::move(client.Fpartial));
+		client.Fpartial.clear();
+	}
+	if (client.Fsession.done()) client.Fclosing = true;
+	return client.Fpartial.size() <= MAX_LINE;
+}
+
+/**
+ * @brief Wysyła wyjście sesji; niewysłana reszta czeka na POLLOUT
+ * @param client Klient
+ * @return false jeśli połączenie zerwano lub zaległe wyjście przekroczyło MAX_PENDING
+ */
+bool SessionServer::flush(Client& client) {
+	if (client.Fsocket < 0) {
+		std::cout.flush();
+		return true;
+	}
+#ifndef _WIN32
+	client.Fpending += client.Fio->takeOutput();
+	if (client.Fsession.done()) client.Fclosing = true;
+	size_t offset = 0;
+	while (offset < client.Fpending.size()) {
+		ssize_t sent = send(client.Fsocket, client.Fpending.data() + offset, client.Fpending.size() - offset, MSG_NOSIGNAL);
+		if (sent < 0 && errno == EINTR) continue;
+		if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+		if (sent <= 0) return false;
+		offset += static_cast<size_t>(sent);
+	}
+	client.Fpending.erase(0, offset);
+	return client.Fpending.size() <= MAX_PENDING;
+#else
+	return false;
+#endif
+}
+
+/**
+ * @brief Zwraca liczbę aktywnych sesji (z konsolą)
+ * @return Liczba sesji
+ */
+size_t SessionServer::sessions() const {
+	return Fclients.size();
+}
@@ -0,0 +1,120 @@
+/**
+ * @file SessionServer.h
+ * @brief Deklaracja klasy SessionServer - wiele sesji menu w jednym wątku (gniazdo lokalne i konsola)
+ */
+
+#pragma once
+#include "SessionIO.h"
+#include "Task.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class SessionServer
+ * @brief Pętla zdarzeń prowadząca sesje menu klientów gniazda domeny uniksowej
+ *
+ * Każde połączenie dostaje własną korutynę sesji (menu główne) i własny
+ * SessionIO. Pętla czeka w poll() na wszystkie gniazda naraz; gdy od klienta
+ * nadejdzie pełna linia, wznawia jego korutynę do kolejnego pytania,
+ * a zbuforowane wyjście wysyła bez blokowania. Sesja czekająca na odpowiedź
+ * zajmuje tylko ramkę korutyny - nie wątek.
+ *
+ * Wszystkie sesje działają w wątku wywołującym run(), więc katalog pociągów,
+ * pamięć podręczna wyszukiwania i konta użytkowników nie wymagają dodatkowych
+ * blokad; rezerwacje nadal przechodzą przez BookingEngine (i jego partycje).
+ *
+ * Konsola (standardowe wejście i wyjście) jest jednym z klientów - pętla
+ * kończy się razem z jej sesją. Klient, który wysyła zbyt długie linie albo
+ * nie odbiera wyjścia, jest rozłączany, a jego sesja niszczona.
+ */
+class SessionServer
+{
+public:
+	using SessionFactory = std::function<Task<void>(SessionIO&)>;   ///< Tworzy korutynę sesji dla kanału
+
+	static constexpr size_t MAX_LINE = 4096;            ///< Najdłuższa linia od klienta (bajty)
+	static constexpr size_t MAX_PENDING = 1 << 20;      ///< Najwięcej niewysłanego wyjścia klienta (bajty)
+
+private:
+	/**
+	 * @struct Client
+	 * @brief Połączenie z jedną sesją
+	 */
+	struct Client {
+		int Fsocket = -1;                   ///< Gniazdo klienta (-1 - konsola)
+		std::unique_ptr<SessionIO> Fio;     ///< Kanał sesji (stały adres - trzyma go korutyna)
+		Task<void> Fsession;                ///< Korutyna sesji
+		std::string Fpartial;               ///< Odebrana niepełna linia
+		std::string Fpending;               ///< Wyjście czekające na wysłanie
+		bool Fclosing = false;              ///< Sesja zakończona - rozłączyć po wysłaniu wyjścia
+	};
+
+	std::string Fpath;                                ///< Ścieżka gniazda
+	SessionFactory Ffactory;                          ///< Tworzy sesje nowych klientów
+	int Fsocket;                                      ///< Gniazdo nasłuchujące (-1 - nieaktywne)
+	std::vector<std::unique_ptr<Client>> Fclients;    ///< Aktywne sesje (pierwsza - konsola)
+
+	/**
+	 * @brief Przyjmuje nowe połączenie i uruchamia jego sesję
+	 */
+	void accept();
+
+	/**
+	 * @brief Odczytuje dane klienta i przekazuje pełne linie do jego sesji
+	 * @param client Klient
+	 * @return false jeśli klient się rozłączył lub przekroczył limit linii
+	 */
+	bool receive(Client& client);
+
+	/**
+	 * @brief Przekazuje pełne linie odebranych danych do sesji
+	 * @param client Klient
+	 * @param data Odebrane bajty
+	 * @param size Liczba bajtów
+	 * @return false jeśli linia przekroczyła MAX_LINE
+	 */
+	bool feed(Client& client, const char* data, size_t size);
+
+	/**
+	 * @brief Wysyła zbuforowane wyjście sesji bez blokowania
+	 * @param client Klient
+	 * @return false jeśli połączenie zerwano lub klient nie nadąża odbierać
+	 */
+	bool flush(Client& client);
+
+public:
+	/**
+	 * @brief Konstruktor klasy SessionServer
+	 * @param path Ścieżka gniazda domeny uniksowej
+	 * @param factory Tworzy korutynę sesji dla kanału klienta
+	 */
+	SessionServer(std::string path, SessionFactory factory);
+
+	/**
+	 * @brief Destruktor - niszczy sesje i zamyka gniazda
+	 */
+	~SessionServer();
+
+	SessionServer(const SessionServer&) = delete;
+	SessionServer& operator=(const SessionServer&) = delete;
+
+	/**
+	 * @brief Otwiera gniazdo nasłuchujące
+	 * @return true jeśli gniazdo zostało otwarte
+	 */
+	bool start();
+
+	/**
+	 * @brief Prowadzi sesję konsoli i sesje klientów aż do zakończenia sesji konsoli
+	 */
+	void run();
+
+	/**
+	 * @brief Zwraca liczbę aktywnych sesji (z konsolą)
+	 * @return Liczba sesji
+	 */
+	size_t sessions() const;
+};
@@ -0,0 +1,87 @@
+/**
+ * @file ShardPool.cpp
+ * @brief Implementacja klasy ShardPool - zlecenia dla wszystkich partycji i oczekiwanie na wynik
+ */
+
+#include "ShardPool.h"
+#include <algorithm>
+
+/**
+ * @brief Konstruktor klasy ShardPool - uruchamia wątki robocze
+ * @param shards Liczba partycji (0 - liczba rdzeni procesora)
+ */
+ShardPool::ShardPool(size_t shards) : Fround(0), Fpending(0), Fstopping(false) {
+	if (shards == 0) shards = std::max(1u, std::thread::hardware_concurrency());
+	if (shards == 1) return;
+
+	Fworkers.reserve(shards);
+	for (size_t shard = 0; shard < shards; shard++) Fworkers.emplace_back(&ShardPool::work, this, shard);
+}
+
+/**
+ * @brief Destruktor - budzi i kończy wątki robocze
+ */
+ShardPool::~ShardPool() {
+	{
+		std::lock_guard<std::mutex> lock(Fmutex);
+		Fstopping = true;
+	}
+	FtaskReady.notify_all();
+	for (std::thread& worker : Fworkers) worker.join();
+}
+
+/**
+ * @brief Pętla wątku roboczego - czeka na kolejne zlecenie i wykonuje je dla swojej partycji
+ * @param shard Numer partycji
+ */
+void ShardPool::work(size_t shard) {
+	uint64_t seen = 0;
+	while (true) {
+		std::function<void(size_t)> task;
+		{
+			std::unique_lock<std::mutex> lock(Fmutex);
+			FtaskReady.wait(lock, [this, seen] { return Fstopping || Fround != seen; });
+			if (Fstopping) return;
+			seen = Fround;
+			task = Ftask;
+		}
+
+		task(shard);
+
+		std::lock_guard<std::mutex> lock(Fmutex);
+		if (--Fpending == 0) FtaskDone.notify_one();
+	}
+}
+
+/**
+ * @brief Zwraca liczbę partycji
+ * @return Liczba partycji
+ */
+size_t ShardPool::size() const { return Fworkers.empty() ? 1 : Fworkers.size(); }
+
+/**
+ * @brief Zwraca partycję pociągu
+ * @param trainId ID pociągu
+ * @return Numer partycji
+ */
+size_t ShardPool::shardOf(int trainId) const { return static_cast<uint32_t>(trainId) % size(); }
+
+/**
+ * @brief Wykonuje zadanie na wszystkich partycjach i czeka na zakończenie
+ * @param task Zadanie wywoływane jako task(numer partycji)
+ */
+void ShardPool::scatter(const std::function<void(size_t)>& task) {
+	if (Fworkers.empty()) {
+		task(0);
+		return;
+	}
+
+	std::lock_guard<std::mutex> scatterLock(FscatterMutex);
+	std::unique_lock<std::mutex> lock(Fmutex);
+	Ftask = task;
+	Fpending = Fworkers.size();
+	Fround++;
+	FtaskReady.notify_all();
+	FtaskDone.wait(lock, [this] { return Fpending == 0; });
+	Ftask = nullptr;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file ShardPool.h
+ * @brief Deklaracja klasy ShardPool - wątki robocze do równoległego wykonania partii wsadowych i przeglądów
+ */
+
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ShardPool
+ * @brief Stała pula wątków - jeden wątek roboczy na partycję (shard) pociągów
+ *
+ * Pociąg należy do partycji shardOf(ID) = ID modulo liczba partycji, więc
+ * pociąg zawsze obsługuje ten sam wątek, a jego mapa miejsc pozostaje
+ * w pamięci podręcznej jednego rdzenia. scatter() zleca zadanie wszystkim
+ * partycjom naraz i czeka, aż każda skończy (scatter-gather); wyniki
+ * zbiera wywołujący, zwykle w tablicy indeksowanej numerem partycji.
+ *
+ * Partycje dzielą tylko pracę, nie dane: pociągi, bilety, indeksy i pliki
+ * migawek pozostają wspólne (TrainCatalog, TicketStore, DataManager).
+ * Pula służy do równoległego stosowania dużych partii wsadowych
+ * (BookingEngine::applyGrouped) i pełnego przeglądu dużego katalogu
+ * (SearchCache::search).
+ *
+ * Pula z jedną partycją nie uruchamia wątków - zadanie wykonywane jest
+ * w wątku wywołującym. Program domyślnie tworzy jedną partycję (--shards).
+ */
+class ShardPool
+{
+	std::vector<std::thread> Fworkers;                  ///< Wątki robocze (po jednym na partycję)
+	std::function<void(size_t)> Ftask;                  ///< Bieżące zadanie (argument - numer partycji)
+	uint64_t Fround;                                    ///< Numer bieżącego zlecenia
+	size_t Fpending;                                    ///< Liczba partycji, które jeszcze pracują
+	bool Fstopping;                                     ///< Czy pula jest zamykana
+	std::mutex Fmutex;                                  ///< Chroni stan zlecenia
+	std::condition_variable FtaskReady;                 ///< Nowe zlecenie lub zamknięcie
+	std::condition_variable FtaskDone;                  ///< Wszystkie partycje skończyły
+	std::mutex FscatterMutex;                           ///< Jedno zlecenie naraz
+
+	/**
+	 * @brief Pętla wątku roboczego partycji
+	 * @param shard Numer partycji
+	 */
+	void work(size_t shard);
+
+public:
+	/**
+	 * @brief Konstruktor klasy ShardPool
+	 * @param shards Liczba partycji (0 - liczba rdzeni procesora)
+	 */
+	explicit ShardPool(size_t shards);
+
+	/**
+	 * @brief Destruktor - kończy wątki robocze
+	 */
+	~ShardPool();
+
+	ShardPool(const ShardPool&) = delete;
+	ShardPool& operator=(const ShardPool&) = delete;
+
+	/**
+	 * @brief Zwraca liczbę partycji
+	 * @return Liczba partycji (co najmniej 1)
+	 */
+	size_t size() const;
+
+	/**
+	 * @brief Zwraca partycję pociągu
+	 * @param trainId ID pociągu
+	 * @return Numer partycji
+	 */
+	size_t shardOf(int trainId) const;
+
+	/**
+	 * @brief Wykonuje zadanie na wszystkich partycjach równolegle i czeka na zakończenie
+	 * @param task Zadanie wywoływane jako task(numer partycji) w wątku tej partycji
+	 */
+	void scatter(const std::function<void(size_t)>& task);
+};
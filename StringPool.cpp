@@ -0,0 +1,60 @@
+/**
+ * @file StringPool.cpp
+ * @brief Implementacja klasy StringPool - internowanie nazw stacji i loginów
+ */
+
+#include "StringPool.h"
+
+/**
+ * @brief Zwraca identyfikator napisu, dodając go do puli przy pierwszym wystąpieniu
+ *
+ * Klucze mapy wskazują na napisy przechowywane w deque, więc pozostają ważne
+ * po dodaniu kolejnych elementów.
+ *
+ * @param text Napis do zinternowania
+ * @return Stały identyfikator napisu
+ */
+uint32_t StringPool::intern(std::string_view text) {
+	auto it = Findex.find(text);
+	if (it != Findex.end()) return it->second;
+
+	uint32_t id = static_cast<uint32_t>(Fstrings.size());
+	Fstrings.emplace_back(text);
+	Findex.emplace(Fstrings.back(), id);
+	return id;
+}
+
+/**
+ * @brief Wyszukuje identyfikator napisu bez dodawania go do puli
+ * @param text Szukany napis
+ * @param id Zmienna, do której zostanie zapisany identyfikator
+ * @return true jeśli napis znajduje się w puli
+ */
+bool StringPool::find(std::string_view text, uint32_t& id) const {
+	auto it = Findex.find(text);
+	if (it == Findex.end()) return false;
+	id = it->second;
+	return true;
+}
+
+// Dostęp do napisów i rozmiaru puli
+const std::string& StringPool::get(uint32_t id) const { return Fstrings[id]; }
+size_t StringPool::size() const { return Fstrings.size(); }
+
+/**
+ * @brief Globalna pula nazw stacji (tworzona przy pierwszym użyciu)
+ * @return Referencja do puli stacji
+ */
+StringPool& StringPool::stations() {
+	static StringPool pool;
+	return pool;
+}
+
+/**
+ * @brief Globalna pula loginów użytkowników (tworzona przy pierwszym użyciu)
+ * @return Referencja do puli loginów
+ */
+StringPool& StringPool::logins() {
+	static StringPool pool;
+	return pool;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file StringPool.h
+ * @brief Deklaracja klasy StringPool - globalna tablica internowania napisów
+ */
+
+#pragma once
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <cstdint>
+
+/**
+ * @class StringPool
+ * @brief Tablica internowania - przypisuje każdemu unikalnemu napisowi stały 32-bitowy identyfikator
+ *
+ * Każdy napis przechowywany jest dokładnie raz, a obiekty domenowe (Train, Ticket, User)
+ * trzymają jedynie jego identyfikator. Porównanie dwóch nazw sprowadza się wtedy
+ * do porównania liczb całkowitych. Identyfikatory są stabilne przez cały czas działania programu.
+ *
+ * Istnieją dwie osobne pule: nazw stacji oraz loginów użytkowników.
+ */
+class StringPool
+{
+private:
+	std::deque<std::string> Fstrings;                            ///< Przechowywane napisy (deque nie przenosi elementów)
+	std::unordered_map<std::string_view, uint32_t> Findex;      ///< Mapa napis -> identyfikator
+
+public:
+	/**
+	 * @brief Zwraca identyfikator napisu, dodając go do puli przy pierwszym wystąpieniu
+	 * @param text Napis do zinternowania
+	 * @return Stały identyfikator napisu
+	 */
+	uint32_t intern(std::string_view text);
+
+	/**
+	 * @brief Wyszukuje identyfikator napisu bez dodawania go do puli
+	 * @param text Szukany napis
+	 * @param id Zmienna, do której zostanie zapisany identyfikator
+	 * @return true jeśli napis znajduje się w puli
+	 */
+	bool find(std::string_view text, uint32_t& id) const;
+
+	/**
+	 * @brief Zwraca napis o podanym identyfikatorze
+	 * @param id Identyfikator zwrócony wcześniej przez intern()
+	 * @return Referencja do przechowywanego napisu (ważna do końca działania programu)
+	 */
+	const std::string& get(uint32_t id) const;
+
+	/**
+	 * @brief Zwraca liczbę unikalnych napisów w puli
+	 * @return Liczba napisów
+	 */
+	size_t size() const;
+
+	/**
+	 * @brief Globalna pula nazw stacji
+	 * @return Referencja do puli stacji
+	 */
+	static StringPool& stations();
+
+	/**
+	 * @brief Globalna pula loginów użytkowników
+	 * @return Referencja do puli loginów
+	 */
+	static StringPool& logins();
+};
@@ -0,0 +1,182 @@
+/**
+ * @file Task.h
+ * @brief Deklaracja szablonu Task - korutyna z wynikiem, wznawiająca wywołującego po zakończeniu
+ */
+
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+/**
+ * @struct TaskPromiseBase
+ * @brief Część obietnicy wspólna dla wyników i void - kontynuacja po zakończeniu
+ */
+struct TaskPromiseBase {
+	std::coroutine_handle<> Fcontinuation;   ///< Korutyna czekająca na wynik (pusta - najwyższy poziom)
+
+	/**
+	 * @struct FinalAwaiter
+	 * @brief Końcowe zawieszenie - przekazuje sterowanie czekającej korutynie
+	 */
+	struct FinalAwaiter {
+		bool await_ready() const noexcept { return false; }
+
+		template <typename Promise>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> finished) noexcept {
+			std::coroutine_handle<> continuation = finished.promise().Fcontinuation;
+			return continuation ? continuation : std::noop_coroutine();
+		}
+
+		void await_resume() const noexcept {}
+	};
+
+	std::suspend_always initial_suspend() const noexcept { return {}; }
+	FinalAwaiter final_suspend() const noexcept { return {}; }
+	void unhandled_exception() const noexcept { std::terminate(); }
+};
+
+/**
+ * @class Task
+ * @brief Leniwa korutyna C++20 zwracająca wynik typu T (lub void)
+ *
+ * Korutyna nie startuje przy wywołaniu - dopiero co_await (albo start()
+ * dla korutyny najwyższego poziomu). Po zakończeniu wznawia bezpośrednio
+ * korutynę, która na nią czekała (przekazanie symetryczne - bez wzrostu stosu),
+ * więc zagnieżdżone wywołania co_await readInt(...) zawieszają cały łańcuch
+ * aż do pętli zdarzeń.
+ *
+ * Task jest właścicielem ramki korutyny. Zniszczenie zawieszonej korutyny
+ * najwyższego poziomu niszczy też ramki korutyn, na które czeka
+ * (np. sesja rozłączonego klienta).
+ *
+ * @tparam T Typ wyniku
+ */
+template <typename T = void>
+class Task
+{
+public:
+	struct promise_type;
+	using Handle = std::coroutine_handle<promise_type>;
+
+	/**
+	 * @struct promise_type
+	 * @brief Obietnica korutyny zwracającej wynik
+	 */
+	struct promise_type : TaskPromiseBase {
+		std::optional<T> Fvalue;   ///< Wynik (po co_return)
+
+		Task get_return_object() { return Task(Handle::from_promise(*this)); }
+		void return_value(T value) { Fvalue = std::move(value); }
+	};
+
+private:
+	Handle Fhandle;   ///< Ramka korutyny
+
+	explicit Task(Handle handle) : Fhandle(handle) {}
+
+public:
+	Task() = default;
+	Task(Task&& other) noexcept : Fhandle(std::exchange(other.Fhandle, {})) {}
+	Task& operator=(Task&& other) noexcept {
+		if (this != &other) {
+			if (Fhandle) Fhandle.destroy();
+			Fhandle = std::exchange(other.Fhandle, {});
+		}
+		return *this;
+	}
+	Task(const Task&) = delete;
+	Task& operator=(const Task&) = delete;
+
+	/**
+	 * @brief Destruktor - niszczy ramkę korutyny (także zawieszonej)
+	 */
+	~Task() {
+		if (Fhandle) Fhandle.destroy();
+	}
+
+	/**
+	 * @brief Uruchamia korutynę najwyższego poziomu (do pierwszego zawieszenia)
+	 */
+	void start() { Fhandle.resume(); }
+
+	/**
+	 * @brief Sprawdza czy korutyna zakończyła działanie
+	 * @return true po co_return
+	 */
+	bool done() const { return !Fhandle || Fhandle.done(); }
+
+	// Oczekiwanie na wynik: co_await task
+	bool await_ready() const noexcept { return false; }
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept {
+		Fhandle.promise().Fcontinuation = continuation;
+		return Fhandle;
+	}
+	T await_resume() { return std::move(*Fhandle.promise().Fvalue); }
+};
+
+/**
+ * @class Task<void>
+ * @brief Korutyna bez wyniku (np. sesja, pozycja menu)
+ */
+template <>
+class Task<void>
+{
+public:
+	struct promise_type;
+	using Handle = std::coroutine_handle<promise_type>;
+
+	/**
+	 * @struct promise_type
+	 * @brief Obietnica korutyny bez wyniku
+	 */
+	struct promise_type : TaskPromiseBase {
+		Task get_return_object() { return Task(Handle::from_promise(*this)); }
+		void return_void() const noexcept {}
+	};
+
+private:
+	Handle Fhandle;   ///< Ramka korutyny
+
+	explicit Task(Handle handle) : Fhandle(handle) {}
+
+public:
+	Task() = default;
+	Task(Task&& other) noexcept : Fhandle(std::exchange(other.Fhandle, {})) {}
+	Task& operator=(Task&& other) noexcept {
+		if (this != &other) {
+			if (Fhandle) Fhandle.destroy();
+			Fhandle = std::exchange(other.Fhandle, {});
+		}
+		return *this;
+	}
+	Task(const Task&) = delete;
+	Task& operator=(const Task&) = delete;
+
+	/**
+	 * @brief Destruktor - niszczy ramkę korutyny (także zawieszonej)
+	 */
+	~Task() {
+		if (Fhandle) Fhandle.destroy();
+	}
+
+	/**
+	 * @brief Uruchamia korutynę najwyższego poziomu (do pierwszego zawieszenia)
+	 */
+	void start() { Fhandle.resume(); }
+
+	/**
+	 * @brief Sprawdza czy korutyna zakończyła działanie
+	 * @return true po zakończeniu
+	 */
+	bool done() const { return !Fhandle || Fhandle.done(); }
+
+	// Oczekiwanie na zakończenie: co_await task
+	bool await_ready() const noexcept { return false; }
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept {
+		Fhandle.promise().Fcontinuation = continuation;
+		return Fhandle;
+	}
+	void await_resume() const noexcept {}
+};
@@ -4,8 +4,7 @@
  */
 
 #include "Ticket.h"
-#include <sstream>
-#include <iomanip>
+#include "StringPool.h"
 
 /**
  * @brief Konstruktor klasy Ticket - inicjalizuje bilet
@@ -15,13 +14,25 @@
  * @param seat Numer miejsca
  * @param price Cena biletu w PLN
  */
-Ticket::Ticket(int id, int tID, std::string login, int seat, double price) : 
-	FticketId(id), trainId(tID), passengerLogin(login), seatNumber(seat), Fprice(price) {}
+Ticket::Ticket(int id, int tID, std::string_view login, int seat, double price) : 
+	FticketId(id), trainId(tID), passengerId(StringPool::logins().intern(login)), seatNumber(seat), Fprice(price) {}
+
+/**
+ * @brief Konstruktor klasy Ticket z już zinternowanym loginem (np. przy odczycie z TicketStore)
+ * @param id Unikalny identyfikator biletu
+ * @param tID ID pociągu
+ * @param passengerId Identyfikator loginu w StringPool::logins()
+ * @param seat Numer miejsca
+ * @param price Cena biletu w PLN
+ */
+Ticket::Ticket(int id, int tID, uint32_t passengerId, int seat, double price) :
+	FticketId(id), trainId(tID), passengerId(passengerId), seatNumber(seat), Fprice(price) {}
 
 // Gettery - zwracają podstawowe informacje o bilecie
 int Ticket::getTicketId() const { return FticketId; }
 int Ticket::getTrainId() const { return trainId; }
-std::string Ticket::getPassengerLogin() const { return passengerLogin; }
+const std::string& Ticket::getPassengerLogin() const { return StringPool::logins().get(passengerId); }
+uint32_t Ticket::getPassengerId() const { return passengerId; }
 int Ticket::getSeatNumber() const { return seatNumber; }
 double Ticket::getPrice() const { return Fprice; }
 
@@ -49,11 +60,19 @@ void Ticket::setSeatNumber(int newSeat) {
  * @return Tekstowa reprezentacja biletu
  */
 std::string Ticket::toString() const {
+	OutputBuffer text;
+	appendTo(text);
+	return std::string(text.view());
+}
 
-	std::stringstream text;
-	text << std::fixed << std::setprecision(2);
-
-	text << "Bilet #" << FticketId << " | Pociag ID: " << trainId << " | Miejsce " << seatNumber << " | Cena: " << Fprice << " PLN" << " | Pasazer: " << passengerLogin;
-
-	return text.str();
-}
\ No newline at end of file
+/**
+ * @brief Dopisuje tekstową reprezentację biletu do bufora
+ *
+ * Format jest taki sam jak w toString(); cena formatowana przez std::to_chars.
+ *
+ * @param out Bufor wyjścia
+ */
+void Ticket::appendTo(OutputBuffer& out) const {
+	out << "Bilet #" << FticketId << " | Pociag ID: " << trainId << " | Miejsce " << seatNumber << " | Cena: "
+		<< OutputBuffer::Fixed{ Fprice, 2 } << " PLN" << " | Pasazer: " << StringPool::logins().get(passengerId);
+}
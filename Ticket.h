@@ -4,7 +4,10 @@
  */
 
 #pragma once
+#include "OutputBuffer.h"
 #include <string>
+#include <string_view>
+#include <cstdint>
 
 /**
  * @class Ticket
@@ -21,7 +24,7 @@ class Ticket
 private:
 	int FticketId;                ///< Unikalny identyfikator biletu
 	int trainId;                  ///< ID pociągu, na który wystawiony jest bilet
-	std::string passengerLogin;   ///< Login pasażera będącego właścicielem biletu
+	uint32_t passengerId;         ///< Identyfikator loginu pasażera w StringPool::logins()
 	int seatNumber;               ///< Numer zarezerwowanego miejsca
 	double Fprice;                ///< Cena biletu w PLN
 
@@ -34,7 +37,17 @@ public:
 	 * @param seat Numer miejsca
 	 * @param price Cena biletu
 	 */
-	Ticket(int id, int tID, std::string login, int seat, double price);
+	Ticket(int id, int tID, std::string_view login, int seat, double price);
+
+	/**
+	 * @brief Konstruktor klasy Ticket z już zinternowanym loginem
+	 * @param id Unikalny identyfikator biletu
+	 * @param tID ID pociągu
+	 * @param passengerId Identyfikator loginu w StringPool::logins()
+	 * @param seat Numer miejsca
+	 * @param price Cena biletu
+	 */
+	Ticket(int id, int tID, uint32_t passengerId, int seat, double price);
 
 	/**
 	 * @brief Zwraca ID biletu
@@ -50,9 +63,15 @@ public:
 	
 	/**
 	 * @brief Zwraca login pasażera
-	 * @return Login właściciela biletu
+	 * @return Login właściciela biletu (referencja do napisu w puli loginów)
 	 */
-	std::string getPassengerLogin() const;
+	const std::string& getPassengerLogin() const;
+
+	/**
+	 * @brief Zwraca zinternowany identyfikator loginu pasażera
+	 * @return Identyfikator w puli StringPool::logins()
+	 */
+	uint32_t getPassengerId() const;
 	
 	/**
 	 * @brief Zwraca numer miejsca
@@ -77,4 +96,10 @@ public:
 	 * @return Tekstowa reprezentacja biletu ze wszystkimi szczegółami
 	 */
 	std::string toString() const;
+
+	/**
+	 * @brief Dopisuje tekstową reprezentację biletu (jak toString) do bufora
+	 * @param out Bufor wyjścia
+	 */
+	void appendTo(OutputBuffer& out) const;
 };
\ No newline at end of file
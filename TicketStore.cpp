@@ -0,0 +1,230 @@
+/**
+ * @file TicketStore.cpp
+ * @brief Implementacja klasy TicketStore - kolumnowy magazyn biletów
+ */
+
+#include "TicketStore.h"
+
+/**
+ * @brief Dodaje nowy bilet na końcu wszystkich kolumn
+ *
+ * Istniejący żywy bilet o tym samym ID nie jest nadpisywany - jego wiersz
+ * zostałby odcięty od indeksu, a nadal liczyłby się do przychodu.
+ *
+ * @param id ID biletu
+ * @param trainId ID pociągu
+ * @param passengerId Identyfikator loginu pasażera
+ * @param seat Numer miejsca
+ * @param price Cena biletu
+ * @return false jeśli bilet o tym ID już istnieje
+ */
+bool TicketStore::add(int id, int trainId, uint32_t passengerId, int seat, double price) {
+	if (FrowById.count(id)) return false;
+
+	FticketIds.push_back(id);
+	FtrainIds.push_back(trainId);
+	FpassengerIds.push_back(passengerId);
+	Fseats.push_back(seat);
+	Fprices.push_back(price);
+
+	uint32_t row = static_cast<uint32_t>(FticketIds.size() - 1);
+	auto& trainRows = FrowsByTrain[trainId];
+	FtrainListPos.push_back(static_cast<uint32_t>(trainRows.size()));
+	trainRows.push_back(row);
+	FrowById.emplace(id, row);
+	FliveCount++;
+	return true;
+}
+
+// Rozmiar i dostęp do pól wiersza
+size_t TicketStore::size() const { return FliveCount; }
+bool TicketStore::empty() const { return FliveCount == 0; }
+size_t TicketStore::rows() const { return FticketIds.size(); }
+bool TicketStore::isAlive(size_t row) const { return FpassengerIds[row] != NO_PASSENGER; }
+int TicketStore::ticketId(size_t row) const { return FticketIds[row]; }
+int TicketStore::trainId(size_t row) const { return FtrainIds[row]; }
+uint32_t TicketStore::passengerId(size_t row) const { return FpassengerIds[row]; }
+int TicketStore::seat(size_t row) const { return Fseats[row]; }
+double TicketStore::price(size_t row) const { return Fprices[row]; }
+void TicketStore::setSeat(size_t row, int newSeat) { Fseats[row] = newSeat; }
+
+/**
+ * @brief Zwraca najwyższe ID biletu (przegląd samej kolumny ID)
+ * @return Najwyższe ID lub 0 gdy magazyn jest pusty
+ */
+int TicketStore::maxTicketId() const {
+	int maxId = 0;
+	for (int id : FticketIds) {
+		if (id > maxId) maxId = id;
+	}
+	return maxId;
+}
+
+/**
+ * @brief Tworzy obiekt Ticket z danych wiersza
+ * @param row Numer wiersza
+ * @return Bilet z danymi z kolumn
+ */
+Ticket TicketStore::at(size_t row) const {
+	return Ticket(FticketIds[row], FtrainIds[row], FpassengerIds[row], Fseats[row], Fprices[row]);
+}
+
+/**
+ * @brief Wyszukuje wiersz biletu należącego do pasażera
+ *
+ * Wiersz znajdowany jest w indeksie ID biletu, właściciel sprawdzany w kolumnie pasażerów.
+ *
+ * @param ticketId ID biletu
+ * @param passengerId Identyfikator loginu właściciela
+ * @return Numer wiersza lub NPOS
+ */
+size_t TicketStore::findRow(int ticketId, uint32_t passengerId) const {
+	auto it = FrowById.find(ticketId);
+	if (it == FrowById.end() || FpassengerIds[it->second] != passengerId) return NPOS;
+	return it->second;
+}
+
+/**
+ * @brief Oznacza wiersz jako martwy
+ *
+ * Zeruje cenę, ustawia NO_PASSENGER i usuwa bilet z indeksu ID.
+ *
+ * @param row Numer wiersza
+ */
+void TicketStore::markDead(size_t row) {
+	FpassengerIds[row] = NO_PASSENGER;
+	Fprices[row] = 0.0;
+	FrowById.erase(FticketIds[row]);
+	FliveCount--;
+}
+
+/**
+ * @brief Usuwa bilet w czasie O(1)
+ *
+ * Wiersz oznaczany jest jako martwy (dane nie są przesuwane), a z listy biletów
+ * pociągu usuwany przez zamianę z ostatnim elementem listy.
+ *
+ * @param row Numer wiersza (NPOS - brak zmian)
+ */
+void TicketStore::remove(size_t row) {
+	if (row == NPOS || !isAlive(row)) return;
+	markDead(row);
+
+	auto& trainRows = FrowsByTrain[FtrainIds[row]];
+	uint32_t pos = FtrainListPos[row];
+	uint32_t movedRow = trainRows.back();
+	trainRows[pos] = movedRow;
+	FtrainListPos[movedRow] = pos;
+	trainRows.pop_back();
+	if (trainRows.empty()) FrowsByTrain.erase(FtrainIds[row]);
+
+	compactIfNeeded();
+}
+
+/**
+ * @brief Usuwa wszystkie bilety wystawione na dany pociąg
+ *
+ * Odwiedza tylko wiersze z listy biletów pociągu i oznacza je jako martwe.
+ *
+ * @param trainId ID pociągu
+ * @return Liczba usuniętych biletów
+ */
+size_t TicketStore::removeByTrain(int trainId) {
+	auto it = FrowsByTrain.find(trainId);
+	if (it == FrowsByTrain.end()) return 0;
+
+	size_t removed = it->second.size();
+	for (uint32_t row : it->second) {
+		markDead(row);
+	}
+	FrowsByTrain.erase(it);
+	compactIfNeeded();
+	return removed;
+}
+
+/**
+ * @brief Sumuje kolumnę cen
+ *
+ * Martwe wiersze mają cenę 0, więc pętla nie zawiera warunków
+ * i może zostać zwektoryzowana przez kompilator.
+ *
+ * @return Całkowity przychód
+ */
+double TicketStore::totalRevenue() const {
+	double total = 0.0;
+	const double* prices = Fprices.data();
+	const size_t n = Fprices.size();
+	for (size_t i = 0; i < n; i++) {
+		total += prices[i];
+	}
+	return total;
+}
+
+/**
+ * @brief Usuwa wszystkie bilety
+ */
+void TicketStore::clear() {
+	FticketIds.clear();
+	FtrainIds.clear();
+	FpassengerIds.clear();
+	Fseats.clear();
+	Fprices.clear();
+	FtrainListPos.clear();
+	FliveCount = 0;
+	FrowById.clear();
+	FrowsByTrain.clear();
+}
+
+/**
+ * @brief Fizycznie usuwa martwe wiersze ze wszystkich kolumn
+ *
+ * Przesuwa żywe wiersze na początek, zachowując ich kolejność.
+ */
+void TicketStore::compact() {
+	size_t out = 0;
+	for (size_t i = 0; i < FpassengerIds.size(); i++) {
+		if (FpassengerIds[i] == NO_PASSENGER) continue;
+		if (out != i) {
+			FticketIds[out] = FticketIds[i];
+			FtrainIds[out] = FtrainIds[i];
+			FpassengerIds[out] = FpassengerIds[i];
+			Fseats[out] = Fseats[i];
+			Fprices[out] = Fprices[i];
+		}
+		out++;
+	}
+	FticketIds.resize(out);
+	FtrainIds.resize(out);
+	FpassengerIds.resize(out);
+	Fseats.resize(out);
+	Fprices.resize(out);
+	FtrainListPos.resize(out);
+	rebuildIndexes();
+}
+
+/**
+ * @brief Odbudowuje indeksy ID biletu i list biletów pociągów
+ *
+ * Wywoływane po zagęszczeniu, gdy numery wierszy uległy zmianie.
+ */
+void TicketStore::rebuildIndexes() {
+	FrowById.clear();
+	FrowsByTrain.clear();
+	for (size_t i = 0; i < FticketIds.size(); i++) {
+		uint32_t row = static_cast<uint32_t>(i);
+		auto& trainRows = FrowsByTrain[FtrainIds[i]];
+		FtrainListPos[i] = static_cast<uint32_t>(trainRows.size());
+		trainRows.push_back(row);
+		FrowById[FticketIds[i]] = row;
+	}
+}
+
+/**
+ * @brief Zagęszcza magazyn, gdy martwe wiersze stanowią ponad połowę wierszy
+ *
+ * Koszt zagęszczenia rozkłada się na wcześniejsze usunięcia (amortyzowane O(1)).
+ */
+void TicketStore::compactIfNeeded() {
+	size_t dead = rows() - FliveCount;
+	if (dead > 64 && dead * 2 > rows()) compact();
+}
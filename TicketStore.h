@@ -0,0 +1,204 @@
+/**
+ * @file TicketStore.h
+ * @brief Deklaracja klasy TicketStore - kolumnowy magazyn biletów
+ */
+
+#pragma once
+#include "Ticket.h"
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class TicketStore
+ * @brief Magazyn biletów w układzie struktury tablic (kolumn)
+ *
+ * Zamiast wektora obiektów Ticket przechowuje osobne tablice: ID biletów, ID pociągów,
+ * identyfikatorów pasażerów, numerów miejsc i cen. Pełne przeglądy (raporty, wyszukiwanie
+ * biletów pasażera, usuwanie biletów pociągu) czytają tylko potrzebne kolumny, ciągłe w pamięci.
+ *
+ * Usunięcie biletu nie przesuwa danych - wiersz oznaczany jest jako martwy (tombstone):
+ * cena jest zerowana, a identyfikator pasażera ustawiany na wartość NO_PASSENGER.
+ * Dzięki temu sumowanie cen i wyszukiwanie po pasażerze nie wymaga sprawdzania flagi.
+ * Gdy martwe wiersze stanowią znaczną część magazynu, wykonywane jest automatyczne zagęszczenie.
+ *
+ * Dodatkowe indeksy zapewniają operacje w czasie stałym:
+ * - ID biletu -> wiersz (anulowanie bez przeglądania magazynu)
+ * - ID pociągu -> lista wierszy jego biletów (usunięcie pociągu kosztuje tyle, ile ma biletów)
+ *
+ * Uwaga: numery wierszy są ważne tylko do następnego wywołania remove(), removeByTrain() lub compact().
+ */
+class TicketStore
+{
+public:
+	static constexpr uint32_t NO_PASSENGER = 0xFFFFFFFFu;  ///< Identyfikator pasażera w martwym wierszu
+	static constexpr size_t NPOS = static_cast<size_t>(-1); ///< Wartość zwracana gdy nie znaleziono wiersza
+
+private:
+	std::vector<int> FticketIds;          ///< Kolumna ID biletów
+	std::vector<int> FtrainIds;           ///< Kolumna ID pociągów
+	std::vector<uint32_t> FpassengerIds;  ///< Kolumna zinternowanych loginów (NO_PASSENGER = martwy wiersz)
+	std::vector<int> Fseats;              ///< Kolumna numerów miejsc
+	std::vector<double> Fprices;          ///< Kolumna cen (0 w martwych wierszach)
+	std::vector<uint32_t> FtrainListPos;  ///< Pozycja wiersza na liście biletów jego pociągu
+	size_t FliveCount = 0;                ///< Liczba żywych biletów
+
+	std::unordered_map<int, uint32_t> FrowById;                    ///< Indeks ID biletu -> wiersz
+	std::unordered_map<int, std::vector<uint32_t>> FrowsByTrain;   ///< Indeks ID pociągu -> wiersze jego biletów
+
+	/**
+	 * @brief Oznacza wiersz jako martwy bez aktualizacji indeksu pociągu
+	 * @param row Numer wiersza
+	 */
+	void markDead(size_t row);
+
+	/**
+	 * @brief Odbudowuje indeksy po zagęszczeniu magazynu
+	 */
+	void rebuildIndexes();
+
+	/**
+	 * @brief Zagęszcza magazyn, jeśli martwe wiersze stanowią ponad połowę wszystkich wierszy
+	 */
+	void compactIfNeeded();
+
+public:
+	/**
+	 * @brief Dodaje nowy bilet na końcu magazynu
+	 * @param id ID biletu
+	 * @param trainId ID pociągu
+	 * @param passengerId Identyfikator loginu pasażera w StringPool::logins()
+	 * @param seat Numer miejsca
+	 * @param price Cena biletu
+	 * @return false jeśli bilet o tym ID już istnieje (magazyn bez zmian)
+	 */
+	bool add(int id, int trainId, uint32_t passengerId, int seat, double price);
+
+	/**
+	 * @brief Zwraca liczbę żywych biletów
+	 * @return Liczba biletów
+	 */
+	size_t size() const;
+
+	/**
+	 * @brief Sprawdza czy magazyn nie zawiera żadnych żywych biletów
+	 * @return true jeśli brak biletów
+	 */
+	bool empty() const;
+
+	/**
+	 * @brief Zwraca liczbę fizycznych wierszy (łącznie z martwymi)
+	 * @return Liczba wierszy
+	 */
+	size_t rows() const;
+
+	/**
+	 * @brief Sprawdza czy wiersz zawiera żywy bilet
+	 * @param row Numer wiersza
+	 * @return true jeśli bilet nie został usunięty
+	 */
+	bool isAlive(size_t row) const;
+
+	/**
+	 * @brief Tworzy obiekt Ticket z danych wiersza
+	 * @param row Numer wiersza
+	 * @return Bilet z danymi z kolumn
+	 */
+	Ticket at(size_t row) const;
+
+	// Dostęp do pojedynczych pól wiersza
+	int ticketId(size_t row) const;
+	int trainId(size_t row) const;
+	uint32_t passengerId(size_t row) const;
+	int seat(size_t row) const;
+	double price(size_t row) const;
+
+	/**
+	 * @brief Zwraca najwyższe ID biletu w magazynie (używane przy odtwarzaniu generatora ID)
+	 * @return Najwyższe ID lub 0 gdy magazyn jest pusty
+	 */
+	int maxTicketId() const;
+
+	/**
+	 * @brief Wyszukuje wiersz biletu należącego do pasażera (O(1))
+	 * @param ticketId ID biletu
+	 * @param passengerId Identyfikator loginu właściciela
+	 * @return Numer wiersza lub NPOS
+	 */
+	size_t findRow(int ticketId, uint32_t passengerId) const;
+
+	/**
+	 * @brief Zmienia numer miejsca w bilecie
+	 * @param row Numer wiersza
+	 * @param newSeat Nowy numer miejsca
+	 */
+	void setSeat(size_t row, int newSeat);
+
+	/**
+	 * @brief Usuwa bilet (oznacza wiersz jako martwy) w czasie O(1)
+	 * @param row Numer wiersza
+	 */
+	void remove(size_t row);
+
+	/**
+	 * @brief Usuwa wszystkie bilety wystawione na dany pociąg
+	 *
+	 * Koszt proporcjonalny do liczby biletów tego pociągu, nie do rozmiaru magazynu.
+	 *
+	 * @param trainId ID pociągu
+	 * @return Liczba usuniętych biletów
+	 */
+	size_t removeByTrain(int trainId);
+
+	/**
+	 * @brief Usuwa wszystkie bilety (kolumny i indeksy)
+	 */
+	void clear();
+
+	/**
+	 * @brief Sumuje ceny wszystkich żywych biletów (czyta tylko kolumnę cen)
+	 * @return Całkowity przychód
+	 */
+	double totalRevenue() const;
+
+	/**
+	 * @brief Fizycznie usuwa martwe wiersze ze wszystkich kolumn
+	 */
+	void compact();
+
+	/**
+	 * @brief Wywołuje funkcję dla każdego żywego biletu danego pociągu (indeks pociągu)
+	 * @param trainId ID pociągu
+	 * @param visit Funkcja przyjmująca numer wiersza
+	 */
+	template <typename F>
+	void forEachOfTrain(int trainId, F visit) const {
+		auto it = FrowsByTrain.find(trainId);
+		if (it == FrowsByTrain.end()) return;
+		for (uint32_t row : it->second) visit(static_cast<size_t>(row));
+	}
+
+	/**
+	 * @brief Wywołuje funkcję dla każdego żywego biletu danego pasażera
+	 * @param passengerId Identyfikator loginu pasażera
+	 * @param visit Funkcja przyjmująca numer wiersza
+	 */
+	template <typename F>
+	void forEachOfPassenger(uint32_t passengerId, F visit) const {
+		for (size_t i = 0; i < FpassengerIds.size(); i++) {
+			if (FpassengerIds[i] == passengerId) visit(i);
+		}
+	}
+
+	/**
+	 * @brief Wywołuje funkcję dla każdego żywego biletu
+	 * @param visit Funkcja przyjmująca numer wiersza
+	 */
+	template <typename F>
+	void forEachLive(F visit) const {
+		for (size_t i = 0; i < FpassengerIds.size(); i++) {
+			if (FpassengerIds[i] != NO_PASSENGER) visit(i);
+		}
+	}
+};
@@ -0,0 +1,315 @@
+/**
+ * @file TimetableImporter.cpp
+ * @brief Implementacja klasy TimetableImporter - równoległe parsowanie i rozwijanie kursów cyklicznych
+ */
+
+#include "TimetableImporter.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+/**
+ * @brief Usuwa białe znaki z początku i końca pola
+ * @param text Pole
+ * @return Pole bez białych znaków na końcach
+ */
+static std::string_view trimField(std::string_view text) {
+	size_t first = text.find_first_not_of(" \t\r");
+	if (first == std::string_view::npos) return {};
+	size_t last = text.find_last_not_of(" \t\r");
+	return text.substr(first, last - first + 1);
+}
+
+/**
+ * @brief Zamienia datę RRRR-MM-DD na dzień kalendarza
+ * @param text Data
+ * @param day Zmienna, do której zostanie zapisany dzień
+ * @return true jeśli data jest poprawna
+ */
+static bool parseDate(std::string_view text, std::chrono::sys_days& day) {
+	uint32_t key = Train::dateKey(text);
+	std::chrono::year_month_day date{ std::chrono::year(static_cast<int>(key / 10000)),
+		std::chrono::month(key / 100 % 100), std::chrono::day(key % 100) };
+	if (key == 0 || !date.ok()) return false;
+	day = std::chrono::sys_days(date);
+	return true;
+}
+
+/**
+ * @brief Zamienia dzień kalendarza na liczbę RRRRMMDD
+ * @param day Dzień
+ * @return Data jako RRRRMMDD
+ */
+static uint32_t dateKeyOf(std::chrono::sys_days day) {
+	std::chrono::year_month_day date(day);
+	return static_cast<uint32_t>(static_cast<int>(date.year())) * 10000 +
+		static_cast<unsigned>(date.month()) * 100 + static_cast<unsigned>(date.day());
+}
+
+/**
+ * @brief Zapisuje datę RRRRMMDD w formacie RRRR-MM-DD
+ * @param key Data jako RRRRMMDD
+ * @return Data jako tekst
+ */
+static std::string formatDate(uint32_t key) {
+	std::string date = "0000-00-00";
+	for (int i = 9; i >= 0; i--) {
+		if (i == 4 || i == 7) continue;
+		date[i] = static_cast<char>('0' + key % 10);
+		key /= 10;
+	}
+	return date;
+}
+
+/**
+ * @brief Konstruktor klasy TimetableImporter
+ * @param trains Katalog pociągów
+ * @param log Strumień komunikatów importu
+ */
+TimetableImporter::TimetableImporter(TrainCatalog& trains, std::ostream& log) : Ftrains(trains), Flog(log) {}
+
+/**
+ * @brief Parsuje jeden wiersz i rozwija go na daty kursów
+ *
+ * Pierwsze osiem pól oddzielonych przecinkami to kolejne kolumny,
+ * reszta linii to układ wagonów (może zawierać przecinki).
+ *
+ * @param line Treść wiersza
+ * @param row Wiersz wynikowy
+ * @param error Opis błędu przy niepowodzeniu
+ * @return true jeśli wiersz jest poprawny
+ */
+bool TimetableImporter::parseRow(std::string_view line, ServiceRow& row, std::string& error) {
+	std::string_view fields[9];
+	for (int i = 0; i < 8; i++) {
+		size_t comma = line.find(',');
+		if (comma == std::string_view::npos) {
+			error = "za malo pol";
+			return false;
+		}
+		fields[i] = trimField(line.substr(0, comma));
+		line.remove_prefix(comma + 1);
+	}
+	fields[8] = trimField(line);
+
+	// ID pierwszego kursu (puste lub '-' - automatyczne)
+	row.FfirstId = 0;
+	if (!fields[0].empty() && fields[0] != "-") {
+		auto result = std::from_chars(fields[0].data(), fields[0].data() + fields[0].size(), row.FfirstId);
+		if (result.ec != std::errc() || result.ptr != fields[0].data() + fields[0].size() || row.FfirstId < 1) {
+			error = "niepoprawne ID";
+			return false;
+		}
+	}
+
+	row.Forigin = fields[1];
+	row.Fdestination = fields[2];
+	if (row.Forigin.empty() || row.Fdestination.empty()) {
+		error = "brak stacji";
+		return false;
+	}
+
+	if (!Train::parseTime(fields[3], row.Fdeparture) || !Train::parseTime(fields[4], row.Farrival)) {
+		error = "niepoprawna godzina";
+		return false;
+	}
+
+	std::chrono::sys_days first, last;
+	if (!parseDate(fields[5], first) || !parseDate(fields[6], last) || last < first) {
+		error = "niepoprawny przedzial dat";
+		return false;
+	}
+	if ((last - first).count() >= MAX_SPAN_DAYS) {
+		error = "przedzial dat dluzszy niz " + std::to_string(MAX_SPAN_DAYS) + " dni";
+		return false;
+	}
+
+	// Dni tygodnia: 7 znaków 0/1, od poniedziałku
+	std::string_view days = fields[7];
+	if (days.size() != 7 || days.find_first_not_of("01") != std::string_view::npos) {
+		error = "niepoprawne dni tygodnia";
+		return false;
+	}
+
+	// Układ wagonów lub sama liczba miejsc
+	int capacity;
+	auto result = std::from_chars(fields[8].data(), fields[8].data() + fields[8].size(), capacity);
+	if (!fields[8].empty() && result.ec == std::errc() && result.ptr == fields[8].data() + fields[8].size()) {
+		row.Flayout = SeatLayout::uniform(capacity);
+	}
+	else if (!SeatLayout::parse(fields[8], row.Flayout)) {
+		row.Flayout = SeatLayout();
+	}
+	if (row.Flayout.capacity() == 0) {
+		error = "niepoprawny uklad wagonow";
+		return false;
+	}
+
+	// Rozwinięcie kursu cyklicznego na konkretne daty
+	row.Fdates.clear();
+	for (std::chrono::sys_days day = first; day <= last; day += std::chrono::days(1)) {
+		unsigned weekday = std::chrono::weekday(day).iso_encoding();   // 1 - poniedziałek
+		if (days[weekday - 1] == '1') row.Fdates.push_back(dateKeyOf(day));
+	}
+
+	// Kolejne kursy dostają kolejne ID - ostatnie musi mieścić się w zakresie int
+	if (row.FfirstId != 0 && !row.Fdates.empty() &&
+		static_cast<int64_t>(row.FfirstId) + static_cast<int64_t>(row.Fdates.size() - 1) > std::numeric_limits<int>::max()) {
+		error = "ID kursow poza zakresem";
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Parsuje fragment pliku
+ * @param lines Wszystkie linie pliku
+ * @param begin Indeks pierwszej linii fragmentu
+ * @param end Indeks za ostatnią linią fragmentu
+ * @param chunk Wynik parsowania
+ */
+void TimetableImporter::parseLines(const std::vector<std::string_view>& lines, size_t begin, size_t end, Chunk& chunk) {
+	std::string error;
+	for (size_t i = begin; i < end; i++) {
+		std::string_view line = trimField(lines[i]);
+		if (line.empty() || line.front() == '#' || line.substr(0, 8) == "first_id") continue;
+
+		ServiceRow row;
+		row.Fline = i + 1;
+		if (parseRow(line, row, error)) chunk.Frows.push_back(std::move(row));
+		else chunk.Ferrors.push_back("Linia " + std::to_string(i + 1) + ": " + error);
+	}
+}
+
+/**
+ * @brief Importuje rozkład z pliku CSV
+ * @param path Ścieżka do pliku
+ * @param report Podsumowanie importu
+ * @return false jeśli pliku nie udało się otworzyć
+ */
+bool TimetableImporter::importFile(const std::string& path, ImportReport& report) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open()) {
+		Flog << "Blad: Nie mozna otworzyc pliku " << path << "\n";
+		return false;
+	}
+
+	std::ostringstream buffer;
+	buffer << file.rdbuf();
+	std::string text = buffer.str();
+	report = importText(text);
+	return true;
+}
+
+/**
+ * @brief Importuje rozkład z tekstu w formacie CSV
+ *
+ * Etap 1 (równolegle): plik dzielony jest na fragmenty linii, każdy wątek
+ * parsuje swoje wiersze i rozwija je na daty. Etap 2 (jeden przebieg):
+ * wiersze w kolejności pliku otrzymują ID, są sprawdzane pod kątem unikalności
+ * i trafiają do katalogu razem z godzinami (indeks odjazdów).
+ *
+ * @param text Zawartość pliku
+ * @return Podsumowanie importu
+ */
+ImportReport TimetableImporter::importText(std::string_view text) {
+	ImportReport report;
+
+	// Podział na linie (widoki na bufor - bez kopiowania)
+	std::vector<std::string_view> lines;
+	while (!text.empty()) {
+		size_t newline = text.find('\n');
+		lines.push_back(text.substr(0, newline));
+		text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+	}
+
+	// Etap 1: równoległe parsowanie fragmentów
+	size_t workers = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(), lines.size() / MIN_LINES_PER_WORKER));
+	std::vector<Chunk> chunks(workers);
+	size_t perWorker = (lines.size() + workers - 1) / workers;
+	{
+		std::vector<std::thread> threads;
+		for (size_t w = 1; w < workers; w++) {
+			size_t begin = std::min(lines.size(), w * perWorker);
+			size_t end = std::min(lines.size(), begin + perWorker);
+			threads.emplace_back(parseLines, std::cref(lines), begin, end, std::ref(chunks[w]));
+		}
+		parseLines(lines, 0, std::min(lines.size(), perWorker), chunks[0]);
+		for (std::thread& thread : threads) thread.join();
+	}
+
+	// Etap 2: przydział ID i wstawienie do katalogu w kolejności pliku
+	size_t expected = 0;
+	for (const Chunk& chunk : chunks) {
+		for (const ServiceRow& row : chunk.Frows) expected += row.Fdates.size();
+	}
+	Ftrains.reserve(expected);
+
+	// Obliczenia na int64_t - ID za największym istniejącym może wyjść poza zakres int
+	const int64_t MAX_ID = std::numeric_limits<int>::max();
+	int64_t nextAutoId = 1;
+	for (const Train* train : Ftrains) nextAutoId = std::max(nextAutoId, static_cast<int64_t>(train->getID()) + 1);
+
+	std::unordered_set<int> claimed;
+	claimed.reserve(expected);
+	auto isFree = [this, &claimed](int64_t id) {
+		int trainId = static_cast<int>(id);
+		return Ftrains.find(trainId) == nullptr && !claimed.count(trainId);
+	};
+
+	std::vector<int> ids;
+	for (Chunk& chunk : chunks) {
+		for (const std::string& error : chunk.Ferrors) Flog << "[IMPORT] " << error << "\n";
+		report.FrejectedRows += chunk.Ferrors.size();
+		report.Frows += chunk.Ferrors.size();
+
+		for (const ServiceRow& row : chunk.Frows) {
+			report.Frows++;
+
+			// Przydział ID - jawne ID muszą być wolne w całości, automatyczne pomijają zajęte
+			ids.clear();
+			bool conflict = false;
+			bool exhausted = false;
+			for (size_t i = 0; i < row.Fdates.size() && !conflict && !exhausted; i++) {
+				int64_t id;
+				if (row.FfirstId != 0) {
+					id = static_cast<int64_t>(row.FfirstId) + static_cast<int64_t>(i);
+					exhausted = id > MAX_ID;
+					conflict = !exhausted && !isFree(id);
+				}
+				else {
+					while (nextAutoId <= MAX_ID && !isFree(nextAutoId)) nextAutoId++;
+					exhausted = nextAutoId > MAX_ID;
+					id = nextAutoId++;
+				}
+				if (!exhausted) ids.push_back(static_cast<int>(id));
+			}
+			if (exhausted) {
+				Flog << "[IMPORT] Linia " << row.Fline << ": ID kursow poza zakresem\n";
+				report.FrejectedRows++;
+				continue;
+			}
+			if (conflict) {
+				Flog << "[IMPORT] Linia " << row.Fline << ": ID " << ids.back() << " jest juz zajete\n";
+				report.FrejectedRows++;
+				continue;
+			}
+
+			for (size_t i = 0; i < row.Fdates.size(); i++) {
+				Train* train = Ftrains.add(ids[i], row.Forigin, row.Fdestination, formatDate(row.Fdates[i]), row.Flayout);
+				if (train == nullptr) continue;
+				Ftrains.setTimes(*train, row.Fdeparture, row.Farrival);
+				claimed.insert(ids[i]);
+				report.Ftrains++;
+			}
+		}
+	}
+	return report;
+}
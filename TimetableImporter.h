@@ -0,0 +1,123 @@
+/**
+ * @file TimetableImporter.h
+ * @brief Deklaracja klasy TimetableImporter - hurtowy import rozkładu jazdy z pliku CSV
+ */
+
+#pragma once
+#include "TrainCatalog.h"
+#include "SeatLayout.h"
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @struct ImportReport
+ * @brief Podsumowanie importu rozkładu
+ */
+struct ImportReport {
+	size_t Frows = 0;          ///< Liczba przetworzonych wierszy z kursami
+	size_t FrejectedRows = 0;  ///< Liczba odrzuconych wierszy (błąd formatu lub zajęte ID)
+	size_t Ftrains = 0;        ///< Liczba utworzonych pociągów
+};
+
+/**
+ * @class TimetableImporter
+ * @brief Wczytuje sezonowy rozkład jazdy i rozwija kursy cykliczne na pociągi
+ *
+ * Każdy wiersz pliku CSV opisuje kurs kursujący w wybrane dni tygodnia
+ * w przedziale dat (odpowiednik trips + calendar z GTFS):
+ *
+ *     first_id,origin,destination,departure,arrival,start_date,end_date,days,layout
+ *     5000,Warszawa,Krakow,06:15,08:40,2026-03-01,2026-05-31,1111100,2:1x10x3,1:4x20x4
+ *
+ * - first_id - ID pierwszego kursu, kolejne kursy dostają kolejne ID
+ *   (pusty lub '-' - ID przydzielane automatycznie za najwyższym istniejącym),
+ * - days - siedem znaków 0/1 od poniedziałku do niedzieli,
+ * - layout - układ wagonów (SeatLayout) lub liczba miejsc; jako ostatnie pole
+ *   może zawierać przecinki.
+ *
+ * Puste linie, linie zaczynające się od '#' i nagłówek są pomijane.
+ *
+ * Parsowanie i rozwijanie dat odbywa się równolegle na fragmentach pliku,
+ * a wynikowe kursy trafiają do katalogu jednym przebiegiem w kolejności wierszy.
+ * Unikalność ID sprawdzana jest w tablicach haszujących (katalog + zbiór ID
+ * bieżącego importu) - wiersz z choćby jednym zajętym ID jest odrzucany w całości.
+ */
+class TimetableImporter
+{
+public:
+	static constexpr int MAX_SPAN_DAYS = 366;                ///< Maksymalna długość przedziału dat jednego wiersza
+	static constexpr size_t MIN_LINES_PER_WORKER = 2048;     ///< Minimalna liczba linii na wątek parsujący
+
+private:
+	/**
+	 * @struct ServiceRow
+	 * @brief Sparsowany wiersz rozkładu rozwinięty na daty kursów
+	 */
+	struct ServiceRow {
+		size_t Fline;                        ///< Numer linii w pliku (do komunikatów)
+		int FfirstId;                        ///< ID pierwszego kursu (0 - automatyczne)
+		std::string_view Forigin;            ///< Stacja początkowa (widok na bufor pliku)
+		std::string_view Fdestination;       ///< Stacja końcowa (widok na bufor pliku)
+		uint16_t Fdeparture;                 ///< Odjazd w minutach od północy
+		uint16_t Farrival;                   ///< Przyjazd w minutach od północy
+		SeatLayout Flayout;                  ///< Układ wagonów
+		std::vector<uint32_t> Fdates;        ///< Daty kursów (RRRRMMDD)
+	};
+
+	/**
+	 * @struct Chunk
+	 * @brief Wynik pracy jednego wątku parsującego
+	 */
+	struct Chunk {
+		std::vector<ServiceRow> Frows;       ///< Poprawne wiersze
+		std::vector<std::string> Ferrors;    ///< Komunikaty o odrzuconych wierszach
+	};
+
+	TrainCatalog& Ftrains;   ///< Katalog, do którego trafiają pociągi
+	std::ostream& Flog;      ///< Strumień komunikatów o odrzuconych wierszach (sesja administratora lub konsola)
+
+	/**
+	 * @brief Parsuje fragment pliku (wywoływane równolegle)
+	 * @param lines Wszystkie linie pliku
+	 * @param begin Indeks pierwszej linii fragmentu
+	 * @param end Indeks za ostatnią linią fragmentu
+	 * @param chunk Wynik parsowania
+	 */
+	static void parseLines(const std::vector<std::string_view>& lines, size_t begin, size_t end, Chunk& chunk);
+
+	/**
+	 * @brief Parsuje jeden wiersz i rozwija go na daty kursów
+	 * @param line Treść wiersza
+	 * @param row Wiersz wynikowy
+	 * @param error Opis błędu przy niepowodzeniu
+	 * @return true jeśli wiersz jest poprawny
+	 */
+	static bool parseRow(std::string_view line, ServiceRow& row, std::string& error);
+
+public:
+	/**
+	 * @brief Konstruktor klasy TimetableImporter
+	 * @param trains Katalog pociągów
+	 * @param log Strumień komunikatów importu
+	 */
+	explicit TimetableImporter(TrainCatalog& trains, std::ostream& log = std::cout);
+
+	/**
+	 * @brief Importuje rozkład z pliku CSV
+	 * @param path Ścieżka do pliku
+	 * @param report Podsumowanie importu
+	 * @return false jeśli pliku nie udało się otworzyć
+	 */
+	bool importFile(const std::string& path, ImportReport& report);
+
+	/**
+	 * @brief Importuje rozkład z tekstu w formacie CSV
+	 * @param text Zawartość pliku
+	 * @return Podsumowanie importu
+	 */
+	ImportReport importText(std::string_view text);
+};
@@ -4,35 +4,168 @@
  */
 
 #include "Train.h"
-#include <iostream>
-#include <iomanip>
+#include "StringPool.h"
+#include "OutputBuffer.h"
+#include <ostream>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+
+// Mapa bitowa musi zaczynać się na granicy słowa 64-bitowego tuż za nagłówkiem
+static_assert(sizeof(Train) % alignof(uint64_t) == 0, "Naglowek Train musi byc wyrownany do slowa");
 
 /**
  * @brief Konstruktor klasy Train - inicjalizuje pociąg
  * 
  * Tworzy pociąg z podanymi parametrami i inicjalizuje wszystkie miejsca jako wolne.
- * Wektor miejsc ma rozmiar capacity+1 (indeks 0 nie jest używany dla wygody)
+ * Nazwy stacji są internowane - pociąg przechowuje tylko ich identyfikatory.
+ * Mapa bitowa miejsc leży w tym samym bloku areny bezpośrednio za nagłówkiem
+ * (bit 0 nie jest używany dla wygody - miejsca numerowane są od 1).
  * 
  * @param id Unikalny identyfikator pociągu
  * @param origin Stacja początkowa
  * @param destination Stacja końcowa
- * @param date Data kursu
- * @param capacity Liczba miejsc w pociągu
+ * @param date Data kursu (obcinana do formatu RRRR-MM-DD)
+ * @param layout Układ wagonów i klas (wyznacza liczbę miejsc)
  */
-Train::Train(int id, std::string origin, std::string destination, std::string date, int capacity)
-	: Fid(id), Forigin(origin), Fdestination(destination), Fdate(date), Fcapacity(capacity) {
+Train::Train(int id, std::string_view origin, std::string_view destination, std::string_view date, const SeatLayout& layout)
+	: Fid(id),
+	ForiginId(StringPool::stations().intern(origin)),
+	FdestinationId(StringPool::stations().intern(destination)),
+	Fcapacity(layout.capacity()), Foccupied(0), Fversion(0),
+	Fdeparture(NO_TIME), Farrival(NO_TIME), Fdate{}, Flayout(layout) {
+
+	date.copy(Fdate, DATE_SIZE - 1);
 
-	// Inicjalizacja wektora miejsc - wszystkie miejsca wolne
-	// Rozmiar capacity+1 aby numery miejsc zaczynały się od 1
-	Fseats.resize(capacity + 1, false);
+	// Inicjalizacja mapy bitowej - wszystkie miejsca wolne
+	std::fill_n(seatWords(), seatWordCount(Fcapacity), uint64_t{ 0 });
 }
 
+// Rozmiary bloku w arenie
+size_t Train::seatWordCount(int capacity) { return static_cast<size_t>(capacity) / 64 + 1; }
+size_t Train::blockWordCount(int capacity) { return sizeof(Train) / sizeof(uint64_t) + seatWordCount(capacity); }
+
+// Mapa bitowa leży bezpośrednio za nagłówkiem pociągu
+uint64_t* Train::seatWords() { return reinterpret_cast<uint64_t*>(this + 1); }
+const uint64_t* Train::seatWords() const { return reinterpret_cast<const uint64_t*>(this + 1); }
+
 // Gettery - zwracają podstawowe informacje o pociągu
 int Train::getID() const { return Fid; }
-std::string Train::getOrigin() const { return Forigin; }
-std::string Train::getDestination() const { return Fdestination; }
-std::string Train::getDate() const { return Fdate; }
+const std::string& Train::getOrigin() const { return StringPool::stations().get(ForiginId); }
+const std::string& Train::getDestination() const { return StringPool::stations().get(FdestinationId); }
+uint32_t Train::getOriginId() const { return ForiginId; }
+uint32_t Train::getDestinationId() const { return FdestinationId; }
+std::string_view Train::getDate() const { return std::string_view(Fdate); }
+uint16_t Train::getDeparture() const { return Fdeparture; }
+uint16_t Train::getArrival() const { return Farrival; }
 int Train::getCapacity() const { return Fcapacity; }
+const SeatLayout& Train::getLayout() const { return Flayout; }
+int Train::getSeatClass(int seatNumber) const { return Flayout.classOf(seatNumber); }
+
+/**
+ * @brief Zamienia godzinę GG:MM na minuty od północy
+ * @param text Godzina
+ * @param minutes Zmienna, do której zostanie zapisana liczba minut
+ * @return true jeśli godzina jest poprawna
+ */
+bool Train::parseTime(std::string_view text, uint16_t& minutes) {
+	size_t colon = text.find(':');
+	if (colon == std::string_view::npos || colon == 0 || colon > 2 || text.size() != colon + 3) return false;
+
+	int hours = 0, mins = 0;
+	for (size_t i = 0; i < text.size(); i++) {
+		if (i == colon) continue;
+		if (text[i] < '0' || text[i] > '9') return false;
+		if (i < colon) hours = hours * 10 + (text[i] - '0');
+		else mins = mins * 10 + (text[i] - '0');
+	}
+	if (hours > 23 || mins > 59) return false;
+
+	minutes = static_cast<uint16_t>(hours * 60 + mins);
+	return true;
+}
+
+/**
+ * @brief Zapisuje godzinę w formacie GG:MM
+ * @param minutes Minuty od północy
+ * @return Godzina lub "--:--"
+ */
+std::string Train::formatTime(uint16_t minutes) {
+	if (minutes >= MINUTES_PER_DAY) return "--:--";
+	char text[6] = { static_cast<char>('0' + minutes / 600), static_cast<char>('0' + minutes / 60 % 10), ':',
+		static_cast<char>('0' + minutes % 60 / 10), static_cast<char>('0' + minutes % 10), '\0' };
+	return text;
+}
+
+/**
+ * @brief Zamienia datę RRRR-MM-DD na liczbę RRRRMMDD
+ * @param date Data
+ * @return Liczba RRRRMMDD lub 0
+ */
+uint32_t Train::dateKey(std::string_view date) {
+	if (date.size() != 10 || date[4] != '-' || date[7] != '-') return 0;
+	uint32_t key = 0;
+	for (size_t i = 0; i < date.size(); i++) {
+		if (i == 4 || i == 7) continue;
+		if (date[i] < '0' || date[i] > '9') return 0;
+		key = key * 10 + static_cast<uint32_t>(date[i] - '0');
+	}
+	return key;
+}
+
+/**
+ * @brief Zwraca maskę bitów słowa mapy należących do przedziału miejsc
+ * @param word Indeks słowa mapy bitowej
+ * @param first Pierwszy numer miejsca przedziału
+ * @param last Ostatni numer miejsca przedziału
+ * @return Maska bitów
+ */
+static uint64_t rangeMask(size_t word, int first, int last) {
+	uint64_t mask = ~uint64_t{ 0 };
+	if (word == static_cast<size_t>(first / 64)) mask &= ~uint64_t{ 0 } << (first % 64);
+	if (word == static_cast<size_t>(last / 64)) mask &= ~uint64_t{ 0 } >> (63 - last % 64);
+	return mask;
+}
+
+/**
+ * @brief Wyszukuje pierwsze wolne miejsce w danej klasie
+ *
+ * Miejsca klasy tworzą ciągły przedział mapy bitowej, więc wyszukiwanie
+ * to jedno przejście po jej słowach - 64 miejsca na porównanie,
+ * niezależnie od układu wagonów.
+ *
+ * @param travelClass Klasa (0 - dowolna)
+ * @return Numer miejsca lub 0, jeśli brak wolnych miejsc
+ */
+int Train::findFreeSeat(int travelClass) const {
+	int first, last;
+	if (!Flayout.classRange(travelClass, first, last)) return 0;
+
+	const uint64_t* words = seatWords();
+	for (size_t w = first / 64; w <= static_cast<size_t>(last / 64); w++) {
+		uint64_t freeBits = ~words[w] & rangeMask(w, first, last);
+		if (freeBits != 0) return static_cast<int>(w * 64) + std::countr_zero(freeBits);
+	}
+	return 0;
+}
+
+/**
+ * @brief Zlicza wolne miejsca w danej klasie (popcount po słowach przedziału)
+ * @param travelClass Klasa (0 - dowolna)
+ * @return Liczba wolnych miejsc
+ */
+int Train::getFreeSeatsCount(int travelClass) const {
+	int first, last;
+	if (!Flayout.classRange(travelClass, first, last)) return 0;
+
+	const uint64_t* words = seatWords();
+	int count = 0;
+	for (size_t w = first / 64; w <= static_cast<size_t>(last / 64); w++) {
+		count += std::popcount(~words[w] & rangeMask(w, first, last));
+	}
+	return count;
+}
 
 /**
  * @brief Sprawdza czy dane miejsce jest wolne
@@ -45,7 +178,7 @@ int Train::getCapacity() const { return Fcapacity; }
  */
 bool Train::isSeatFree(int seatNumber) const {
 	if (seatNumber < 1 || seatNumber > Fcapacity) return false;
-	return !Fseats[seatNumber];
+	return (seatWords()[seatNumber / 64] & (uint64_t{ 1 } << (seatNumber % 64))) == 0;
 }
 
 /**
@@ -60,7 +193,11 @@ bool Train::reserveSeat(int seatNumber) {
 	if (!isSeatFree(seatNumber)) {
 		return false;
 	}
-	Fseats[seatNumber] = true;
+	seatWords()[seatNumber / 64] |= uint64_t{ 1 } << (seatNumber % 64);
+	Foccupied++;
+
+	// Ostatnie wolne miejsce klasy - zmiana dostępności widoczna w wyszukiwaniu
+	if (findFreeSeat(getSeatClass(seatNumber)) == 0) Fversion++;
 	return true;
 }
 
@@ -72,45 +209,262 @@ bool Train::reserveSeat(int seatNumber) {
  * @param seatNumber Numer miejsca do zwolnienia
  */
 void Train::cancelSeat(int seatNumber) {
-	if (seatNumber >= 1 && seatNumber <= Fcapacity) {
-		Fseats[seatNumber] = false;
+	if (seatNumber >= 1 && seatNumber <= Fcapacity && !isSeatFree(seatNumber)) {
+		// Zwolnienie miejsca w wyprzedanej klasie - zmiana dostępności
+		if (findFreeSeat(getSeatClass(seatNumber)) == 0) Fversion++;
+
+		seatWords()[seatNumber / 64] &= ~(uint64_t{ 1 } << (seatNumber % 64));
+		Foccupied--;
 	}
 }
 
 /**
- * @brief Oblicza liczbę zajętych miejsc w pociągu
+ * @brief Przenosi rezerwację na inne miejsce tej samej klasy
+ *
+ * Nowe miejsce zajmowane jest przed zwolnieniem starego, a w obrębie
+ * jednego słowa oba bity zmieniane są jednym zapisem.
+ *
+ * @param fromSeat Zajęte miejsce
+ * @param toSeat Wolne miejsce tej samej klasy
+ * @return true jeśli przeniesiono rezerwację
+ */
+bool Train::moveSeat(int fromSeat, int toSeat) {
+	if (fromSeat < 1 || fromSeat > Fcapacity || isSeatFree(fromSeat) || !isSeatFree(toSeat)) return false;
+	if (getSeatClass(fromSeat) != getSeatClass(toSeat)) return false;
+
+	uint64_t* words = seatWords();
+	uint64_t fromBit = uint64_t{ 1 } << (fromSeat % 64);
+	uint64_t toBit = uint64_t{ 1 } << (toSeat % 64);
+	if (fromSeat / 64 == toSeat / 64) {
+		words[fromSeat / 64] ^= fromBit | toBit;
+	}
+	else {
+		words[toSeat / 64] |= toBit;
+		words[fromSeat / 64] &= ~fromBit;
+	}
+	return true;
+}
+
+/**
+ * @brief Zwraca liczbę zajętych miejsc w pociągu
  * 
- * Iteruje przez wszystkie miejsca i zlicza te zarezerwowane
+ * Licznik aktualizowany jest przy każdej rezerwacji i anulowaniu,
+ * więc operacja nie przegląda mapy miejsc
  * 
  * @return Liczba zarezerwowanych miejsc
  */
 int Train::getOccupiedSeatsCount() const {
-	int count = 0;
-	for (size_t i = 1; i < Fseats.size(); i++) {
-		if (Fseats[i]) count++;
+	return Foccupied;
+}
+
+/// Prefiks zapisu zajętości w postaci mapy bitowej
+static constexpr std::string_view SEAT_BITMAP_PREFIX = "x:";
+
+/**
+ * @brief Wyszukuje następne miejsce o danym stanie (przegląd po słowach mapy)
+ * @param words Mapa bitowa
+ * @param from Pierwszy sprawdzany numer miejsca
+ * @param capacity Liczba miejsc
+ * @param occupied true - szukane zajęte miejsce, false - wolne
+ * @return Numer miejsca lub capacity + 1, jeśli takiego nie ma
+ */
+static int nextSeat(const uint64_t* words, int from, int capacity, bool occupied) {
+	size_t word = static_cast<size_t>(from / 64);
+	size_t lastWord = static_cast<size_t>(capacity / 64);
+	uint64_t bits = (occupied ? words[word] : ~words[word]) & (~uint64_t{ 0 } << (from % 64));
+	while (bits == 0) {
+		if (++word > lastWord) return capacity + 1;
+		bits = occupied ? words[word] : ~words[word];
 	}
-	return count;
+	return std::min(capacity + 1, static_cast<int>(word * 64) + std::countr_zero(bits));
+}
+
+/**
+ * @brief Zapisuje zajętość miejsc (przedziały lub mapa bitowa - krótszy zapis)
+ * @return Zapis zajętości
+ */
+std::string Train::encodeSeats() const {
+	const uint64_t* words = seatWords();
+
+	// Przedziały zajętych miejsc - granice wyszukiwane po słowach
+	std::string runs;
+	for (int seat = nextSeat(words, 1, Fcapacity, true); seat <= Fcapacity; seat = nextSeat(words, seat, Fcapacity, true)) {
+		int last = nextSeat(words, seat, Fcapacity, false) - 1;
+		if (!runs.empty()) runs += ',';
+		runs += std::to_string(seat);
+		if (last > seat) {
+			runs += '-';
+			runs += std::to_string(last);
+		}
+		seat = last + 1;
+	}
+
+	// Mapa bitowa bez końcowych pustych słów - tylko jeśli jest krótsza
+	size_t used = seatWordCount(Fcapacity);
+	while (used > 0 && words[used - 1] == 0) used--;
+	if (runs.size() <= SEAT_BITMAP_PREFIX.size() + used * 16) return runs;
+
+	static constexpr char HEX[] = "0123456789abcdef";
+	std::string bitmap(SEAT_BITMAP_PREFIX);
+	bitmap.reserve(SEAT_BITMAP_PREFIX.size() + used * 16);
+	for (size_t w = 0; w < used; w++) {
+		for (int shift = 60; shift >= 0; shift -= 4) bitmap += HEX[(words[w] >> shift) & 0xF];
+	}
+	return bitmap;
+}
+
+/**
+ * @brief Odtwarza zajętość miejsc z zapisu tekstowego
+ * @param text Zapis zajętości
+ * @return false jeśli zapis zawierał niepoprawne fragmenty
+ */
+bool Train::decodeSeats(std::string_view text) {
+	uint64_t* words = seatWords();
+	size_t wordCount = seatWordCount(Fcapacity);
+	std::fill_n(words, wordCount, uint64_t{ 0 });
+	bool valid = true;
+
+	if (text.starts_with(SEAT_BITMAP_PREFIX)) {
+		// Mapa bitowa - każde 16 cyfr to jedno słowo
+		text.remove_prefix(SEAT_BITMAP_PREFIX.size());
+		size_t count = std::min(wordCount, text.size() / 16);
+		valid = text.size() % 16 == 0 && text.size() / 16 <= wordCount;
+		for (size_t w = 0; w < count; w++) {
+			const char* begin = text.data() + w * 16;
+			auto result = std::from_chars(begin, begin + 16, words[w], 16);
+			if (result.ec != std::errc() || result.ptr != begin + 16) {
+				words[w] = 0;
+				valid = false;
+			}
+		}
+	}
+	else {
+		// Przedziały "a-b" lub pojedyncze numery oddzielone przecinkami
+		while (!text.empty()) {
+			size_t comma = text.find(',');
+			std::string_view segment = text.substr(0, comma);
+			text.remove_prefix(comma == std::string_view::npos ? text.size() : comma + 1);
+
+			size_t begin = segment.find_first_not_of(' ');
+			if (begin == std::string_view::npos) continue;
+			segment = segment.substr(begin, segment.find_last_not_of(' ') - begin + 1);
+
+			int first = 0, last = 0;
+			const char* end = segment.data() + segment.size();
+			auto result = std::from_chars(segment.data(), end, first);
+			last = first;
+			if (result.ec == std::errc() && result.ptr != end && *result.ptr == '-') {
+				result = std::from_chars(result.ptr + 1, end, last);
+			}
+			if (result.ec != std::errc() || result.ptr != end || first < 1 || last < first || last > Fcapacity) {
+				valid = false;
+				continue;
+			}
+			for (size_t w = first / 64; w <= static_cast<size_t>(last / 64); w++) words[w] |= rangeMask(w, first, last);
+		}
+	}
+
+	// Bit 0 i bity za ostatnim miejscem nie należą do pociągu
+	uint64_t outside = (words[0] & 1) | (words[wordCount - 1] & ~(~uint64_t{ 0 } >> (63 - Fcapacity % 64)));
+	if (outside != 0) valid = false;
+	words[0] &= ~uint64_t{ 1 };
+	words[wordCount - 1] &= ~uint64_t{ 0 } >> (63 - Fcapacity % 64);
+
+	Foccupied = 0;
+	for (size_t w = 0; w < wordCount; w++) Foccupied += std::popcount(words[w]);
+	return valid;
+}
+
+/**
+ * @brief Zwraca wersję dostępności pociągu
+ * @return Numer wersji
+ */
+uint32_t Train::getVersion() const {
+	return Fversion;
+}
+
+/// Najszersza komórka mapy miejsc: numer miejsca ma co najwyżej tyle cyfr
+static constexpr int MAX_CELL_DIGITS = 4;
+
+/**
+ * @brief Zwraca gotową komórkę mapy miejsc
+ *
+ * Komórki "[ NR ] " dla wszystkich numerów miejsc (i komórka zajętego miejsca
+ * "[ X ] ") budowane są raz dla każdej szerokości numeru i współdzielone przez
+ * wszystkie pociągi, więc mapa miejsc to tylko kopiowanie gotowych fragmentów.
+ *
+ * @param seat Numer miejsca (0 - miejsce zajęte)
+ * @param width Szerokość pola numeru (2..MAX_CELL_DIGITS)
+ * @return Komórka z odstępem na końcu
+ */
+static std::string_view seatCell(int seat, int width) {
+	static const std::array<std::string, MAX_CELL_DIGITS + 1> cells = [] {
+		std::array<std::string, MAX_CELL_DIGITS + 1> tables;
+		for (int w = 2; w <= MAX_CELL_DIGITS; w++) {
+			std::string& table = tables[w];
+			table.reserve(static_cast<size_t>(SeatLayout::MAX_CAPACITY + 1) * static_cast<size_t>(w + 5));
+			for (int n = 0; n <= SeatLayout::MAX_CAPACITY; n++) {
+				char digits[8];
+				auto result = std::to_chars(digits, digits + sizeof(digits), n);
+				std::string_view label = n == 0 ? std::string_view("X") : std::string_view(digits, static_cast<size_t>(result.ptr - digits));
+				table += "[ ";
+				if (label.size() < static_cast<size_t>(w)) table.append(static_cast<size_t>(w) - label.size(), ' ');
+				table += label;
+				table += " ] ";
+			}
+		}
+		return tables;
+	}();
+	size_t size = static_cast<size_t>(width + 5);
+	return std::string_view(cells[static_cast<size_t>(width)]).substr(static_cast<size_t>(seat) * size, size);
 }
 
 /**
  * @brief Wyświetla wizualną mapę zajętości miejsc w pociągu
  * 
- * Pokazuje wszystkie miejsca w układzie 4 miejsca na rząd:
+ * Pokazuje miejsca wagon po wagonie, rząd po rzędzie zgodnie z układem
+ * (przejście między miejscami zaznaczone odstępem):
  * - Wolne miejsca: [ NR ] gdzie NR to numer miejsca
  * - Zajęte miejsca: [ X ]
+ *
+ * Cała mapa składana jest w buforze wątku z gotowych komórek (seatCell)
+ * i wypisywana jednym zapisem.
+ *
+ * @param out Strumień wyjścia sesji
  */
-void Train::displaySeats() const {
-	std::cout << "\n=== MAPA MIEJSC (Pociag ID: " << Fid << " Relacji: " << Forigin << " --> " << Fdestination << " ===" << std::endl;
-	std::cout << "Legenda: [ NR ] = Wolne, [ X ] = Zajete\n" << std::endl;
+void Train::displaySeats(std::ostream& out) const {
+	thread_local OutputBuffer screen;
+	screen << "\n=== MAPA MIEJSC (Pociag ID: " << Fid << " Relacji: " << getOrigin() << " --> " << getDestination() << " ===\n";
+	screen << "Legenda: [ NR ] = Wolne, [ X ] = Zajete\n";
+
+	// Szerokość pola numeru zależna od liczby miejsc
+	int width = 2;
+	for (int n = Fcapacity; n >= 100; n /= 10) width++;
+	width = std::min(width, MAX_CELL_DIGITS);
+
+	int seat = 1;
+	int coach = 0;
+	for (int s = 0; s < Flayout.segmentCount(); s++) {
+		const CoachSegment& segment = Flayout.segment(s);
+		int perRow = segment.FseatsPerRow;
+		int perCoach = segment.Frows * perRow;
+		int aisle = perRow > 2 ? (perRow + 1) / 2 : 0;
 
-	// Wyświetlanie miejsc w układzie 4 na rząd
-	for (auto i = 1; i <= Fcapacity; i++) {
+		for (int start = 0; start < segment.Fseats; start += perCoach) {
+			screen << "\n--- Wagon " << ++coach << " (klasa " << (segment.Fclass == 2 ? "I" : "II") << ") ---\n";
 
-		if (Fseats[i]) std::cout << "[  X ] ";
-		else std::cout << "[ " << std::setw(2) << i << " ] ";
+			int inCoach = std::min(perCoach, segment.Fseats - start);
+			for (int i = 0; i < inCoach; i++, seat++) {
+				screen << seatCell(isSeatFree(seat) ? seat : 0, width);
 
-		// Przejście do nowej linii co 4 miejsca
-		if (i % 4 == 0) std::cout << "\n";
+				// Koniec rzędu lub przejście między miejscami
+				int column = i % perRow + 1;
+				if (column == perRow) screen << '\n';
+				else if (column == aisle) screen << "  ";
+			}
+			if (inCoach % perRow != 0) screen << '\n';
+		}
 	}
-	std::cout << "\n=============================================================" << std::endl;
+	screen << "=============================================================\n";
+	screen.writeTo(out);
 }
\ No newline at end of file
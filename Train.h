@@ -4,100 +4,272 @@
  */
 
 #pragma once
+#include "SeatLayout.h"
+#include <ostream>
 #include <string>
-#include <vector>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+class TrainCatalog;
 
 /**
  * @class Train
  * @brief Klasa reprezentująca pociąg w systemie rezerwacji kolejowej
- * 
+ *
  * Klasa Train przechowuje informacje o połączeniu kolejowym:
  * - ID pociągu, stacje początkową i końcową, datę kursu
- * - Pojemność (liczba miejsc) oraz stan zajętości miejsc
- * Obsługuje rezerwację i anulowanie miejsc oraz wyświetlanie mapy miejsc
+ * - Godziny odjazdu i przyjazdu (minuty od północy; przyjazd wcześniejszy
+ *   niż odjazd oznacza przyjazd następnego dnia)
+ * - Układ wagonów i klas (SeatLayout) oraz stan zajętości miejsc
+ * Obsługuje rezerwację i anulowanie miejsc, wyszukiwanie wolnego miejsca
+ * w danej klasie oraz wyświetlanie mapy miejsc
+ *
+ * Obiekty Train tworzone są wyłącznie przez TrainCatalog w jego arenie pamięci.
+ * Bezpośrednio za nagłówkiem pociągu leży mapa bitowa miejsc (1 bit na miejsce),
+ * więc cały pociąg zajmuje jeden ciągły blok bez dodatkowych alokacji.
+ * Adres pociągu nie zmienia się do momentu jego usunięcia z katalogu.
  */
-class Train
+class alignas(uint64_t) Train
 {
+	friend class TrainCatalog;
+
+public:
+	static constexpr size_t DATE_SIZE = 12;   ///< Rozmiar pola daty (RRRR-MM-DD + zakończenie, wyrównane)
+	static constexpr uint16_t NO_TIME = 0xFFFF; ///< Brak godziny (pociągi sprzed wprowadzenia rozkładu)
+	static constexpr uint16_t MINUTES_PER_DAY = 24 * 60; ///< Liczba minut w dobie
+
 private:
 	int Fid;                      ///< Unikalny identyfikator pociągu
-	std::string Forigin;          ///< Stacja początkowa
-	std::string Fdestination;     ///< Stacja końcowa
-	std::string Fdate;            ///< Data kursu (format RRRR-MM-DD)
+	uint32_t ForiginId;           ///< Identyfikator stacji początkowej w StringPool::stations()
+	uint32_t FdestinationId;      ///< Identyfikator stacji końcowej w StringPool::stations()
 	int Fcapacity;                ///< Całkowita liczba miejsc w pociągu
-	std::vector<bool> Fseats;     ///< Tablica zajętości miejsc (true = zajęte, false = wolne)
+	int Foccupied;                ///< Liczba zajętych miejsc (utrzymywana przy rezerwacji/anulowaniu)
+	uint32_t Fversion;            ///< Wersja dostępności - rośnie, gdy klasa wyprzedaje się lub odzyskuje wolne miejsca
+	uint16_t Fdeparture;          ///< Godzina odjazdu w minutach od północy (NO_TIME - brak)
+	uint16_t Farrival;            ///< Godzina przyjazdu w minutach od północy (NO_TIME - brak)
+	char Fdate[DATE_SIZE];        ///< Data kursu (format RRRR-MM-DD), bez alokacji na stercie
+	SeatLayout Flayout;           ///< Układ wagonów i klas (miejsca każdej klasy tworzą ciągły przedział)
 
-public:
 	/**
-	 * @brief Konstruktor klasy Train
+	 * @brief Konstruktor klasy Train - wywoływany przez TrainCatalog w przydzielonym bloku areny
 	 * @param id Unikalny identyfikator pociągu
 	 * @param Forigin Stacja początkowa
 	 * @param Fdestination Stacja końcowa
 	 * @param Fdate Data kursu
-	 * @param Fcapacity Liczba miejsc w pociągu
+	 * @param Flayout Układ wagonów i klas (wyznacza liczbę miejsc)
 	 */
-	Train(int id, std::string Forigin, std::string Fdestination, std::string Fdate, int Fcapacity);
+	Train(int id, std::string_view Forigin, std::string_view Fdestination, std::string_view Fdate, const SeatLayout& Flayout);
+
+	/**
+	 * @brief Zwraca wskaźnik na mapę bitową miejsc leżącą bezpośrednio za nagłówkiem
+	 * @return Wskaźnik na pierwsze słowo mapy bitowej
+	 */
+	uint64_t* seatWords();
+	const uint64_t* seatWords() const;
+
+public:
+	Train(const Train&) = delete;
+	Train& operator=(const Train&) = delete;
+
+	/**
+	 * @brief Zwraca liczbę 64-bitowych słów mapy bitowej dla danej pojemności
+	 * @param capacity Liczba miejsc
+	 * @return Liczba słów (bit 0 nie jest używany - miejsca numerowane od 1)
+	 */
+	static size_t seatWordCount(int capacity);
+
+	/**
+	 * @brief Zwraca łączny rozmiar bloku (nagłówek + mapa bitowa) w słowach 64-bitowych
+	 * @param capacity Liczba miejsc
+	 * @return Rozmiar bloku w słowach
+	 */
+	static size_t blockWordCount(int capacity);
 
 	/**
 	 * @brief Zwraca ID pociągu
 	 * @return Unikalny identyfikator pociągu
 	 */
 	int getID() const;
-	
+
 	/**
 	 * @brief Zwraca nazwę stacji początkowej
-	 * @return Nazwa stacji początkowej
+	 * @return Nazwa stacji początkowej (referencja do napisu w puli stacji)
 	 */
-	std::string getOrigin() const;
-	
+	const std::string& getOrigin() const;
+
 	/**
 	 * @brief Zwraca nazwę stacji końcowej
-	 * @return Nazwa stacji końcowej
+	 * @return Nazwa stacji końcowej (referencja do napisu w puli stacji)
 	 */
-	std::string getDestination() const;
-	
+	const std::string& getDestination() const;
+
+	/**
+	 * @brief Zwraca zinternowany identyfikator stacji początkowej
+	 * @return Identyfikator w puli StringPool::stations()
+	 */
+	uint32_t getOriginId() const;
+
+	/**
+	 * @brief Zwraca zinternowany identyfikator stacji końcowej
+	 * @return Identyfikator w puli StringPool::stations()
+	 */
+	uint32_t getDestinationId() const;
+
 	/**
 	 * @brief Zwraca datę kursu
 	 * @return Data w formacie RRRR-MM-DD
 	 */
-	std::string getDate() const;
-	
+	std::string_view getDate() const;
+
+	/**
+	 * @brief Zwraca godzinę odjazdu
+	 * @return Minuty od północy lub NO_TIME
+	 */
+	uint16_t getDeparture() const;
+
+	/**
+	 * @brief Zwraca godzinę przyjazdu
+	 * @return Minuty od północy lub NO_TIME
+	 */
+	uint16_t getArrival() const;
+
+	/**
+	 * @brief Zamienia godzinę GG:MM na minuty od północy
+	 * @param text Godzina (np. "7:05" lub "17:30")
+	 * @param minutes Zmienna, do której zostanie zapisana liczba minut
+	 * @return true jeśli godzina jest poprawna (00:00-23:59)
+	 */
+	static bool parseTime(std::string_view text, uint16_t& minutes);
+
+	/**
+	 * @brief Zapisuje godzinę w formacie GG:MM
+	 * @param minutes Minuty od północy
+	 * @return Godzina lub "--:--" dla NO_TIME
+	 */
+	static std::string formatTime(uint16_t minutes);
+
+	/**
+	 * @brief Zamienia datę RRRR-MM-DD na liczbę RRRRMMDD (zachowuje porządek dat)
+	 * @param date Data
+	 * @return Liczba RRRRMMDD lub 0, jeśli data ma niepoprawny format
+	 */
+	static uint32_t dateKey(std::string_view date);
+
 	/**
 	 * @brief Zwraca całkowitą liczbę miejsc w pociągu
 	 * @return Pojemność pociągu
 	 */
 	int getCapacity() const;
 
+	/**
+	 * @brief Zwraca układ wagonów i klas
+	 * @return Układ miejsc pociągu
+	 */
+	const SeatLayout& getLayout() const;
+
+	/**
+	 * @brief Zwraca klasę miejsca
+	 * @param seatNumber Numer miejsca
+	 * @return Klasa (1 - druga, 2 - pierwsza) lub 0, jeśli numer jest nieprawidłowy
+	 */
+	int getSeatClass(int seatNumber) const;
+
+	/**
+	 * @brief Wyszukuje pierwsze wolne miejsce w danej klasie
+	 * @param travelClass Klasa (0 - dowolna)
+	 * @return Numer miejsca lub 0, jeśli w tej klasie nie ma wolnych miejsc
+	 */
+	int findFreeSeat(int travelClass) const;
+
+	/**
+	 * @brief Zlicza wolne miejsca w danej klasie
+	 * @param travelClass Klasa (0 - dowolna)
+	 * @return Liczba wolnych miejsc
+	 */
+	int getFreeSeatsCount(int travelClass) const;
+
 	/**
 	 * @brief Sprawdza czy dane miejsce jest wolne
 	 * @param seatNumber Numer miejsca do sprawdzenia
 	 * @return true jeśli miejsce jest wolne, false jeśli zajęte lub numer nieprawidłowy
 	 */
 	bool isSeatFree(int seatNumber) const;
-	
+
 	/**
 	 * @brief Rezerwuje wybrane miejsce w pociągu
 	 * @param seatNumber Numer miejsca do zarezerwowania
 	 * @return true jeśli rezerwacja powiodła się, false jeśli miejsce było zajęte
 	 */
 	bool reserveSeat(int seatNumber);
-	
+
 	/**
 	 * @brief Anuluje rezerwację wybranego miejsca
 	 * @param seatNumber Numer miejsca do zwolnienia
 	 */
 	void cancelSeat(int seatNumber);
 
+	/**
+	 * @brief Przenosi rezerwację na inne miejsce tej samej klasy jedną operacją
+	 *
+	 * Gdy oba miejsca leżą w tym samym słowie mapy bitowej, zmiana to jeden
+	 * zapis słowa - w żadnej chwili oba miejsca nie są wolne ani oba zajęte.
+	 * Liczba zajętych miejsc i dostępność klas nie zmieniają się.
+	 *
+	 * @param fromSeat Zajęte miejsce
+	 * @param toSeat Wolne miejsce tej samej klasy
+	 * @return true jeśli przeniesiono, false jeśli fromSeat jest wolne, toSeat zajęte lub klasy się różnią
+	 */
+	bool moveSeat(int fromSeat, int toSeat);
+
 	/**
 	 * @brief Zwraca liczbę zajętych miejsc w pociągu
 	 * @return Liczba zarezerwowanych miejsc
 	 */
 	int getOccupiedSeatsCount() const;
 
+	/**
+	 * @brief Zapisuje zajętość miejsc w zwartej postaci tekstowej
+	 *
+	 * Postać wybierana jest dla każdego pociągu osobno - krótsza z dwóch:
+	 * - przedziały zajętych miejsc, np. "1-40,45" (pociągi prawie puste lub zapełniane po kolei),
+	 * - mapa bitowa "x:" + 16 cyfr szesnastkowych na słowo, bez końcowych pustych słów
+	 *   (pociągi gęsto i nieregularnie zajęte).
+	 * Lista pojedynczych numerów (dawny format) to szczególny przypadek przedziałów.
+	 *
+	 * @return Zapis zajętości (pusty, gdy wszystkie miejsca są wolne)
+	 */
+	std::string encodeSeats() const;
+
+	/**
+	 * @brief Odtwarza zajętość miejsc z zapisu encodeSeats()
+	 *
+	 * Mapa bitowa kopiowana jest słowami, przedziały ustawiane maskami słów.
+	 * Wersja dostępności nie jest zmieniana.
+	 *
+	 * @param text Zapis zajętości (również dawna lista numerów oddzielonych przecinkami)
+	 * @return false jeśli zapis zawierał niepoprawne fragmenty (pomijane)
+	 */
+	bool decodeSeats(std::string_view text);
+
+	/**
+	 * @brief Zwraca wersję dostępności pociągu
+	 *
+	 * Wersja rośnie, gdy któraś klasa przekracza próg wyświetlania
+	 * (ostatnie wolne miejsce zajęte lub pierwsze miejsce zwolnione
+	 * w wyprzedanej klasie). Służy do unieważniania wyników wyszukiwania.
+	 *
+	 * @return Numer wersji
+	 */
+	uint32_t getVersion() const;
+
 	/**
 	 * @brief Wyświetla wizualną mapę zajętości miejsc w pociągu
-	 * 
-	 * Pokazuje stan wszystkich miejsc - wolne z numerami, zajęte oznaczone 'X'
+	 *
+	 * Pokazuje stan wszystkich miejsc wagon po wagonie, zgodnie z układem
+	 * rzędów - wolne z numerami, zajęte oznaczone 'X'
+	 *
+	 * @param out Strumień wyjścia sesji
 	 */
-	void displaySeats() const;
+	void displaySeats(std::ostream& out) const;
 };
-
@@ -0,0 +1,286 @@
+/**
+ * @file TrainCatalog.cpp
+ * @brief Implementacja klasy TrainCatalog - arena pociągów i indeks po ID
+ */
+
+#include "TrainCatalog.h"
+#include <algorithm>
+#include <new>
+
+/**
+ * @brief Przydziela blok pamięci z areny
+ *
+ * Najpierw sprawdza listę wolnych bloków tego samego rozmiaru (po usuniętych pociągach),
+ * potem wydziela miejsce z ostatniego slaba. Gdy slab jest pełny, tworzony jest nowy;
+ * pociągi większe niż slab dostają własny, dopasowany blok.
+ *
+ * @param words Rozmiar bloku w słowach 64-bitowych
+ * @return Wskaźnik na początek bloku
+ */
+void* TrainCatalog::allocateBlock(size_t words) {
+	auto freeIt = FfreeBlocks.find(words);
+	if (freeIt != FfreeBlocks.end() && !freeIt->second.empty()) {
+		void* block = freeIt->second.back();
+		freeIt->second.pop_back();
+		return block;
+	}
+
+	if (Fslabs.empty() || Fslabs.back().Fsize - Fslabs.back().Fused < words) {
+		size_t slabSize = std::max(SLAB_WORDS, words);
+		Fslabs.push_back(Slab{ std::make_unique<uint64_t[]>(slabSize), slabSize, 0 });
+	}
+
+	Slab& slab = Fslabs.back();
+	void* block = slab.Fwords.get() + slab.Fused;
+	slab.Fused += words;
+	return block;
+}
+
+/**
+ * @brief Tworzy nowy pociąg w arenie
+ *
+ * Pociąg konstruowany jest w miejscu (placement new) w przydzielonym bloku,
+ * a mapa bitowa miejsc zajmuje końcową część tego samego bloku.
+ *
+ * @param id Unikalny identyfikator pociągu
+ * @param origin Stacja początkowa
+ * @param destination Stacja końcowa
+ * @param date Data kursu
+ * @param layout Układ wagonów i klas
+ * @return Wskaźnik na nowy pociąg lub nullptr, jeśli ID jest zajęte lub układ pusty
+ */
+Train* TrainCatalog::add(int id, std::string_view origin, std::string_view destination, std::string_view date, const SeatLayout& layout) {
+	int capacity = layout.capacity();
+	if (capacity < 1 || FbyId.count(id)) return nullptr;
+
+	void* block = allocateBlock(Train::blockWordCount(capacity));
+	Train* train = new (block) Train(id, origin, destination, date, layout);
+
+	// Zajęcie wolnego slotu (lub utworzenie nowego)
+	uint32_t slotIndex;
+	if (!FfreeSlots.empty()) {
+		slotIndex = FfreeSlots.back();
+		FfreeSlots.pop_back();
+	}
+	else {
+		slotIndex = static_cast<uint32_t>(Fslots.size());
+		Fslots.push_back(Slot{ 0, 0, false });
+	}
+
+	Slot& slot = Fslots[slotIndex];
+	slot.FdenseIndex = static_cast<uint32_t>(Ftrains.size());
+	slot.Foccupied = true;
+
+	Ftrains.push_back(train);
+	FdenseToSlot.push_back(slotIndex);
+	FbyId.emplace(id, slotIndex);
+	Fdepartures.emplace(departureKey(Train::dateKey(train->getDate()), Train::NO_TIME), id, train);
+	bumpRoute(train->getOriginId(), train->getDestinationId());
+	Fstructure++;
+	return train;
+}
+
+/**
+ * @brief Tworzy nowy pociąg z jednolitym układem
+ * @param id Unikalny identyfikator pociągu
+ * @param origin Stacja początkowa
+ * @param destination Stacja końcowa
+ * @param date Data kursu
+ * @param capacity Liczba miejsc
+ * @return Wskaźnik na nowy pociąg lub nullptr
+ */
+Train* TrainCatalog::add(int id, std::string_view origin, std::string_view destination, std::string_view date, int capacity) {
+	return add(id, origin, destination, date, SeatLayout::uniform(capacity));
+}
+
+/**
+ * @brief Ustawia godziny odjazdu i przyjazdu pociągu
+ *
+ * Zmiana godziny odjazdu przenosi pociąg w indeksie odjazdów i zwiększa
+ * wersję jego trasy (wyniki wyszukiwania z filtrem godziny są nieaktualne).
+ *
+ * @param train Pociąg z tego katalogu
+ * @param departure Odjazd w minutach od północy
+ * @param arrival Przyjazd w minutach od północy
+ * @return true jeśli godziny są poprawne
+ */
+bool TrainCatalog::setTimes(Train& train, uint16_t departure, uint16_t arrival) {
+	auto valid = [](uint16_t minutes) { return minutes < Train::MINUTES_PER_DAY || minutes == Train::NO_TIME; };
+	if (!valid(departure) || !valid(arrival)) return false;
+
+	uint32_t date = Train::dateKey(train.getDate());
+	Fdepartures.erase(std::make_tuple(departureKey(date, train.Fdeparture), train.Fid, &train));
+	train.Fdeparture = departure;
+	train.Farrival = arrival;
+	Fdepartures.emplace(departureKey(date, departure), train.Fid, &train);
+	bumpRoute(train.ForiginId, train.FdestinationId);
+	markChanged(train.Fid);
+	return true;
+}
+
+/**
+ * @brief Rezerwuje miejsce w tablicach katalogu na kolejne pociągi
+ *
+ * Unika wielokrotnego przepisywania gęstej tablicy, slotów i przebudowy
+ * indeksu ID przy imporcie dziesiątek tysięcy kursów.
+ *
+ * @param additional Liczba pociągów, które zostaną dodane
+ */
+void TrainCatalog::reserve(size_t additional) {
+	size_t total = Ftrains.size() + additional;
+	Ftrains.reserve(total);
+	FdenseToSlot.reserve(total);
+	Fslots.reserve(Fslots.size() + additional);
+	FbyId.reserve(total);
+}
+
+/**
+ * @brief Wyszukuje pociąg po ID w indeksie haszującym
+ * @param id ID pociągu
+ * @return Wskaźnik na pociąg lub nullptr
+ */
+Train* TrainCatalog::find(int id) const {
+	auto it = FbyId.find(id);
+	return it == FbyId.end() ? nullptr : Ftrains[Fslots[it->second].FdenseIndex];
+}
+
+/**
+ * @brief Zwraca generacyjny uchwyt pociągu o danym ID
+ * @param id ID pociągu
+ * @return Uchwyt lub niewydany uchwyt, jeśli pociąg nie istnieje
+ */
+TrainHandle TrainCatalog::handleOf(int id) const {
+	auto it = FbyId.find(id);
+	if (it == FbyId.end()) return TrainHandle{};
+	return TrainHandle{ it->second, Fslots[it->second].Fgeneration };
+}
+
+/**
+ * @brief Zwraca pociąg wskazywany przez uchwyt
+ *
+ * Uchwyt jest ważny tylko gdy generacja slotu nie zmieniła się od jego wydania.
+ *
+ * @param handle Uchwyt pociągu
+ * @return Wskaźnik na pociąg lub nullptr
+ */
+Train* TrainCatalog::get(TrainHandle handle) const {
+	if (handle.Findex >= Fslots.size()) return nullptr;
+	const Slot& slot = Fslots[handle.Findex];
+	if (!slot.Foccupied || slot.Fgeneration != handle.Fgeneration) return nullptr;
+	return Ftrains[slot.FdenseIndex];
+}
+
+/**
+ * @brief Usuwa pociąg z katalogu w czasie O(1)
+ *
+ * Ostatni pociąg gęstej tablicy przenoszony jest na miejsce usuwanego,
+ * generacja slotu jest zwiększana (unieważnia stare uchwyty), a blok pociągu
+ * trafia na listę wolnych bloków swojego rozmiaru.
+ *
+ * @param id ID pociągu
+ * @return true jeśli pociąg istniał
+ */
+bool TrainCatalog::remove(int id) {
+	auto it = FbyId.find(id);
+	if (it == FbyId.end()) return false;
+
+	uint32_t slotIndex = it->second;
+	Slot& slot = Fslots[slotIndex];
+	uint32_t denseIndex = slot.FdenseIndex;
+	Train* train = Ftrains[denseIndex];
+	FbyId.erase(it);
+	Fdepartures.erase(std::make_tuple(departureKey(Train::dateKey(train->getDate()), train->getDeparture()), id, train));
+
+	// Przeniesienie ostatniego pociągu na zwolnione miejsce
+	uint32_t lastIndex = static_cast<uint32_t>(Ftrains.size() - 1);
+	if (denseIndex != lastIndex) {
+		Ftrains[denseIndex] = Ftrains[lastIndex];
+		FdenseToSlot[denseIndex] = FdenseToSlot[lastIndex];
+		Fslots[FdenseToSlot[denseIndex]].FdenseIndex = denseIndex;
+	}
+	Ftrains.pop_back();
+	FdenseToSlot.pop_back();
+
+	// Zwolnienie slotu - nowa generacja unieważnia wydane uchwyty
+	slot.Foccupied = false;
+	slot.Fgeneration++;
+	FfreeSlots.push_back(slotIndex);
+
+	bumpRoute(train->getOriginId(), train->getDestinationId());
+	Fchanged.erase(id);
+	Fstructure++;
+
+	size_t words = Train::blockWordCount(train->getCapacity());
+	train->~Train();
+	FfreeBlocks[words].push_back(train);
+	return true;
+}
+
+/**
+ * @brief Usuwa wszystkie pociągi
+ *
+ * Pociągi usuwane są od końca gęstej tablicy (bez przenoszenia elementów);
+ * wydane uchwyty tracą ważność, a wyniki wyszukiwania - aktualność.
+ */
+void TrainCatalog::clear() {
+	while (!Ftrains.empty()) remove(Ftrains.back()->getID());
+}
+
+// Rozmiar katalogu
+size_t TrainCatalog::size() const { return Ftrains.size(); }
+bool TrainCatalog::empty() const { return Ftrains.empty(); }
+
+/**
+ * @brief Zwraca łączny rozmiar pamięci areny
+ * @return Liczba bajtów zarezerwowanych na slaby
+ */
+size_t TrainCatalog::arenaBytes() const {
+	size_t total = 0;
+	for (const auto& slab : Fslabs) total += slab.Fsize * sizeof(uint64_t);
+	return total;
+}
+
+/**
+ * @brief Zwiększa wersję trasy, tworząc ją przy pierwszym pociągu
+ * @param originId Identyfikator stacji początkowej
+ * @param destinationId Identyfikator stacji końcowej
+ */
+void TrainCatalog::bumpRoute(uint32_t originId, uint32_t destinationId) {
+	auto result = FrouteVersions.emplace(routeKey(originId, destinationId), 0);
+	if (result.second) FrouteSetVersion++;
+	result.first->second++;
+}
+
+/**
+ * @brief Zwraca wersję trasy
+ * @param key Klucz trasy
+ * @return Wersja trasy
+ */
+uint32_t TrainCatalog::routeVersion(uint64_t key) const {
+	auto it = FrouteVersions.find(key);
+	return it == FrouteVersions.end() ? 0 : it->second;
+}
+
+// Wersja zbioru tras
+uint32_t TrainCatalog::routeSetVersion() const { return FrouteSetVersion; }
+
+/**
+ * @brief Oznacza zmianę dostępności pociągu
+ * @param train Pociąg
+ */
+void TrainCatalog::touchRoute(const Train& train) {
+	bumpRoute(train.getOriginId(), train.getDestinationId());
+}
+
+uint64_t TrainCatalog::structureVersion() const { return Fstructure; }
+
+/**
+ * @brief Oznacza pociąg jako zmieniony od ostatniej migawki
+ * @param id ID pociągu
+ */
+void TrainCatalog::markChanged(int id) {
+	Fchanged.insert(id);
+}
+
+const std::unordered_set<int>& TrainCatalog::changed() const { return Fchanged; }
+void TrainCatalog::clearChanged() { Fchanged.clear(); }
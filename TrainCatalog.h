@@ -0,0 +1,306 @@
+/**
+ * @file TrainCatalog.h
+ * @brief Deklaracja klasy TrainCatalog - katalog pociągów alokowanych w arenie
+ */
+
+#pragma once
+#include "Train.h"
+#include <vector>
+#include <memory>
+#include <set>
+#include <tuple>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @struct TrainHandle
+ * @brief Generacyjny uchwyt pociągu w katalogu
+ *
+ * Uchwyt składa się z numeru slotu i numeru generacji. Po usunięciu pociągu
+ * generacja slotu jest zwiększana, więc stare uchwyty przestają być ważne
+ * zamiast wskazywać na inny pociąg, który zajął ten sam slot.
+ */
+struct TrainHandle {
+	uint32_t Findex = 0xFFFFFFFFu;   ///< Numer slotu
+	uint32_t Fgeneration = 0;        ///< Generacja slotu w chwili wydania uchwytu
+
+	/**
+	 * @brief Sprawdza czy uchwyt został kiedykolwiek wydany
+	 * @return true jeśli uchwyt wskazuje na jakiś slot
+	 */
+	bool isValid() const { return Findex != 0xFFFFFFFFu; }
+};
+
+/**
+ * @class TrainCatalog
+ * @brief Właściciel wszystkich pociągów w systemie
+ *
+ * Pociągi (nagłówek + mapa bitowa miejsc) alokowane są w dużych blokach pamięci (slabach),
+ * dzięki czemu nie ma osobnej alokacji na każdy pociąg, a sąsiednie pociągi leżą obok siebie.
+ * Zwrócony wskaźnik Train* jest stabilny - katalog nigdy nie przenosi pociągów w pamięci.
+ * Bloki usuniętych pociągów trafiają na listy wolnych bloków według rozmiaru
+ * i są ponownie wykorzystywane.
+ *
+ * Wyszukiwanie po ID odbywa się w tablicy haszującej (O(1)).
+ *
+ * Katalog jest mapą slotów (slot map): pociągi żyją w gęstej tablicy do iteracji,
+ * a sloty z generacjami pozwalają wydawać trwałe uchwyty TrainHandle. Usunięcie pociągu
+ * przenosi ostatni element gęstej tablicy na miejsce usuniętego (O(1), bez przesuwania
+ * całej tablicy) - kolejność iteracji może się więc zmienić po usunięciu.
+ *
+ * Dla każdej trasy (para stacji) katalog prowadzi licznik wersji, zwiększany przy
+ * dodaniu lub usunięciu pociągu na tej trasie oraz przy zmianie dostępności pociągu
+ * (touchRoute). Licznik zbioru tras rośnie, gdy pojawia się nowa trasa.
+ * Na tej podstawie SearchCache unieważnia tylko wyniki zależne od zmienionych tras.
+ *
+ * Indeks odjazdów to zbiór uporządkowany według (data, godzina odjazdu, ID), więc
+ * pytanie "pociągi odjeżdżające w dniu X po 17:00" to jedno przejście po przedziale.
+ *
+ * Na potrzeby migawek (CatalogSnapshot) katalog prowadzi wersję struktury,
+ * zwiększaną przy dodaniu i usunięciu pociągu, oraz zbiór pociągów zmienionych
+ * od ostatniej migawki (markChanged).
+ */
+class TrainCatalog
+{
+public:
+	static constexpr size_t SLAB_WORDS = 8192;   ///< Rozmiar jednego slaba w słowach 64-bitowych (64 KiB)
+
+private:
+	/**
+	 * @struct Slab
+	 * @brief Blok pamięci areny, z którego wydzielane są kolejne pociągi
+	 */
+	struct Slab {
+		std::unique_ptr<uint64_t[]> Fwords;   ///< Pamięć slaba
+		size_t Fsize;                         ///< Rozmiar w słowach
+		size_t Fused;                         ///< Liczba wykorzystanych słów
+	};
+
+	/**
+	 * @struct Slot
+	 * @brief Slot mapy slotów - wskazuje pozycję pociągu w gęstej tablicy
+	 */
+	struct Slot {
+		uint32_t FdenseIndex;    ///< Pozycja w gęstej tablicy (gdy slot zajęty)
+		uint32_t Fgeneration;    ///< Aktualna generacja slotu
+		bool Foccupied;          ///< Czy slot zawiera pociąg
+	};
+
+	std::vector<Slab> Fslabs;                                        ///< Slaby areny
+	std::unordered_map<size_t, std::vector<void*>> FfreeBlocks;      ///< Wolne bloki według rozmiaru w słowach
+	std::vector<Train*> Ftrains;                                     ///< Gęsta tablica pociągów (do iteracji)
+	std::vector<uint32_t> FdenseToSlot;                              ///< Dla każdej pozycji gęstej tablicy - numer slotu
+	std::vector<Slot> Fslots;                                        ///< Sloty z generacjami
+	std::vector<uint32_t> FfreeSlots;                                ///< Wolne sloty do ponownego użycia
+	std::unordered_map<int, uint32_t> FbyId;                         ///< Indeks ID -> numer slotu
+	std::unordered_map<uint64_t, uint32_t> FrouteVersions;           ///< Wersje tras (klucz routeKey)
+	uint32_t FrouteSetVersion = 0;                                   ///< Wersja zbioru tras
+	std::set<std::tuple<uint64_t, int, Train*>> Fdepartures;         ///< Indeks (departureKey, ID, pociąg)
+	uint64_t Fstructure = 0;                                         ///< Wersja struktury (dodania i usunięcia pociągów)
+	std::unordered_set<int> Fchanged;                                ///< Pociągi zmienione od ostatniej migawki
+
+	/**
+	 * @brief Zwiększa wersję trasy (tworzy trasę, jeśli jest nowa)
+	 * @param originId Identyfikator stacji początkowej
+	 * @param destinationId Identyfikator stacji końcowej
+	 */
+	void bumpRoute(uint32_t originId, uint32_t destinationId);
+
+	/**
+	 * @brief Przydziela blok pamięci o podanym rozmiarze z areny
+	 * @param words Rozmiar bloku w słowach 64-bitowych
+	 * @return Wskaźnik na początek bloku
+	 */
+	void* allocateBlock(size_t words);
+
+public:
+	TrainCatalog() = default;
+	TrainCatalog(const TrainCatalog&) = delete;
+	TrainCatalog& operator=(const TrainCatalog&) = delete;
+
+	/**
+	 * @brief Tworzy nowy pociąg w arenie
+	 * @param id Unikalny identyfikator pociągu
+	 * @param origin Stacja początkowa
+	 * @param destination Stacja końcowa
+	 * @param date Data kursu (RRRR-MM-DD)
+	 * @param layout Układ wagonów i klas
+	 * @return Wskaźnik na nowy pociąg lub nullptr, jeśli pociąg o tym ID już istnieje lub układ jest pusty
+	 */
+	Train* add(int id, std::string_view origin, std::string_view destination, std::string_view date, const SeatLayout& layout);
+
+	/**
+	 * @brief Tworzy nowy pociąg z jednolitym układem (jeden wagon drugiej klasy)
+	 * @param id Unikalny identyfikator pociągu
+	 * @param origin Stacja początkowa
+	 * @param destination Stacja końcowa
+	 * @param date Data kursu (RRRR-MM-DD)
+	 * @param capacity Liczba miejsc (1..SeatLayout::MAX_CAPACITY)
+	 * @return Wskaźnik na nowy pociąg lub nullptr, jeśli ID jest zajęte lub liczba miejsc nieprawidłowa
+	 */
+	Train* add(int id, std::string_view origin, std::string_view destination, std::string_view date, int capacity);
+
+	/**
+	 * @brief Ustawia godziny odjazdu i przyjazdu pociągu (aktualizuje indeks odjazdów)
+	 * @param train Pociąg z tego katalogu
+	 * @param departure Odjazd w minutach od północy (Train::NO_TIME - brak)
+	 * @param arrival Przyjazd w minutach od północy (Train::NO_TIME - brak)
+	 * @return true jeśli godziny są poprawne
+	 */
+	bool setTimes(Train& train, uint16_t departure, uint16_t arrival);
+
+	/**
+	 * @brief Rezerwuje miejsce w tablicach katalogu na kolejne pociągi (import hurtowy)
+	 * @param additional Liczba pociągów, które zostaną dodane
+	 */
+	void reserve(size_t additional);
+
+	/**
+	 * @brief Wyszukuje pociąg po ID
+	 * @param id ID pociągu
+	 * @return Wskaźnik na pociąg lub nullptr
+	 */
+	Train* find(int id) const;
+
+	/**
+	 * @brief Zwraca generacyjny uchwyt pociągu o danym ID
+	 * @param id ID pociągu
+	 * @return Uchwyt lub niewydany uchwyt (isValid() == false), jeśli pociąg nie istnieje
+	 */
+	TrainHandle handleOf(int id) const;
+
+	/**
+	 * @brief Zwraca pociąg wskazywany przez uchwyt
+	 * @param handle Uchwyt wydany przez handleOf()
+	 * @return Wskaźnik na pociąg lub nullptr, jeśli pociąg został usunięty
+	 */
+	Train* get(TrainHandle handle) const;
+
+	/**
+	 * @brief Usuwa pociąg z katalogu i zwraca jego blok do ponownego użycia
+	 *
+	 * Operacja O(1): ostatni pociąg z gęstej tablicy zajmuje miejsce usuniętego.
+	 *
+	 * @param id ID pociągu
+	 * @return true jeśli pociąg istniał
+	 */
+	bool remove(int id);
+
+	/**
+	 * @brief Usuwa wszystkie pociągi (bloki wracają na listy wolnych bloków, wersje tras rosną)
+	 */
+	void clear();
+
+	/**
+	 * @brief Zwraca liczbę pociągów w katalogu
+	 * @return Liczba pociągów
+	 */
+	size_t size() const;
+
+	/**
+	 * @brief Sprawdza czy katalog jest pusty
+	 * @return true jeśli brak pociągów
+	 */
+	bool empty() const;
+
+	/**
+	 * @brief Zwraca łączny rozmiar pamięci areny w bajtach
+	 * @return Liczba bajtów zarezerwowanych na slaby
+	 */
+	size_t arenaBytes() const;
+
+	/**
+	 * @brief Zwraca klucz trasy dla pary stacji
+	 * @param originId Identyfikator stacji początkowej
+	 * @param destinationId Identyfikator stacji końcowej
+	 * @return Klucz trasy
+	 */
+	static uint64_t routeKey(uint32_t originId, uint32_t destinationId) {
+		return (static_cast<uint64_t>(originId) << 32) | destinationId;
+	}
+
+	/**
+	 * @brief Zwraca wersję trasy
+	 * @param key Klucz trasy (routeKey)
+	 * @return Wersja trasy (0 dla trasy, która nigdy nie miała pociągu)
+	 */
+	uint32_t routeVersion(uint64_t key) const;
+
+	/**
+	 * @brief Zwraca wersję zbioru tras (rośnie, gdy pojawia się nowa trasa)
+	 * @return Wersja zbioru tras
+	 */
+	uint32_t routeSetVersion() const;
+
+	/**
+	 * @brief Oznacza zmianę dostępności pociągu - zwiększa wersję jego trasy
+	 * @param train Pociąg, którego dostępność przekroczyła próg
+	 */
+	void touchRoute(const Train& train);
+
+	/**
+	 * @brief Zwraca wersję struktury katalogu (rośnie przy dodaniu i usunięciu pociągu)
+	 * @return Wersja struktury
+	 */
+	uint64_t structureVersion() const;
+
+	/**
+	 * @brief Oznacza pociąg jako zmieniony od ostatniej migawki
+	 * @param id ID pociągu
+	 */
+	void markChanged(int id);
+
+	/**
+	 * @brief Zwraca pociągi zmienione od ostatniej migawki
+	 * @return ID pociągów
+	 */
+	const std::unordered_set<int>& changed() const;
+
+	/**
+	 * @brief Czyści zbiór zmienionych pociągów (po wykonaniu migawki)
+	 */
+	void clearChanged();
+
+	/**
+	 * @brief Zwraca klucz indeksu odjazdów
+	 * @param dateKey Data jako RRRRMMDD (Train::dateKey)
+	 * @param minutes Godzina odjazdu w minutach od północy
+	 * @return Klucz porządkujący według daty, a potem godziny
+	 */
+	static uint64_t departureKey(uint32_t dateKey, uint16_t minutes) {
+		return (static_cast<uint64_t>(dateKey) << 16) | minutes;
+	}
+
+	/**
+	 * @brief Odwiedza pociągi odjeżdżające w przedziale (data, godzina) - jedno przejście po indeksie
+	 * @param from Początek przedziału (departureKey, włącznie)
+	 * @param to Koniec przedziału (departureKey, włącznie)
+	 * @param visit Funkcja wywoływana jako visit(const Train&) w kolejności odjazdów
+	 */
+	template <typename Visitor>
+	void forEachDeparture(uint64_t from, uint64_t to, Visitor visit) const {
+		for (auto it = Fdepartures.lower_bound(std::make_tuple(from, std::numeric_limits<int>::min(), nullptr)); it != Fdepartures.end(); ++it) {
+			if (std::get<0>(*it) > to) break;
+			visit(static_cast<const Train&>(*std::get<2>(*it)));
+		}
+	}
+
+	/**
+	 * @brief Odwiedza wszystkie znane trasy
+	 * @param visit Funkcja wywoływana jako visit(klucz, id stacji początkowej, id stacji końcowej, wersja)
+	 */
+	template <typename Visitor>
+	void forEachRoute(Visitor visit) const {
+		for (const auto& route : FrouteVersions) {
+			visit(route.first, static_cast<uint32_t>(route.first >> 32), static_cast<uint32_t>(route.first), route.second);
+		}
+	}
+
+	// Iteracja po wszystkich pociągach (gęsta tablica)
+	std::vector<Train*>::const_iterator begin() const { return Ftrains.begin(); }
+	std::vector<Train*>::const_iterator end() const { return Ftrains.end(); }
+};
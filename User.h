@@ -7,6 +7,10 @@
 
 #include <string>
 #include <iostream>
+#include <utility>
+#include <cstdint>
+#include "StringPool.h"
+#include "PasswordHasher.h"
 
 /**
  * @class User
@@ -20,16 +24,18 @@ class User
 {
 private:
 	std::string Flogin;      ///< Login użytkownika
-	std::string Fpassword;   ///< Hasło użytkownika
+	std::string Fpassword;   ///< Solony skrót hasła (format PasswordHasher)
 	int Fid;                 ///< Unikalny identyfikator użytkownika
+	uint32_t FloginId;       ///< Identyfikator loginu w StringPool::logins()
 protected:
 	/**
 	 * @brief Konstruktor chroniony - klasa może być tworzona tylko przez klasy dziedziczące
 	 * @param login Login użytkownika
-	 * @param password Hasło użytkownika
+	 * @param password Skrót hasła użytkownika (wynik PasswordHasher::hash)
 	 * @param id Unikalny identyfikator użytkownika
 	 */
-	User(std::string login, std::string password, int id) : Flogin(login), Fpassword(password), Fid(id) {}
+	User(std::string login, std::string password, int id)
+		: Flogin(std::move(login)), Fpassword(std::move(password)), Fid(id), FloginId(StringPool::logins().intern(Flogin)) {}
 public:
 	/**
 	 * @brief Wirtualny destruktor - pozwala na poprawne usuwanie obiektów klas pochodnych
@@ -38,8 +44,9 @@ public:
 
 	/**
 	 * @brief Czysto wirtualna metoda wyświetlająca menu dla danego typu użytkownika
+	 * @param out Strumień wyjścia sesji
 	 */
-	virtual void showMenu() = 0;
+	virtual void showMenu(std::ostream& out) = 0;
 
 	/**
 	 * @brief Czysto wirtualna metoda zwracająca typ użytkownika
@@ -51,18 +58,31 @@ public:
 	 * @brief Getter dla loginu użytkownika
 	 * @return Login użytkownika
 	 */
-	std::string get_Flogin() const {return Flogin;}
+	const std::string& get_Flogin() const { return Flogin; }
 	
 	/**
-	 * @brief Getter dla hasła użytkownika
-	 * @return Hasło użytkownika
+	 * @brief Getter dla skrótu hasła użytkownika
+	 * @return Solony skrót hasła (do zapisu w pliku)
 	 */
-	std::string get_Fpassword() const { return Fpassword; }
+	const std::string& get_Fpassword() const { return Fpassword; }
+
+	/**
+	 * @brief Sprawdza podane hasło względem zapisanego skrótu
+	 * @param password Hasło jawnym tekstem
+	 * @return true jeśli hasło jest poprawne
+	 */
+	bool verifyPassword(std::string_view password) const { return PasswordHasher::verify(password, Fpassword); }
 	
 	/**
 	 * @brief Getter dla ID użytkownika
 	 * @return Unikalny identyfikator użytkownika
 	 */
 	int get_Fid() const { return Fid; }
+
+	/**
+	 * @brief Getter dla zinternowanego loginu użytkownika
+	 * @return Identyfikator loginu w puli StringPool::logins()
+	 */
+	uint32_t get_FloginId() const { return FloginId; }
 };
 
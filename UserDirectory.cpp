@@ -0,0 +1,57 @@
+/**
+ * @file UserDirectory.cpp
+ * @brief Implementacja klasy UserDirectory - katalog użytkowników
+ */
+
+#include "UserDirectory.h"
+#include "StringPool.h"
+#include <algorithm>
+#include <utility>
+
+/**
+ * @brief Dodaje użytkownika do katalogu, jeśli login nie jest zajęty
+ * @param user Nowy użytkownik
+ * @return Wskaźnik na dodanego użytkownika lub nullptr
+ */
+User* UserDirectory::add(std::unique_ptr<User> user) {
+	if (!user || FbyLogin.count(user->get_FloginId())) return nullptr;
+
+	User* raw = user.get();
+	FbyLogin.emplace(raw->get_FloginId(), raw);
+	FmaxId = std::max(FmaxId, raw->get_Fid());
+	Fusers.push_back(std::move(user));
+	return raw;
+}
+
+/**
+ * @brief Wyszukuje użytkownika po loginie
+ *
+ * Login, którego nie ma w puli loginów, na pewno nie należy do żadnego konta -
+ * wtedy pula nie jest powiększana.
+ *
+ * @param login Login użytkownika
+ * @return Wskaźnik na użytkownika lub nullptr
+ */
+User* UserDirectory::find(std::string_view login) const {
+	uint32_t loginId;
+	if (!StringPool::logins().find(login, loginId)) return nullptr;
+	auto it = FbyLogin.find(loginId);
+	return it == FbyLogin.end() ? nullptr : it->second;
+}
+
+/**
+ * @brief Weryfikuje login i hasło
+ * @param login Login użytkownika
+ * @param password Hasło jawnym tekstem
+ * @return Wskaźnik na użytkownika lub nullptr
+ */
+User* UserDirectory::authenticate(std::string_view login, std::string_view password) const {
+	User* user = find(login);
+	if (user == nullptr || !user->verifyPassword(password)) return nullptr;
+	return user;
+}
+
+// Rozmiar katalogu i kolejne ID
+int UserDirectory::nextId() const { return FmaxId + 1; }
+size_t UserDirectory::size() const { return Fusers.size(); }
+bool UserDirectory::empty() const { return Fusers.empty(); }
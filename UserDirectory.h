@@ -0,0 +1,73 @@
+/**
+ * @file UserDirectory.h
+ * @brief Deklaracja klasy UserDirectory - katalog użytkowników z indeksem haszującym
+ */
+
+#pragma once
+#include "User.h"
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <string_view>
+#include <cstdint>
+
+/**
+ * @class UserDirectory
+ * @brief Właściciel wszystkich kont użytkowników
+ *
+ * Przechowuje użytkowników oraz indeks login -> użytkownik oparty na
+ * zinternowanych loginach (StringPool::logins()), więc logowanie i sprawdzanie
+ * unikalności loginu przy rejestracji działają w czasie O(1).
+ */
+class UserDirectory
+{
+private:
+	std::vector<std::unique_ptr<User>> Fusers;          ///< Wszyscy użytkownicy (kolejność dodania)
+	std::unordered_map<uint32_t, User*> FbyLogin;       ///< Indeks identyfikator loginu -> użytkownik
+	int FmaxId = 0;                                     ///< Najwyższe ID użytkownika
+
+public:
+	/**
+	 * @brief Dodaje użytkownika do katalogu
+	 * @param user Nowy użytkownik
+	 * @return Wskaźnik na dodanego użytkownika lub nullptr, jeśli login jest już zajęty
+	 */
+	User* add(std::unique_ptr<User> user);
+
+	/**
+	 * @brief Wyszukuje użytkownika po loginie
+	 * @param login Login użytkownika
+	 * @return Wskaźnik na użytkownika lub nullptr
+	 */
+	User* find(std::string_view login) const;
+
+	/**
+	 * @brief Weryfikuje login i hasło
+	 * @param login Login użytkownika
+	 * @param password Hasło jawnym tekstem
+	 * @return Wskaźnik na zalogowanego użytkownika lub nullptr przy błędnych danych
+	 */
+	User* authenticate(std::string_view login, std::string_view password) const;
+
+	/**
+	 * @brief Zwraca ID dla nowego użytkownika
+	 * @return Najwyższe dotychczasowe ID + 1
+	 */
+	int nextId() const;
+
+	/**
+	 * @brief Zwraca liczbę użytkowników
+	 * @return Liczba użytkowników
+	 */
+	size_t size() const;
+
+	/**
+	 * @brief Sprawdza czy katalog jest pusty
+	 * @return true jeśli brak użytkowników
+	 */
+	bool empty() const;
+
+	// Iteracja po wszystkich użytkownikach
+	std::vector<std::unique_ptr<User>>::const_iterator begin() const { return Fusers.begin(); }
+	std::vector<std::unique_ptr<User>>::const_iterator end() const { return Fusers.end(); }
+};
@@ -4,6 +4,8 @@
  * 
  * Aplikacja konsolowa do zarządzania rezerwacjami biletów kolejowych.
  * Obsługuje dwa typy użytkowników: Administratorów i Pasażerów.
+ * Sesje menu są korutynami (Task), więc jeden wątek może prowadzić
+ * wiele sesji naraz (konsola i klienci SessionServer).
  * Dane są przechowywane w plikach YAML dla trwałości między sesjami.
  */
 
@@ -11,13 +13,33 @@
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <string>
+#include <cstdlib>
 #include "User.h"
 #include "Admin.h"
 #include "Passenger.h"
 #include "Train.h"
+#include "TrainCatalog.h"
 #include "Ticket.h"
+#include "TicketStore.h"
+#include "IdAllocator.h"
+#include "PricingEngine.h"
+#include "BookingEngine.h"
+#include "UserDirectory.h"
+#include "SessionManager.h"
+#include "PasswordHasher.h"
+#include "BatchProcessor.h"
+#include "TimetableImporter.h"
+#include "ArchiveManager.h"
+#include "ShardPool.h"
+#include "ReplicationServer.h"
+#include "ReplicaClient.h"
 #include "DataManager.h"
 #include "InputValidation.h"
+#include "LineReader.h"
+#include "SessionIO.h"
+#include "SessionServer.h"
+#include "Task.h"
 
 /**
  * @brief Rejestracja nowego użytkownika (pasażera) w systemie
@@ -26,30 +48,27 @@
  * - Sprawdza unikalność loginu
  * - Waliduje hasło (minimum 3 znaki)
  * - Generuje unikalny ID
- * - Zapisuje nowego użytkownika do pliku
+ * - Zapisuje nowego użytkownika do pliku (hasło jako solony skrót)
  * 
- * @param users Wektor wszystkich użytkowników w systemie
+ * @param io Kanał sesji
+ * @param users Katalog wszystkich użytkowników w systemie
  * @param dm Menedżer danych do zapisywania użytkowników
  */
-void registerUser(std::vector<std::unique_ptr<User>>& users, DataManager& dm) {
-    std::cout << "\n--- REJESTRACJA NOWEGO UZYTKOWNIKA ---\n";
+Task<void> registerUser(SessionIO& io, UserDirectory& users, DataManager& dm) {
+    std::ostream& out = io.out();
+    out << "\n--- REJESTRACJA NOWEGO UZYTKOWNIKA ---\n";
 
     std::string newLogin, newPass;
 
     // Sprawdzenie unikalności loginu
     while (true) {
-        readLine("Podaj login: ", newLogin);
+        newLogin = co_await readLine(io, "Podaj login: ");
 
-        auto it = std::find_if(users.begin(), users.end(),
-            [&newLogin](const std::unique_ptr<User>& u) {
-                return u->get_Flogin() == newLogin;
-            });
-
-        if (it != users.end()) {
-            std::cout << "Blad: Taki login jest juz zajety. Wybierz inny.\n";
+        if (users.find(newLogin) != nullptr) {
+            out << "Blad: Taki login jest juz zajety. Wybierz inny.\n";
         }
         else if (newLogin.empty()) {
-            std::cout << "Blad: Login nie moze byc pusty.\n";
+            out << "Blad: Login nie moze byc pusty.\n";
         }
         else {
             break;
@@ -58,29 +77,29 @@ void registerUser(std::vector<std::unique_ptr<User>>& users, DataManager& dm) {
 
     // Walidacja hasła
     while (true) {
-        readLine("Podaj haslo: ", newPass);
+        newPass = co_await readLine(io, "Podaj haslo: ");
         if (newPass.length() < 3) {
-            std::cout << "Haslo musi miec co najmniej 3 znaki.\n";
+            out << "Haslo musi miec co najmniej 3 znaki.\n";
         }
         else {
             break;
         }
     }
 
-    // Generowanie unikalnego ID
-    int maxId = 0;
-    for (const auto& u : users) {
-        if (u->get_Fid() > maxId) maxId = u->get_Fid();
+    // Login mógł zostać zajęty przez inną sesję w czasie podawania hasła
+    if (users.find(newLogin) != nullptr) {
+        out << "Blad: Taki login jest juz zajety. Wybierz inny.\n";
+        co_return;
     }
-    int newId = maxId + 1;
 
-    // Utworzenie nowego pasażera
-    users.push_back(std::make_unique<Passenger>(newLogin, newPass, newId));
+    // Utworzenie nowego pasażera z unikalnym ID i skrótem hasła
+    users.add(std::make_unique<Passenger>(std::move(newLogin), PasswordHasher::hash(newPass), users.nextId()));
 
-    // Zapisanie do pliku
+    // Zapisanie do pliku (konta nie przechodzą przez dziennik - znacznik dla replik)
     dm.saveUsers(users);
+    dm.announceSnapshots();
 
-    std::cout << "SUKCES! Konto utworzone. Mozesz sie teraz zalogowac.\n";
+    out << "SUKCES! Konto utworzone. Mozesz sie teraz zalogowac.\n";
 }
 
 /**
@@ -92,49 +111,52 @@ void registerUser(std::vector<std::unique_ptr<User>>& users, DataManager& dm) {
  * - Anulowanie rezerwacji
  * - Modyfikację rezerwacji
  * 
+ * Operacje na biletach trafiają na bieżąco do dziennika (BookingEngine),
+ * więc pełne migawki zapisywane są tylko co DataManager::CHECKPOINT_RECORDS operacji.
+ * 
+ * @param io Kanał sesji
  * @param user Wskaźnik do zalogowanego pasażera
- * @param trains Wektor pociągów w systemie
- * @param tickets Wektor biletów w systemie
+ * @param engine Silnik rezerwacji (pociągi, bilety, generator ID)
  * @param dm Menedżer danych do zapisywania zmian
  */
-void passengerSession(Passenger* user, std::vector<Train>& trains, std::vector<Ticket>& tickets, DataManager& dm) {
+Task<void> passengerSession(SessionIO& io, Passenger* user, BookingEngine& engine, DataManager& dm) {
+    std::ostream& out = io.out();
+    TrainCatalog& trains = engine.trains();
+    TicketStore& tickets = engine.tickets();
+
     bool sessionActive = true;
     while (sessionActive) {
-        user->showMenu();
+        user->showMenu(out);
 
-        int choice;
-        readInt("Wybierz opcje: ", choice);
+        int choice = co_await readInt(io, "Wybierz opcje: ");
 
         switch (choice) {
         case 1:
             // Rezerwacja nowego biletu
-            user->bookTicket(trains, tickets);
-            dm.saveTrains(trains);
-            dm.saveTickets(tickets);
+            co_await user->bookTicket(io, engine);
+            dm.checkpointIfDue(trains, tickets);
             break;
         case 2:
             // Wyświetl moje bilety
-            user->listMyTickets(tickets);
+            user->listMyTickets(out, tickets);
             break;
         case 3:
             // Anuluj rezerwację
-            user->cancelBooking(trains, tickets);
-            dm.saveTrains(trains); 
-            dm.saveTickets(tickets); 
+            co_await user->cancelBooking(io, engine);
+            dm.checkpointIfDue(trains, tickets);
             break;
         case 4:
             // Modyfikuj rezerwację
-            user->modifyBooking(trains, tickets);
-            dm.saveTrains(trains);
-            dm.saveTickets(tickets);
+            co_await user->modifyBooking(io, engine);
+            dm.checkpointIfDue(trains, tickets);
             break;
         case 5:
             // Wyloguj
             sessionActive = false;
-            std::cout << "Wylogowano.\n";
+            out << "Wylogowano.\n";
             break;
         default:
-            std::cout << "Niepoprawna opcja.\n";
+            out << "Niepoprawna opcja.\n";
         }
     }
 }
@@ -146,87 +168,96 @@ void passengerSession(Passenger* user, std::vector<Train>& trains, std::vector<T
  * - Dodawanie nowych pociągów
  * - Usuwanie pociągów
  * - Generowanie raportów systemowych
+ * - Import rozkładu jazdy z pliku CSV
+ * - Archiwizację odjechanych pociągów
+ * 
+ * Zmiany katalogu nie przechodzą przez dziennik - zapisywane są od razu
+ * w migawkach, a znacznik w dzienniku (announceSnapshots) powiadamia repliki.
  * 
+ * @param io Kanał sesji
  * @param user Wskaźnik do zalogowanego administratora
- * @param trains Wektor pociągów w systemie
- * @param tickets Wektor biletów w systemie
- * @param users Wektor użytkowników w systemie
+ * @param engine Silnik rezerwacji (migawki do raportów)
+ * @param trains Katalog pociągów w systemie
+ * @param tickets Magazyn biletów w systemie
+ * @param users Katalog użytkowników w systemie
+ * @param archive Archiwum odjechanych pociągów
  * @param dm Menedżer danych do zapisywania zmian
  */
-void adminSession(Admin* user, std::vector<Train>& trains, std::vector<Ticket>& tickets, std::vector<std::unique_ptr<User>>& users, DataManager& dm) {
+Task<void> adminSession(SessionIO& io, Admin* user, BookingEngine& engine, TrainCatalog& trains, TicketStore& tickets, UserDirectory& users, ArchiveManager& archive, DataManager& dm) {
+    std::ostream& out = io.out();
     bool sessionActive = true;
     while (sessionActive) {
-        user->showMenu();
+        user->showMenu(out);
 
-        int choice;
-        readInt("Wybierz opcje: ", choice);
+        int choice = co_await readInt(io, "Wybierz opcje: ");
 
         switch (choice) {
         case 1:
             // Dodaj nowy pociąg
-            user->addTrain(trains);
+            co_await user->addTrain(io, trains);
             dm.saveTrains(trains);
+            dm.announceSnapshots();
             break;
         case 2:
             // Usuń pociąg (wraz z powiązanymi biletami)
-            user->removeTrain(trains, tickets);
+            co_await user->removeTrain(io, trains, tickets);
 
             dm.saveTrains(trains);
             dm.saveTickets(tickets);
+            dm.announceSnapshots();
             break;
         case 3:
-            // Generuj raport systemowy
-            user->generateReport(trains, tickets, users);
+            // Generuj raport systemowy (ze spójnej migawki)
+            user->generateReport(out, *engine.snapshot(), users, archive);
             break;
         case 4:
+            // Import rozkładu jazdy z pliku CSV
+            co_await user->importTimetable(io, trains);
+            dm.saveTrains(trains);
+            dm.announceSnapshots();
+            break;
+        case 5:
+            // Archiwizacja odjechanych pociągów wraz z biletami
+            user->archiveDeparted(out, trains, tickets, archive);
+            dm.saveTrains(trains);
+            dm.saveTickets(tickets);
+            dm.announceSnapshots();
+            break;
+        case 6:
             // Wyloguj
             sessionActive = false;
-            std::cout << "Wylogowano.\n";
+            out << "Wylogowano.\n";
             break;
         default:
-            std::cout << "Niepoprawna opcja.\n";
+            out << "Niepoprawna opcja.\n";
         }
     }
 }
 
 /**
- * @brief Główna funkcja programu
+ * @brief Menu główne jednej sesji - logowanie, rejestracja i wyjście
  * 
- * Inicjalizuje system, wczytuje dane z plików YAML i uruchamia główną pętlę aplikacji.
- * Obsługuje logowanie, rejestrację i zapisywanie danych przy wyjściu.
+ * Korutyna kończy się po wybraniu opcji wyjścia; dane zapisuje main()
+ * po zakończeniu sesji konsoli.
  * 
- * @return 0 przy poprawnym zakończeniu programu
+ * @param io Kanał sesji
+ * @param engine Silnik rezerwacji
+ * @param trains Katalog pociągów w systemie
+ * @param tickets Magazyn biletów w systemie
+ * @param users Katalog użytkowników w systemie
+ * @param archive Archiwum odjechanych pociągów
+ * @param dm Menedżer danych do zapisywania zmian
  */
-int main() {
-    // Inicjalizacja menedżera danych
-    DataManager dm;
-    std::vector<std::unique_ptr<User>> users;
-    std::vector<Train> trains;
-    std::vector<Ticket> tickets;
-
-    // Wczytanie danych z plików
-    std::cout << "Inicjalizacja systemu...\n";
-    dm.loadUsers(users);
-    dm.loadTrains(trains);
-    dm.loadTickets(tickets);
-
-    // Utworzenie domyślnego konta administratora przy pierwszym uruchomieniu
-    if (users.empty()) {
-        std::cout << "Pierwsze uruchomienie. Tworzenie konta admin/admin.\n";
-        users.push_back(std::make_unique<Admin>("admin", "admin", 1));
-        dm.saveUsers(users);
-    }
-
-    // Główna pętla aplikacji
+Task<void> mainMenu(SessionIO& io, BookingEngine& engine, TrainCatalog& trains, TicketStore& tickets, UserDirectory& users, ArchiveManager& archive, DataManager& dm) {
+    std::ostream& out = io.out();
     bool appRunning = true;
     while (appRunning) {
-        std::cout << "\n=== SYSTEM REZERWACJI KOLEJOWEJ ===\n";
-        std::cout << "1. Zaloguj sie\n";
-        std::cout << "2. Zarejestruj sie (Nowy Pasazer)\n";
-        std::cout << "3. Wyjdz i Zapisz\n";
+        out << "\n=== SYSTEM REZERWACJI KOLEJOWEJ ===\n";
+        out << "1. Zaloguj sie\n";
+        out << "2. Zarejestruj sie (Nowy Pasazer)\n";
+        out << "3. Wyjdz i Zapisz\n";
 
-        int choice;
-        readInt("Wybierz: ", choice);
+        int choice = co_await readInt(io, "Wybierz: ");
 
         if (choice == 3) {
             // Wyjście z aplikacji
@@ -234,46 +265,215 @@ int main() {
         }
         else if (choice == 2) {
             // Rejestracja nowego użytkownika
-            registerUser(users, dm);
+            co_await registerUser(io, users, dm);
         }
         else if (choice == 1) {
             // Logowanie
-            std::string login, pass;
-            readLine("Login: ", login);
-            readLine("Haslo: ", pass);
+            std::string login = co_await readLine(io, "Login: ");
+            std::string pass = co_await readLine(io, "Haslo: ");
 
 
-            // Wyszukanie użytkownika z podanym loginem i hasłem
-            auto it = std::find_if(users.begin(), users.end(),
-                [&login, &pass](const std::unique_ptr<User>& u) {
-                    return u->get_Flogin() == login && u->get_Fpassword() == pass;
-                });
+            // Wyszukanie użytkownika po loginie i weryfikacja skrótu hasła
+            User* loggedUser = users.authenticate(login, pass);
 
-            if (it != users.end()) {
-                User* loggedUser = it->get();
+            if (loggedUser != nullptr) {
 
                 // Rozpoznanie typu użytkownika i uruchomienie odpowiedniej sesji
                 if (auto admin = dynamic_cast<Admin*>(loggedUser)) {
-                    adminSession(admin, trains, tickets, users, dm);
+                    co_await adminSession(io, admin, engine, trains, tickets, users, archive, dm);
                 }
                 else if (auto passenger = dynamic_cast<Passenger*>(loggedUser)) {
-                    passengerSession(passenger, trains, tickets, dm);
+                    co_await passengerSession(io, passenger, engine, dm);
                 }
             }
             else {
-                std::cout << "Bledny login lub haslo!\n";
+                out << "Bledny login lub haslo!\n";
             }
         }
         else {
-            std::cout << "Niepoprawna opcja.\n";
+            out << "Niepoprawna opcja.\n";
         }
     }
+}
+
+/**
+ * @brief Główna funkcja programu
+ * 
+ * Inicjalizuje system, wczytuje dane z plików YAML i uruchamia główną pętlę aplikacji.
+ * Obsługuje logowanie, rejestrację i zapisywanie danych przy wyjściu.
+ * 
+ * Opcje wiersza poleceń:
+ * - --batch: polecenia wczytywane są ze standardowego wejścia (patrz BatchProcessor)
+ * - --hash-cost N: liczba iteracji PBKDF2 dla nowo tworzonych skrótów haseł
+ * - --import PLIK: import rozkładu jazdy z pliku CSV przed uruchomieniem (patrz TimetableImporter)
+ * - --archive: archiwizacja pociągów sprzed dzisiejszej daty przed uruchomieniem (patrz ArchiveManager)
+ * - --primary GNIAZDO: proces główny - dziennik przesyłany do replik przez gniazdo lokalne (patrz ReplicationServer)
+ * - --replica GNIAZDO: replika tylko do odczytu w trybie wsadowym, zasilana dziennikiem procesu głównego
+ * - --shards N: liczba wątków równoległego stosowania partii wsadowych i przeglądu katalogu (domyślnie 1 - bez wątków, 0 - liczba rdzeni)
+ * - --serve GNIAZDO: menu dostępne także dla klientów gniazda lokalnego, obok konsoli (patrz SessionServer)
+ * 
+ * @param argc Liczba argumentów
+ * @param argv Argumenty wiersza poleceń
+ * @return 0 przy poprawnym zakończeniu programu
+ */
+int main(int argc, char* argv[]) {
+    // Odczyt opcji wiersza poleceń
+    bool batchMode = false;
+    bool archiveDeparted = false;
+    size_t shardCount = 1;
+    std::string primarySocket, replicaSocket, serveSocket;
+    std::string timetablePath;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--batch") {
+            batchMode = true;
+        }
+        else if (arg == "--hash-cost" && i + 1 < argc) {
+            int cost = std::atoi(argv[++i]);
+            if (cost > 0) PasswordHasher::setIterations(cost);
+        }
+        else if (arg == "--import" && i + 1 < argc) {
+            timetablePath = argv[++i];
+        }
+        else if (arg == "--archive") {
+            archiveDeparted = true;
+        }
+        else if (arg == "--primary" && i + 1 < argc) {
+            primarySocket = argv[++i];
+        }
+        else if (arg == "--replica" && i + 1 < argc) {
+            replicaSocket = argv[++i];
+            batchMode = true;
+        }
+        else if (arg == "--shards" && i + 1 < argc) {
+            shardCount = static_cast<size_t>(std::max(0, std::atoi(argv[++i])));
+        }
+        else if (arg == "--serve" && i + 1 < argc) {
+            serveSocket = argv[++i];
+        }
+    }
+
+    // Tryb wsadowy - wyjście bez synchronizacji ze stdio (wejście czyta blokami LineReader)
+    if (batchMode) std::ios::sync_with_stdio(false);
+
+    // Inicjalizacja menedżera danych
+    DataManager dm;
+    UserDirectory users;
+    TrainCatalog trains;
+    TicketStore tickets;
+
+    // Wczytanie danych z plików
+    std::cout << "Inicjalizacja systemu...\n";
+    dm.loadUsers(users);
+    dm.loadTrains(trains);
+    dm.loadTickets(tickets);
+    // Operacje z dziennika nowsze niż migawki (np. po przerwaniu programu);
+    // replika tylko czyta pliki procesu głównego
+    bool replica = !replicaSocket.empty();
+    uint64_t appliedSequence = dm.recover(trains, tickets, replica);
+
+    // Import rozkładu jazdy podanego w wierszu poleceń
+    if (!timetablePath.empty() && !replica) {
+        TimetableImporter importer(trains, std::cout);
+        ImportReport report;
+        if (importer.importFile(timetablePath, report)) {
+            std::cout << "Zaimportowano " << report.Ftrains << " pociagow z " << report.Frows
+                << " wierszy rozkladu (odrzucone: " << report.FrejectedRows << ").\n";
+            dm.saveTrains(trains);
+            dm.announceSnapshots();
+        }
+    }
+
+    // Archiwizacja odjechanych pociągów (np. przy okresowym uruchamianiu z --archive)
+    ArchiveManager archive;
+    if (archiveDeparted && !replica) {
+        ArchiveSummary moved = archive.archiveBefore(trains, tickets, ArchiveManager::todayKey());
+        std::cout << "Zarchiwizowano " << moved.Ftrains << " pociagow i " << moved.Ftickets << " biletow.\n";
+        dm.saveTrains(trains);
+        dm.saveTickets(tickets);
+        dm.announceSnapshots();
+    }
+
+    // Odtworzenie generatora ID biletów (zapisany high-water mark lub najwyższe ID + 1)
+    IdAllocator ticketIds("sequence.yaml");
+    ticketIds.recover(tickets.maxTicketId() + 1);
+    // Cennik - tabela odległości skompilowana do płaskich tablic
+    PricingEngine pricing;
+    dm.loadFares(pricing);
+
+    BookingEngine engine(trains, tickets, ticketIds, pricing);
+    engine.setJournal(&dm.journal());
+    // Wątki robocze (--shards) - duże partie wsadowe i pełne przeglądy katalogu wykonywane równolegle
+    ShardPool shards(shardCount);
+    engine.setShards(&shards);
+    SessionManager sessions;
+
+    // Utworzenie domyślnego konta administratora przy pierwszym uruchomieniu
+    if (users.empty() && !replica) {
+        std::cout << "Pierwsze uruchomienie. Tworzenie konta admin/admin.\n";
+        users.add(std::make_unique<Admin>("admin", PasswordHasher::hash("admin"), 1));
+        dm.saveUsers(users);
+        dm.announceSnapshots();
+    }
+
+    // Replika - odczyty z własnych danych w pamięci, bez zapisu plików
+    if (replica) {
+        ReplicaClient replicaClient(replicaSocket, trains, tickets, users, appliedSequence);
+        replicaClient.start();
+        BatchProcessor batch(engine, users, sessions);
+        batch.setReplica(&replicaClient);
+        LineReader input(0);
+        batch.run(input, std::cout);
+        return 0;
+    }
+
+    // Proces główny z replikami - każdy zapis dziennika trafia też do replik
+    std::unique_ptr<ReplicationServer> replication;
+    if (!primarySocket.empty()) {
+        replication = std::make_unique<ReplicationServer>(primarySocket, dm.journal());
+        replication->start();
+    }
+
+    // Tryb wsadowy - polecenia ze standardowego wejścia, bez menu
+    if (batchMode) {
+        BatchProcessor batch(engine, users, sessions);
+        LineReader input(0);
+        batch.run(input, std::cout);
+
+        dm.saveUsers(users);
+        dm.saveTrains(trains);
+        dm.saveTickets(tickets);
+        ticketIds.checkpoint();
+        return 0;
+    }
+
+    // Sesja menu na konsoli i - z --serve - sesje klientów gniazda, wszystkie w tym wątku
+    auto openSession = [&](SessionIO& io) { return mainMenu(io, engine, trains, tickets, users, archive, dm); };
+    SessionServer server(serveSocket, openSession);
+    if (serveSocket.empty() || !server.start()) {
+        SessionIO console(std::cout);
+        Task<void> session = openSession(console);
+        session.start();
+
+        // Koniec wejścia kończy sesję (zawieszona korutyna jest niszczona);
+        // pytanie menu wypisywane jest przed oczekiwaniem na odpowiedź
+        LineReader input(0);
+        input.tie(&std::cout);
+        std::string_view line;
+        while (!session.done() && input.next(line)) {
+            console.push(std::string(line));
+        }
+    }
+    else {
+        server.run();
+    }
 
     // Zapisanie wszystkich danych przed zakończeniem
     std::cout << "Zapisywanie danych...\n";
     dm.saveUsers(users);
     dm.saveTrains(trains);
     dm.saveTickets(tickets);
+    ticketIds.checkpoint();
 
     return 0;
 }
\ No newline at end of file
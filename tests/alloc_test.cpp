@@ -0,0 +1,141 @@
+/**
+ * @file alloc_test.cpp
+ * @brief Test liczby alokacji - wyszukiwanie, wyszukanie loginu i lista biletów bez alokacji na rekord
+ *
+ * Globalny operator new zlicza alokacje. Każda ścieżka wykonywana jest raz na
+ * rozgrzewkę (bufory wielokrotnego użytku osiągają docelową pojemność), a potem
+ * ponownie - licznik nie może się wtedy zmienić, niezależnie od liczby
+ * porównanych pociągów, kont i biletów.
+ */
+
+#include "Passenger.h"
+#include "SearchCache.h"
+#include "TicketStore.h"
+#include "TrainCatalog.h"
+#include "UserDirectory.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+static std::atomic<size_t> allocations{ 0 };   ///< Liczba wywołań operatora new
+
+void* operator new(std::size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size == 0 ? 1 : size)) return memory;
+	throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+/**
+ * @class NullBuffer
+ * @brief Bufor strumienia odrzucający dane (wyjście listy bez alokacji)
+ */
+class NullBuffer : public std::streambuf
+{
+protected:
+	int overflow(int c) override { return c; }
+	std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+static int failures = 0;   ///< Liczba niespełnionych warunków
+
+/**
+ * @brief Sprawdza, czy ścieżka nie zaalokowała pamięci
+ * @param name Nazwa ścieżki
+ * @param before Stan licznika przed wykonaniem
+ * @param records Liczba porównanych rekordów
+ */
+static void expectNoAllocations(const char* name, size_t before, size_t records) {
+	size_t count = allocations.load() - before;
+	std::printf("%-28s %8zu rekordow, %zu alokacji\n", name, records, count);
+	if (count != 0) failures++;
+}
+
+int main() {
+	const char* stations[] = { "Warszawa Centralna", "Krakow Glowny", "Gdansk Glowny", "Poznan Glowny", "Wroclaw Glowny" };
+	const size_t TRAINS = 5000;
+	const size_t USERS = 2000;
+	const size_t TICKETS_PER_USER = 8;
+
+	TrainCatalog trains;
+	for (size_t i = 0; i < TRAINS; i++) {
+		std::string date = "2026-03-" + std::to_string(10 + i % 19);
+		trains.add(static_cast<int>(i + 1), stations[i % 5], stations[(i + 1 + i / 5) % 5], date, 120);
+	}
+
+	UserDirectory users;
+	std::vector<std::string> logins;
+	for (size_t i = 0; i < USERS; i++) {
+		logins.push_back("passenger" + std::to_string(i));
+		users.add(std::make_unique<Passenger>(logins.back(), "skrot", static_cast<int>(i + 1)));
+	}
+
+	TicketStore tickets;
+	int ticketId = 1;
+	for (size_t i = 0; i < USERS * TICKETS_PER_USER; i++) {
+		const User* owner = users.find(logins[i % USERS]);
+		tickets.add(ticketId++, static_cast<int>(i % TRAINS + 1), owner->get_FloginId(), static_cast<int>(i % 120 + 1), 49.90);
+	}
+
+	// Kontrola licznika (jawne wywołanie operatora nie może zostać pominięte przez kompilator)
+	size_t control = allocations.load();
+	::operator delete(::operator new(64));
+	if (allocations.load() == control) {
+		std::printf("BLAD: licznik alokacji nie dziala\n");
+		return 1;
+	}
+
+	// Wyszukiwanie: porównanie zapytania z każdym pociągiem katalogu
+	SearchQuery query = SearchQuery::make("warszawa", "krakow", "2026-03", 1);
+	auto scan = [&]() {
+		size_t matched = 0;
+		for (const Train* train : trains) {
+			if (query.matches(*train)) matched++;
+		}
+		return matched;
+	};
+	size_t matched = scan();
+	if (matched == 0) failures++;
+	size_t before = allocations.load();
+	if (scan() != matched) failures++;
+	expectNoAllocations("wyszukiwanie", before, trains.size());
+
+	// Logowanie: wyszukanie każdego konta po loginie (także nieistniejącego)
+	auto lookup = [&]() {
+		size_t found = 0;
+		for (const std::string& login : logins) {
+			if (users.find(login) != nullptr) found++;
+		}
+		if (users.find("nieznany-login") != nullptr) found++;
+		return found;
+	};
+	lookup();
+	before = allocations.load();
+	if (lookup() != USERS) failures++;
+	expectNoAllocations("wyszukanie loginu", before, USERS + 1);
+
+	// Lista biletów pasażera (bufor ekranu wielokrotnego użytku)
+	NullBuffer discard;
+	std::ostream out(&discard);
+	const Passenger* passenger = static_cast<const Passenger*>(users.find(logins[0]));
+	passenger->listMyTickets(out, tickets);
+	before = allocations.load();
+	for (int i = 0; i < 100; i++) passenger->listMyTickets(out, tickets);
+	expectNoAllocations("lista biletow", before, tickets.rows() * 100);
+
+	if (failures != 0) {
+		std::printf("BLAD: %d sciezek alokuje pamiec\n", failures);
+		return 1;
+	}
+	std::printf("OK\n");
+	return 0;
+}
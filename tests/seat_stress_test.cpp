@@ -0,0 +1,184 @@
+/**
+ * @file seat_stress_test.cpp
+ * @brief Współbieżny test mapy miejsc - rezerwacje, anulowania i zmiany miejsc z wielu wątków
+ *
+ * Pociąg 1 mieści się w jednym słowie mapy bitowej (przeniesienia w obrębie
+ * słowa), pociąg 2 zajmuje kilka słów (przeniesienia między słowami).
+ * Wątek kontrolny w trakcie pracy pobiera migawki BookingEngine::snapshot() -
+ * powstają pod blokadami pociągów i magazynu, więc w każdej liczba zajętych
+ * miejsc musi równać się liczbie biletów pociągu, a w fazie samych zmian
+ * miejsc nie może się zmieniać. Po każdej fazie sprawdzane jest, że żadne
+ * miejsce nie ma dwóch właścicieli, każde miejsce z biletem jest zajęte,
+ * a każde miejsce bez biletu wolne.
+ */
+
+#include "BookingEngine.h"
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct OwnedTicket
+ * @brief Bilet wątku roboczego
+ */
+struct OwnedTicket {
+	int FticketId;   ///< ID biletu
+	int FtrainId;    ///< ID pociągu
+};
+
+static std::atomic<int> failures{ 0 };   ///< Liczba niespełnionych warunków
+
+/**
+ * @brief Zgłasza niespełniony warunek (wypisywane są tylko pierwsze błędy)
+ * @param message Opis błędu
+ * @param trainId ID pociągu
+ * @param value Wartość pomocnicza (np. numer miejsca)
+ */
+static void fail(const char* message, int trainId, int value) {
+	if (failures.fetch_add(1) < 10) std::printf("BLAD: %s (pociag %d, %d)\n", message, trainId, value);
+}
+
+/**
+ * @brief Sprawdza zgodność biletów z mapą miejsc każdego pociągu (wywoływane bez wątków roboczych)
+ * @param trains Katalog pociągów
+ * @param tickets Magazyn biletów
+ */
+static void verifyOwnership(const TrainCatalog& trains, const TicketStore& tickets) {
+	for (const Train* train : trains) {
+		std::vector<int> owners(static_cast<size_t>(train->getCapacity()) + 1, 0);
+		int count = 0;
+		tickets.forEachOfTrain(train->getID(), [&](size_t row) {
+			int seat = tickets.seat(row);
+			count++;
+			if (seat < 1 || seat > train->getCapacity()) return fail("bilet poza pociagiem", train->getID(), seat);
+			if (owners[seat]++ != 0) fail("miejsce ma dwoch wlascicieli", train->getID(), seat);
+			if (train->isSeatFree(seat)) fail("miejsce z biletem jest wolne", train->getID(), seat);
+		});
+		for (int seat = 1; seat <= train->getCapacity(); seat++) {
+			if (owners[seat] == 0 && !train->isSeatFree(seat)) fail("miejsce bez biletu jest zajete", train->getID(), seat);
+		}
+		if (train->getOccupiedSeatsCount() != count) fail("liczba zajetych miejsc rozna od liczby biletow", train->getID(), count);
+	}
+}
+
+int main() {
+	const int THREADS = 8;
+	const int ITERATIONS = 20000;
+	const int SMALL_TRAIN = 1;   // 60 miejsc - jedno słowo mapy
+	const int LARGE_TRAIN = 2;   // 200 miejsc - cztery słowa mapy
+
+	std::filesystem::path sequence = std::filesystem::temp_directory_path() / "seat_stress_sequence.yaml";
+	TrainCatalog trains;
+	trains.add(SMALL_TRAIN, "Warszawa Centralna", "Krakow Glowny", "2026-03-10", 60);
+	trains.add(LARGE_TRAIN, "Gdansk Glowny", "Poznan Glowny", "2026-03-11", 200);
+	TicketStore tickets;
+	IdAllocator ticketIds(sequence.string());
+	PricingEngine pricing;
+	BookingEngine engine(trains, tickets, ticketIds, pricing);
+
+	std::vector<std::vector<OwnedTicket>> owned(THREADS);
+	auto capacityOf = [&trains](int trainId) { return trains.find(trainId)->getCapacity(); };
+
+	// Wątek kontrolny: migawki w trakcie pracy wątków roboczych
+	auto checker = [&](const std::vector<int>* expected, std::atomic<bool>& done, size_t& checked) {
+		while (!done.load()) {
+			std::shared_ptr<const CatalogSnapshot> snapshot = engine.snapshot();
+			snapshot->forEach([&](const TrainSummary& row) {
+				if (static_cast<size_t>(row.Foccupied) != row.Ftickets) fail("migawka: zajete miejsca rozne od liczby biletow", row.Fid, row.Foccupied);
+				if (expected != nullptr && row.Foccupied != (*expected)[row.Fid]) fail("migawka: zmiana liczby zajetych miejsc przy przeniesieniach", row.Fid, row.Foccupied);
+			});
+			checked++;
+		}
+	};
+
+	// Faza 1: rezerwacje, anulowania i zmiany miejsc
+	{
+		std::atomic<bool> done{ false };
+		size_t checked = 0;
+		std::thread control(checker, nullptr, std::ref(done), std::ref(checked));
+		std::vector<std::thread> workers;
+		for (int t = 0; t < THREADS; t++) {
+			workers.emplace_back([&, t]() {
+				std::mt19937 random(static_cast<uint32_t>(t + 1));
+				uint32_t passengerId = static_cast<uint32_t>(t + 1);
+				std::vector<OwnedTicket>& mine = owned[t];
+				for (int i = 0; i < ITERATIONS; i++) {
+					int operation = static_cast<int>(random() % 4);
+					if (operation < 2 || mine.empty()) {
+						int trainId = random() % 2 == 0 ? SMALL_TRAIN : LARGE_TRAIN;
+						int seat = static_cast<int>(random() % static_cast<uint32_t>(capacityOf(trainId) + 1));   // 0 - pierwsze wolne
+						BookingResult result = engine.book(passengerId, trainId, seat, BookingEngine::ANY_CLASS);
+						if (result.Fstatus == BookingStatus::OK) mine.push_back({ result.FticketId, trainId });
+						continue;
+					}
+					size_t index = random() % mine.size();
+					if (operation == 2) {
+						if (engine.cancel(passengerId, mine[index].FticketId).Fstatus != BookingStatus::OK) fail("anulowanie wlasnego biletu", mine[index].FtrainId, mine[index].FticketId);
+						mine[index] = mine.back();
+						mine.pop_back();
+					}
+					else {
+						int seat = static_cast<int>(random() % static_cast<uint32_t>(capacityOf(mine[index].FtrainId))) + 1;
+						BookingStatus status = engine.changeSeat(passengerId, mine[index].FticketId, seat).Fstatus;
+						if (status != BookingStatus::OK && status != BookingStatus::SEAT_TAKEN) fail("zmiana miejsca", mine[index].FtrainId, seat);
+					}
+				}
+			});
+		}
+		for (std::thread& worker : workers) worker.join();
+		done = true;
+		control.join();
+		std::printf("%-28s %8d operacji, %zu migawek\n", "rezerwacje i anulowania", THREADS * ITERATIONS, checked);
+		verifyOwnership(trains, tickets);
+	}
+
+	// Faza 2: same zmiany miejsc - liczba zajętych miejsc nie może się zmienić
+	{
+		for (int t = 0; t < THREADS; t++) {
+			for (int trainId : { SMALL_TRAIN, LARGE_TRAIN }) {
+				BookingResult result = engine.book(static_cast<uint32_t>(t + 1), trainId, 0, BookingEngine::ANY_CLASS);
+				if (result.Fstatus == BookingStatus::OK) owned[t].push_back({ result.FticketId, trainId });
+			}
+		}
+		std::vector<int> expected(3, 0);
+		for (int trainId : { SMALL_TRAIN, LARGE_TRAIN }) expected[trainId] = trains.find(trainId)->getOccupiedSeatsCount();
+
+		std::atomic<bool> done{ false };
+		size_t checked = 0;
+		std::thread control(checker, &expected, std::ref(done), std::ref(checked));
+		std::vector<std::thread> workers;
+		for (int t = 0; t < THREADS; t++) {
+			workers.emplace_back([&, t]() {
+				std::mt19937 random(static_cast<uint32_t>(THREADS + t + 1));
+				uint32_t passengerId = static_cast<uint32_t>(t + 1);
+				const std::vector<OwnedTicket>& mine = owned[t];
+				if (mine.empty()) return;
+				for (int i = 0; i < ITERATIONS; i++) {
+					const OwnedTicket& ticket = mine[random() % mine.size()];
+					int seat = static_cast<int>(random() % static_cast<uint32_t>(capacityOf(ticket.FtrainId))) + 1;
+					BookingStatus status = engine.changeSeat(passengerId, ticket.FticketId, seat).Fstatus;
+					if (status != BookingStatus::OK && status != BookingStatus::SEAT_TAKEN) fail("zmiana miejsca", ticket.FtrainId, seat);
+				}
+			});
+		}
+		for (std::thread& worker : workers) worker.join();
+		done = true;
+		control.join();
+		std::printf("%-28s %8d operacji, %zu migawek\n", "zmiany miejsc", THREADS * ITERATIONS, checked);
+		verifyOwnership(trains, tickets);
+		for (int trainId : { SMALL_TRAIN, LARGE_TRAIN }) {
+			if (trains.find(trainId)->getOccupiedSeatsCount() != expected[trainId]) fail("zmiana liczby zajetych miejsc przy przeniesieniach", trainId, expected[trainId]);
+		}
+	}
+
+	std::filesystem::remove(sequence);
+	if (failures != 0) {
+		std::printf("BLAD: %d niespelnionych warunkow\n", failures.load());
+		return 1;
+	}
+	std::printf("OK\n");
+	return 0;
+}